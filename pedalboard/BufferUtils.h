@@ -21,6 +21,8 @@
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 
+#include "Interleave.h"
+
 namespace Pedalboard {
 enum class ChannelLayout {
   Interleaved,
@@ -123,13 +125,10 @@ juce::AudioBuffer<T> copyPyArrayIntoJuceBuffer(
   // channel is still the same on every iteration of the loop.
   switch (inputChannelLayout) {
   case ChannelLayout::Interleaved:
-    for (unsigned int i = 0; i < numChannels; i++) {
-      T *channelBuffer = ioBuffer.getWritePointer(i);
-      // We're de-interleaving the data here, so we can't use copyFrom.
-      for (unsigned int j = 0; j < numSamples; j++) {
-        channelBuffer[j] = static_cast<T *>(inputInfo.ptr)[j * numChannels + i];
-      }
-    }
+    // We're de-interleaving the data here, so we can't use copyFrom.
+    deinterleaveSamples(static_cast<const T *>(inputInfo.ptr),
+                        ioBuffer.getArrayOfWritePointers(), numChannels,
+                        numSamples);
     break;
   case ChannelLayout::NotInterleaved:
     for (unsigned int i = 0; i < numChannels; i++) {
@@ -203,6 +202,51 @@ const juce::AudioBuffer<T> convertPyArrayIntoJuceBuffer(
   }
 }
 
+/**
+ * Copy the contents of a JUCE buffer (skipping the first offsetSamples samples
+ * of each channel) into a contiguous block of memory at outputBasePointer,
+ * using the provided channel layout. The destination must have space for at
+ * least numChannels * (numSamples - offsetSamples) values.
+ */
+template <typename T>
+void copyJuceBufferIntoPointer(const juce::AudioBuffer<T> &juceBuffer,
+                               ChannelLayout channelLayout, int offsetSamples,
+                               T *outputBasePointer) {
+  unsigned int numChannels = juceBuffer.getNumChannels();
+  unsigned int numSamples = juceBuffer.getNumSamples();
+  unsigned int outputSampleCount =
+      std::max((int)numSamples - (int)offsetSamples, 0);
+
+  if (outputSampleCount == 0)
+    return;
+
+  // Depending on the input channel layout, we need to copy data
+  // differently. This loop is duplicated here to move the if statement
+  // outside of the tight loop, as we don't need to re-check that the input
+  // channel is still the same on every iteration of the loop.
+  switch (channelLayout) {
+  case ChannelLayout::Interleaved: {
+    const T **channelBuffers = (const T **)alloca(numChannels * sizeof(T *));
+    for (unsigned int i = 0; i < numChannels; i++) {
+      channelBuffers[i] = juceBuffer.getReadPointer(i, offsetSamples);
+    }
+    // We're interleaving the data here, so we can't use copyFrom.
+    interleaveSamples(channelBuffers, outputBasePointer, numChannels,
+                      outputSampleCount);
+    break;
+  }
+  case ChannelLayout::NotInterleaved:
+    for (unsigned int i = 0; i < numChannels; i++) {
+      const T *channelBuffer = juceBuffer.getReadPointer(i, offsetSamples);
+      std::copy(channelBuffer, channelBuffer + outputSampleCount,
+                &outputBasePointer[outputSampleCount * i]);
+    }
+    break;
+  default:
+    throw std::runtime_error("Internal error: got unexpected channel layout.");
+  }
+}
+
 template <typename T>
 py::array_t<T> copyJuceBufferIntoPyArray(const juce::AudioBuffer<T> &juceBuffer,
                                          ChannelLayout channelLayout,
@@ -212,7 +256,8 @@ py::array_t<T> copyJuceBufferIntoPyArray(const juce::AudioBuffer<T> &juceBuffer,
   unsigned int outputSampleCount =
       std::max((int)numSamples - (int)offsetSamples, 0);
 
-  // TODO: Avoid the need to copy here if offsetSamples is 0!
+  // Note: to avoid allocating a new array (and, in some cases, avoid copying
+  // entirely), use copyJuceBufferIntoExistingPyArray instead.
   py::array_t<T> outputArray;
   if (ndim == 2) {
     switch (channelLayout) {
@@ -231,29 +276,66 @@ py::array_t<T> copyJuceBufferIntoPyArray(const juce::AudioBuffer<T> &juceBuffer,
   }
 
   py::buffer_info outputInfo = outputArray.request();
+  copyJuceBufferIntoPointer(juceBuffer, channelLayout, offsetSamples,
+                            static_cast<T *>(outputInfo.ptr));
+
+  return outputArray;
+}
+/**
+ * Copy the contents of a JUCE buffer (skipping the first offsetSamples samples
+ * of each channel) into an existing C-contiguous NumPy array with the given
+ * channel layout, returning a view of the portion of the array that was
+ * written to. (This is the whole array if the buffer contains as many samples
+ * as the array does.)
+ *
+ * If the JUCE buffer already refers to the memory of the provided array (i.e.:
+ * it was created with convertPyArrayIntoJuceBuffer), no copy is made; if
+ * necessary, each channel's samples are shifted in place instead.
+ */
+template <typename T>
+py::array_t<T> copyJuceBufferIntoExistingPyArray(
+    const juce::AudioBuffer<T> &juceBuffer, ChannelLayout channelLayout,
+    int offsetSamples, py::array_t<T, py::array::c_style> outputArray) {
+  py::buffer_info outputInfo = outputArray.request(true);
+
+  unsigned int numChannels = juceBuffer.getNumChannels();
+  unsigned int outputSampleCount =
+      std::max((int)juceBuffer.getNumSamples() - (int)offsetSamples, 0);
+
+  unsigned int arraySampleCount =
+      (outputInfo.ndim == 2 && channelLayout == ChannelLayout::NotInterleaved)
+          ? outputInfo.shape[1]
+          : outputInfo.shape[0];
+
+  if (outputSampleCount > arraySampleCount) {
+    throw std::runtime_error(
+        "Internal error: tried to write " + std::to_string(outputSampleCount) +
+        " samples into an output array with space for only " +
+        std::to_string(arraySampleCount) + " samples.");
+  }
 
-  // Depending on the input channel layout, we need to copy data
-  // differently. This loop is duplicated here to move the if statement
-  // outside of the tight loop, as we don't need to re-check that the input
-  // channel is still the same on every iteration of the loop.
   T *outputBasePointer = static_cast<T *>(outputInfo.ptr);
 
-  if (juceBuffer.getNumSamples() > 0) {
+  if (outputSampleCount > 0) {
     switch (channelLayout) {
-    case ChannelLayout::Interleaved:
+    case ChannelLayout::Interleaved: {
+      const T **channelBuffers = (const T **)alloca(numChannels * sizeof(T *));
       for (unsigned int i = 0; i < numChannels; i++) {
-        const T *channelBuffer = juceBuffer.getReadPointer(i, offsetSamples);
-        // We're interleaving the data here, so we can't use copyFrom.
-        for (unsigned int j = 0; j < outputSampleCount; j++) {
-          outputBasePointer[j * numChannels + i] = channelBuffer[j];
-        }
+        channelBuffers[i] = juceBuffer.getReadPointer(i, offsetSamples);
       }
+      interleaveSamples(channelBuffers, outputBasePointer, numChannels,
+                        outputSampleCount);
       break;
+    }
     case ChannelLayout::NotInterleaved:
       for (unsigned int i = 0; i < numChannels; i++) {
         const T *channelBuffer = juceBuffer.getReadPointer(i, offsetSamples);
-        std::copy(channelBuffer, channelBuffer + outputSampleCount,
-                  &outputBasePointer[outputSampleCount * i]);
+        T *outputChannel = outputBasePointer + (arraySampleCount * i);
+        // If we processed in-place, the source and destination may overlap:
+        if (channelBuffer != outputChannel) {
+          std::memmove(outputChannel, channelBuffer,
+                       sizeof(T) * outputSampleCount);
+        }
       }
       break;
     default:
@@ -262,6 +344,16 @@ py::array_t<T> copyJuceBufferIntoPyArray(const juce::AudioBuffer<T> &juceBuffer,
     }
   }
 
-  return outputArray;
+  if (outputSampleCount == arraySampleCount) {
+    return outputArray;
+  }
+
+  py::slice samples(0, outputSampleCount, 1);
+  if (outputInfo.ndim == 2 && channelLayout == ChannelLayout::NotInterleaved) {
+    py::slice channels(0, numChannels, 1);
+    return outputArray[py::make_tuple(channels, samples)]
+        .template cast<py::array_t<T>>();
+  }
+  return outputArray[samples].template cast<py::array_t<T>>();
 }
 } // namespace Pedalboard
\ No newline at end of file
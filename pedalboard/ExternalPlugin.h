@@ -27,6 +27,7 @@
 
 #include "AudioUnitParser.h"
 #include "Plugin.h"
+#include "ScratchArena.h"
 #include <pybind11/stl.h>
 
 #include "juce_overrides/juce_PatchedVST3PluginFormat.h"
@@ -627,6 +628,26 @@ public:
     }
   }
 
+  /**
+   * Create a new instance of the same plugin as another ExternalPlugin, with
+   * the same state and parameter values. The plugin file is not scanned
+   * again, and the reload type detected when the other plugin was first
+   * loaded is reused rather than being detected again. Must be called from
+   * the main thread.
+   */
+  ExternalPlugin(ExternalPlugin &other)
+      : foundPluginDescription(other.foundPluginDescription),
+        pathToPluginFile(other.pathToPluginFile),
+        initializationTimeout(other.initializationTimeout) {
+    juce::MessageManager::getInstance();
+
+    pluginFormatManager.addDefaultFormats();
+    pluginFormatManager.addFormat(new juce::PatchedVST3PluginFormat());
+
+    reloadType = other.reloadType;
+    reinstantiatePlugin(other.pluginInstance.get());
+  }
+
   ~ExternalPlugin() {
     {
       std::lock_guard<std::mutex> lock(EXTERNAL_PLUGIN_MUTEX);
@@ -706,7 +727,13 @@ public:
     }
   }
 
-  void reinstantiatePlugin() {
+  /**
+   * Create a new instance of this plugin, replacing the existing instance (if
+   * any) and restoring its state. If copyStateFrom is provided, the state of
+   * that plugin instance will be used instead.
+   */
+  void
+  reinstantiatePlugin(juce::AudioPluginInstance *copyStateFrom = nullptr) {
     // JUCE only allows creating new plugin instances from the main
     // thread, which we may not be on:
     if (!juce::MessageManager::getInstance()->isThisTheMessageThread()) {
@@ -721,14 +748,20 @@ public:
     juce::MemoryBlock savedState;
     std::map<int, float> currentParameters;
 
-    if (pluginInstance) {
-      pluginInstance->getStateInformation(savedState);
+    if (!copyStateFrom) {
+      copyStateFrom = pluginInstance.get();
+    }
 
-      for (auto *parameter : pluginInstance->getParameters()) {
+    if (copyStateFrom) {
+      copyStateFrom->getStateInformation(savedState);
+
+      for (auto *parameter : copyStateFrom->getParameters()) {
         currentParameters[parameter->getParameterIndex()] =
             parameter->getValue();
       }
+    }
 
+    if (pluginInstance) {
       {
         std::lock_guard<std::mutex> lock(EXTERNAL_PLUGIN_MUTEX);
         // Delete the plugin instance itself:
@@ -1117,6 +1150,21 @@ public:
     }
   }
 
+  /**
+   * JUCE only allows creating new plugin instances from the main thread, so
+   * external plugins can't be cloned from any other thread. Plugins that must
+   * be reinstantiated to be reset (see ExternalPluginReloadType) can't be
+   * cloned either, as their clones could only be reset on the main thread.
+   */
+  virtual std::shared_ptr<Plugin> clone() override {
+    if (!pluginInstance ||
+        reloadType != ExternalPluginReloadType::ClearsAudioOnReset ||
+        !juce::MessageManager::getInstance()->isThisTheMessageThread()) {
+      return nullptr;
+    }
+    return std::shared_ptr<ExternalPlugin>(new ExternalPlugin(*this));
+  }
+
   /**
    * prepare() is called on every render call, regardless of if the plugin has
    * been reset.
@@ -1140,6 +1188,13 @@ public:
       pluginInstance->setNonRealtime(true);
       pluginInstance->prepareToPlay(spec.sampleRate, spec.maximumBlockSize);
 
+      // Reserve enough scratch space for process() to avoid allocating:
+      size_t numOutputChannels = pluginInstance->getTotalNumOutputChannels();
+      scratch.reserve(
+          ScratchArena::getAllocationSize<float *>(numOutputChannels) +
+          numOutputChannels *
+              ScratchArena::getAllocationSize<float>(spec.maximumBlockSize));
+
       lastSpec = spec;
     }
   }
@@ -1186,28 +1241,27 @@ public:
             "number of channels passed in.)");
       }
 
-      std::vector<float *> channelPointers(
-          pluginInstance->getTotalNumOutputChannels());
+      // Use memory reserved in prepare() to avoid allocating here:
+      scratch.rewind();
+      size_t numOutputChannels = pluginInstance->getTotalNumOutputChannels();
+      float **channelPointers = scratch.allocate<float *>(numOutputChannels);
 
       for (size_t i = 0; i < outputBlock.getNumChannels(); i++) {
         channelPointers[i] = outputBlock.getChannelPointer(i);
       }
 
       // Depending on the bus layout, we may have to pass extra buffers to the
-      // plugin that we don't use. Use vector here to ensure the memory is
-      // freed via RAII.
-      std::vector<std::vector<float>> dummyChannels;
-      for (size_t i = outputBlock.getNumChannels(); i < channelPointers.size();
+      // plugin that we don't use:
+      for (size_t i = outputBlock.getNumChannels(); i < numOutputChannels;
            i++) {
-        std::vector<float> dummyChannel(outputBlock.getNumSamples());
-        channelPointers[i] = dummyChannel.data();
-        dummyChannels.push_back(std::move(dummyChannel));
+        channelPointers[i] =
+            scratch.allocate<float>(outputBlock.getNumSamples());
+        std::fill_n(channelPointers[i], outputBlock.getNumSamples(), 0.0f);
       }
 
       // Create an audio buffer that doesn't actually allocate anything, but
       // just points to the data in the ProcessContext.
-      juce::AudioBuffer<float> audioBuffer(channelPointers.data(),
-                                           channelPointers.size(),
+      juce::AudioBuffer<float> audioBuffer(channelPointers, numOutputChannels,
                                            outputBlock.getNumSamples());
 
       pluginInstance->processBlock(audioBuffer, emptyMidiBuffer);
@@ -1416,6 +1470,7 @@ private:
   juce::String pathToPluginFile;
   juce::AudioPluginFormatManager pluginFormatManager;
   std::unique_ptr<juce::AudioPluginInstance> pluginInstance;
+  ScratchArena scratch;
 
   long samplesProvided = 0;
   float initializationTimeout = DEFAULT_INITIALIZATION_TIMEOUT_SECONDS;
@@ -0,0 +1,76 @@
+/*
+ * pedalboard
+ * Copyright 2025 Spotify AB
+ *
+ * Licensed under the GNU Public License, Version 3.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    https://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * In test builds (built with COUNT_ALLOCATIONS=1), every call that Pedalboard
+ * (or JUCE, which is compiled into the same module) makes to a heap
+ * allocation function is redirected by the linker (with -Wl,--wrap=...) to
+ * one of the wrappers below, which report the allocation to
+ * AllocationCounter before calling the original function.
+ *
+ * Only calls made from this module are wrapped; the rest of the Python
+ * process is unaffected. The C++ standard library's operator new calls the
+ * system's malloc directly, so each allocation is only counted once.
+ */
+#ifdef PEDALBOARD_COUNT_HEAP_ALLOCATIONS
+
+#include <cstddef>
+#include <new>
+
+#include "ScratchArena.h"
+
+#define COUNTED_ALLOCATION_FUNCTION(name, parameters, arguments)               \
+  void *__real_##name parameters;                                              \
+  void *__wrap_##name parameters {                                             \
+    Pedalboard::AllocationCounter::recordAllocation();                         \
+    return __real_##name arguments;                                            \
+  }
+
+extern "C" {
+COUNTED_ALLOCATION_FUNCTION(malloc, (size_t size), (size))
+COUNTED_ALLOCATION_FUNCTION(calloc, (size_t count, size_t size), (count, size))
+COUNTED_ALLOCATION_FUNCTION(realloc, (void *pointer, size_t size),
+                            (pointer, size))
+COUNTED_ALLOCATION_FUNCTION(aligned_alloc, (size_t alignment, size_t size),
+                            (alignment, size))
+
+int __real_posix_memalign(void **pointer, size_t alignment, size_t size);
+int __wrap_posix_memalign(void **pointer, size_t alignment, size_t size) {
+  Pedalboard::AllocationCounter::recordAllocation();
+  return __real_posix_memalign(pointer, alignment, size);
+}
+
+// The (mangled) variants of operator new and operator new[]:
+COUNTED_ALLOCATION_FUNCTION(_Znwm, (size_t size), (size))
+COUNTED_ALLOCATION_FUNCTION(_Znam, (size_t size), (size))
+COUNTED_ALLOCATION_FUNCTION(_ZnwmRKSt9nothrow_t,
+                            (size_t size, const std::nothrow_t &tag),
+                            (size, tag))
+COUNTED_ALLOCATION_FUNCTION(_ZnamRKSt9nothrow_t,
+                            (size_t size, const std::nothrow_t &tag),
+                            (size, tag))
+COUNTED_ALLOCATION_FUNCTION(_ZnwmSt11align_val_t,
+                            (size_t size, std::align_val_t alignment),
+                            (size, alignment))
+COUNTED_ALLOCATION_FUNCTION(_ZnamSt11align_val_t,
+                            (size_t size, std::align_val_t alignment),
+                            (size, alignment))
+}
+
+#undef COUNTED_ALLOCATION_FUNCTION
+
+#endif
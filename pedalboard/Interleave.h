@@ -0,0 +1,322 @@
+/*
+ * pedalboard
+ * Copyright 2025 Spotify AB
+ *
+ * Licensed under the GNU Public License, Version 3.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    https://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <type_traits>
+
+// Which SIMD instruction sets we can use is decided at compile time, based on
+// the flags we're built with (i.e.: -march=native or -mavx on x86, or NEON on
+// ARM). Any samples not handled by a SIMD kernel fall through to scalar code.
+#if defined(__AVX__)
+#define PEDALBOARD_INTERLEAVE_USE_AVX 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PEDALBOARD_INTERLEAVE_USE_SSE 1
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define PEDALBOARD_INTERLEAVE_USE_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace Pedalboard {
+
+/**
+ * SIMD kernels for converting between interleaved audio (i.e.: NumPy arrays
+ * of shape (num_samples, num_channels), as returned by Librosa and others)
+ * and planar audio (one contiguous buffer per channel, as used by JUCE).
+ *
+ * Each kernel returns the number of samples (per channel) it processed, which
+ * may be less than numSamples; the caller is responsible for the remainder.
+ */
+namespace InterleaveKernels {
+
+inline unsigned int deinterleaveStereo(const float *source, float *left,
+                                       float *right, unsigned int numSamples) {
+  unsigned int i = 0;
+#if PEDALBOARD_INTERLEAVE_USE_AVX
+  for (; i + 8 <= numSamples; i += 8) {
+    // a = [L0 R0 L1 R1 | L2 R2 L3 R3], b = [L4 R4 L5 R5 | L6 R6 L7 R7]
+    __m256 a = _mm256_loadu_ps(source + (i * 2));
+    __m256 b = _mm256_loadu_ps(source + (i * 2) + 8);
+    // lo = [L0 R0 L1 R1 | L4 R4 L5 R5], hi = [L2 R2 L3 R3 | L6 R6 L7 R7]
+    __m256 lo = _mm256_permute2f128_ps(a, b, 0x20);
+    __m256 hi = _mm256_permute2f128_ps(a, b, 0x31);
+    _mm256_storeu_ps(left + i, _mm256_shuffle_ps(lo, hi, 0x88));
+    _mm256_storeu_ps(right + i, _mm256_shuffle_ps(lo, hi, 0xDD));
+  }
+#endif
+#if PEDALBOARD_INTERLEAVE_USE_SSE
+  for (; i + 4 <= numSamples; i += 4) {
+    __m128 a = _mm_loadu_ps(source + (i * 2));
+    __m128 b = _mm_loadu_ps(source + (i * 2) + 4);
+    _mm_storeu_ps(left + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(right + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+  }
+#elif PEDALBOARD_INTERLEAVE_USE_NEON
+  for (; i + 4 <= numSamples; i += 4) {
+    float32x4x2_t frames = vld2q_f32(source + (i * 2));
+    vst1q_f32(left + i, frames.val[0]);
+    vst1q_f32(right + i, frames.val[1]);
+  }
+#endif
+  return i;
+}
+
+inline unsigned int interleaveStereo(const float *left, const float *right,
+                                     float *destination,
+                                     unsigned int numSamples) {
+  unsigned int i = 0;
+#if PEDALBOARD_INTERLEAVE_USE_AVX
+  for (; i + 8 <= numSamples; i += 8) {
+    __m256 l = _mm256_loadu_ps(left + i);
+    __m256 r = _mm256_loadu_ps(right + i);
+    // lo = [L0 R0 L1 R1 | L4 R4 L5 R5], hi = [L2 R2 L3 R3 | L6 R6 L7 R7]
+    __m256 lo = _mm256_unpacklo_ps(l, r);
+    __m256 hi = _mm256_unpackhi_ps(l, r);
+    _mm256_storeu_ps(destination + (i * 2),
+                     _mm256_permute2f128_ps(lo, hi, 0x20));
+    _mm256_storeu_ps(destination + (i * 2) + 8,
+                     _mm256_permute2f128_ps(lo, hi, 0x31));
+  }
+#endif
+#if PEDALBOARD_INTERLEAVE_USE_SSE
+  for (; i + 4 <= numSamples; i += 4) {
+    __m128 l = _mm_loadu_ps(left + i);
+    __m128 r = _mm_loadu_ps(right + i);
+    _mm_storeu_ps(destination + (i * 2), _mm_unpacklo_ps(l, r));
+    _mm_storeu_ps(destination + (i * 2) + 4, _mm_unpackhi_ps(l, r));
+  }
+#elif PEDALBOARD_INTERLEAVE_USE_NEON
+  for (; i + 4 <= numSamples; i += 4) {
+    float32x4x2_t frames;
+    frames.val[0] = vld1q_f32(left + i);
+    frames.val[1] = vld1q_f32(right + i);
+    vst2q_f32(destination + (i * 2), frames);
+  }
+#endif
+  return i;
+}
+
+inline unsigned int deinterleaveQuad(const float *source,
+                                     float *const *destinations,
+                                     unsigned int numSamples) {
+  unsigned int i = 0;
+#if PEDALBOARD_INTERLEAVE_USE_SSE
+  for (; i + 4 <= numSamples; i += 4) {
+    __m128 a = _mm_loadu_ps(source + (i * 4));
+    __m128 b = _mm_loadu_ps(source + (i * 4) + 4);
+    __m128 c = _mm_loadu_ps(source + (i * 4) + 8);
+    __m128 d = _mm_loadu_ps(source + (i * 4) + 12);
+    _MM_TRANSPOSE4_PS(a, b, c, d);
+    _mm_storeu_ps(destinations[0] + i, a);
+    _mm_storeu_ps(destinations[1] + i, b);
+    _mm_storeu_ps(destinations[2] + i, c);
+    _mm_storeu_ps(destinations[3] + i, d);
+  }
+#elif PEDALBOARD_INTERLEAVE_USE_NEON
+  for (; i + 4 <= numSamples; i += 4) {
+    float32x4x4_t frames = vld4q_f32(source + (i * 4));
+    vst1q_f32(destinations[0] + i, frames.val[0]);
+    vst1q_f32(destinations[1] + i, frames.val[1]);
+    vst1q_f32(destinations[2] + i, frames.val[2]);
+    vst1q_f32(destinations[3] + i, frames.val[3]);
+  }
+#endif
+  return i;
+}
+
+inline unsigned int interleaveQuad(const float *const *sources,
+                                   float *destination,
+                                   unsigned int numSamples) {
+  unsigned int i = 0;
+#if PEDALBOARD_INTERLEAVE_USE_SSE
+  for (; i + 4 <= numSamples; i += 4) {
+    __m128 a = _mm_loadu_ps(sources[0] + i);
+    __m128 b = _mm_loadu_ps(sources[1] + i);
+    __m128 c = _mm_loadu_ps(sources[2] + i);
+    __m128 d = _mm_loadu_ps(sources[3] + i);
+    _MM_TRANSPOSE4_PS(a, b, c, d);
+    _mm_storeu_ps(destination + (i * 4), a);
+    _mm_storeu_ps(destination + (i * 4) + 4, b);
+    _mm_storeu_ps(destination + (i * 4) + 8, c);
+    _mm_storeu_ps(destination + (i * 4) + 12, d);
+  }
+#elif PEDALBOARD_INTERLEAVE_USE_NEON
+  for (; i + 4 <= numSamples; i += 4) {
+    float32x4x4_t frames;
+    frames.val[0] = vld1q_f32(sources[0] + i);
+    frames.val[1] = vld1q_f32(sources[1] + i);
+    frames.val[2] = vld1q_f32(sources[2] + i);
+    frames.val[3] = vld1q_f32(sources[3] + i);
+    vst4q_f32(destination + (i * 4), frames);
+  }
+#endif
+  return i;
+}
+
+/**
+ * Scalar fallbacks. With the channel count known at compile time, the
+ * compiler fully unrolls the inner loop (and can often vectorize the outer
+ * one), which is much faster than a runtime stride. Iterating frame-by-frame
+ * (rather than channel-by-channel) reads the interleaved buffer only once,
+ * in order, which is much more cache-friendly for large buffers.
+ */
+template <typename T, unsigned int NumChannels>
+void deinterleaveFixed(const T *source, T *const *destinations,
+                       unsigned int startSample, unsigned int numSamples) {
+  for (unsigned int i = startSample; i < numSamples; i++) {
+    for (unsigned int c = 0; c < NumChannels; c++) {
+      destinations[c][i] = source[(i * NumChannels) + c];
+    }
+  }
+}
+
+template <typename T, unsigned int NumChannels>
+void interleaveFixed(const T *const *sources, T *destination,
+                     unsigned int startSample, unsigned int numSamples) {
+  for (unsigned int i = startSample; i < numSamples; i++) {
+    for (unsigned int c = 0; c < NumChannels; c++) {
+      destination[(i * NumChannels) + c] = sources[c][i];
+    }
+  }
+}
+
+template <typename T>
+void deinterleaveAny(const T *source, T *const *destinations,
+                     unsigned int numChannels, unsigned int startSample,
+                     unsigned int numSamples) {
+  for (unsigned int i = startSample; i < numSamples; i++) {
+    const T *frame = source + ((size_t)i * numChannels);
+    for (unsigned int c = 0; c < numChannels; c++) {
+      destinations[c][i] = frame[c];
+    }
+  }
+}
+
+template <typename T>
+void interleaveAny(const T *const *sources, T *destination,
+                   unsigned int numChannels, unsigned int startSample,
+                   unsigned int numSamples) {
+  for (unsigned int i = startSample; i < numSamples; i++) {
+    T *frame = destination + ((size_t)i * numChannels);
+    for (unsigned int c = 0; c < numChannels; c++) {
+      frame[c] = sources[c][i];
+    }
+  }
+}
+
+} // namespace InterleaveKernels
+
+/**
+ * Split an interleaved buffer of numSamples * numChannels values into
+ * numChannels separate buffers of numSamples values each.
+ */
+template <typename T>
+void deinterleaveSamples(const T *source, T *const *destinations,
+                         unsigned int numChannels, unsigned int numSamples) {
+  using namespace InterleaveKernels;
+
+  unsigned int startSample = 0;
+  if constexpr (std::is_same_v<T, float>) {
+    if (numChannels == 2) {
+      startSample = deinterleaveStereo(source, destinations[0],
+                                       destinations[1], numSamples);
+    } else if (numChannels == 4) {
+      startSample = deinterleaveQuad(source, destinations, numSamples);
+    }
+  }
+
+  switch (numChannels) {
+  case 0:
+    return;
+  case 1:
+    std::copy(source, source + numSamples, destinations[0]);
+    return;
+  case 2:
+    return deinterleaveFixed<T, 2>(source, destinations, startSample,
+                                   numSamples);
+  case 3:
+    return deinterleaveFixed<T, 3>(source, destinations, startSample,
+                                   numSamples);
+  case 4:
+    return deinterleaveFixed<T, 4>(source, destinations, startSample,
+                                   numSamples);
+  case 6:
+    return deinterleaveFixed<T, 6>(source, destinations, startSample,
+                                   numSamples);
+  case 8:
+    return deinterleaveFixed<T, 8>(source, destinations, startSample,
+                                   numSamples);
+  default:
+    return deinterleaveAny(source, destinations, numChannels, startSample,
+                           numSamples);
+  }
+}
+
+/**
+ * Combine numChannels separate buffers of numSamples values each into a
+ * single interleaved buffer of numSamples * numChannels values.
+ */
+template <typename T>
+void interleaveSamples(const T *const *sources, T *destination,
+                       unsigned int numChannels, unsigned int numSamples) {
+  using namespace InterleaveKernels;
+
+  unsigned int startSample = 0;
+  if constexpr (std::is_same_v<T, float>) {
+    if (numChannels == 2) {
+      startSample =
+          interleaveStereo(sources[0], sources[1], destination, numSamples);
+    } else if (numChannels == 4) {
+      startSample = interleaveQuad(sources, destination, numSamples);
+    }
+  }
+
+  switch (numChannels) {
+  case 0:
+    return;
+  case 1:
+    std::copy(sources[0], sources[0] + numSamples, destination);
+    return;
+  case 2:
+    return interleaveFixed<T, 2>(sources, destination, startSample,
+                                 numSamples);
+  case 3:
+    return interleaveFixed<T, 3>(sources, destination, startSample,
+                                 numSamples);
+  case 4:
+    return interleaveFixed<T, 4>(sources, destination, startSample,
+                                 numSamples);
+  case 6:
+    return interleaveFixed<T, 6>(sources, destination, startSample,
+                                 numSamples);
+  case 8:
+    return interleaveFixed<T, 8>(sources, destination, startSample,
+                                 numSamples);
+  default:
+    return interleaveAny(sources, destination, numChannels, startSample,
+                         numSamples);
+  }
+}
+
+} // namespace Pedalboard
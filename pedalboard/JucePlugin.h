@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include "JuceHeader.h"
 
 #include "Plugin.h"
@@ -40,6 +42,22 @@ public:                                                                        \
   }
 
 namespace Pedalboard {
+/**
+ * The type of sample processed by a juce::dsp block (i.e.: double for
+ * juce::dsp::Gain<double>), found by taking the first floating-point template
+ * argument of the block's type, looking inside nested types like
+ * juce::dsp::ProcessorDuplicator if necessary. Blocks that aren't templates
+ * (like juce::dsp::Reverb) are assumed to process float samples.
+ */
+template <typename DSPType> struct SampleTypeOf { using type = float; };
+
+template <template <typename...> class DSPTemplate, typename First,
+          typename... Rest>
+struct SampleTypeOf<DSPTemplate<First, Rest...>> {
+  using type = std::conditional_t<std::is_floating_point_v<First>, First,
+                                  typename SampleTypeOf<First>::type>;
+};
+
 /**
  * A template class to adapt an arbitrary juce::dsp block to a Plugin.
  * Could technically be used with any type that provides prepare,
@@ -60,15 +78,34 @@ public:
 
   int process(
       const juce::dsp::ProcessContextReplacing<float> &context) override {
-    dspBlock.process(context);
-    return context.getOutputBlock().getNumSamples();
+    return processWithDSP(context);
+  }
+
+  int process(
+      const juce::dsp::ProcessContextReplacing<double> &context) override {
+    return processWithDSP(context);
   }
 
   void reset() override { dspBlock.reset(); }
 
   DSPType &getDSP() { return dspBlock; };
+  const DSPType &getDSP() const { return dspBlock; };
 
 private:
+  template <typename SampleType>
+  int processWithDSP(
+      const juce::dsp::ProcessContextReplacing<SampleType> &context) {
+    // Most juce::dsp blocks can only process one type of sample:
+    if constexpr (std::is_same_v<SampleType,
+                                 typename SampleTypeOf<DSPType>::type>) {
+      dspBlock.process(context);
+      return context.getOutputBlock().getNumSamples();
+    } else {
+      throw std::runtime_error(
+          "Internal error: plugin was passed audio of the wrong sample type.");
+    }
+  }
+
   DSPType dspBlock;
 };
 } // namespace Pedalboard
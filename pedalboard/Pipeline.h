@@ -0,0 +1,393 @@
+/*
+ * pedalboard
+ * Copyright 2025 Spotify AB
+ *
+ * Licensed under the GNU Public License, Version 3.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    https://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "JuceHeader.h"
+#include "Plugin.h"
+#include "Profiler.h"
+#include "ThreadPool.h"
+
+namespace Pedalboard {
+
+/**
+ * A bounded, lock-free queue that is safe to use with exactly one thread
+ * pushing and exactly one (other) thread popping.
+ */
+template <typename T> class SPSCQueue {
+public:
+  SPSCQueue(size_t capacity) : slots(capacity + 1) {}
+
+  /**
+   * Add an item to the queue, returning false if the queue was full.
+   * Must only be called from the producing thread.
+   */
+  bool tryPush(T item) {
+    size_t currentTail = tail.load(std::memory_order_relaxed);
+    size_t nextTail = (currentTail + 1) % slots.size();
+    if (nextTail == head.load(std::memory_order_acquire)) {
+      return false;
+    }
+    slots[currentTail] = std::move(item);
+    tail.store(nextTail, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Remove an item from the queue, returning false if the queue was empty.
+   * Must only be called from the consuming thread.
+   */
+  bool tryPop(T &item) {
+    size_t currentHead = head.load(std::memory_order_relaxed);
+    if (currentHead == tail.load(std::memory_order_acquire)) {
+      return false;
+    }
+    item = std::move(slots[currentHead]);
+    head.store((currentHead + 1) % slots.size(), std::memory_order_release);
+    return true;
+  }
+
+private:
+  std::vector<T> slots;
+
+  // Kept on separate cache lines, as each is written by a different thread:
+  alignas(64) std::atomic<size_t> head{0};
+  alignas(64) std::atomic<size_t> tail{0};
+};
+
+/**
+ * Runs a list of plugins in series over an entire buffer of audio, with each
+ * plugin running on its own thread. Blocks of audio flow from one plugin to
+ * the next through SPSCQueues, so while the second plugin processes block N,
+ * the first plugin can already process block N + 1.
+ *
+ * The output is identical to that of process(): each plugin sees the same
+ * sequence of blocks (including the silence appended to flush out latency
+ * if isProbablyLastProcessCall is true) as it would if the plugins were run
+ * one after another, and the output is right-aligned in ioBuffer in the same
+ * way.
+ */
+class Pipeline {
+public:
+  Pipeline(juce::AudioBuffer<float> &ioBuffer, juce::dsp::ProcessSpec spec,
+           const std::vector<std::shared_ptr<Plugin>> &stages,
+           bool isProbablyLastProcessCall)
+      : ioBuffer(ioBuffer), stages(stages),
+        numChannels(ioBuffer.getNumChannels()),
+        blockSize(spec.maximumBlockSize),
+        numInputSamples(ioBuffer.getNumSamples()),
+        isProbablyLastProcessCall(isProbablyLastProcessCall) {
+    for (size_t i = 0; i + 1 < stages.size(); i++) {
+      edges.push_back(std::make_unique<Edge>(numChannels, blockSize));
+    }
+  }
+
+  /**
+   * Run all of the stages to completion, returning the number of samples
+   * output at the end of ioBuffer (as process() does).
+   */
+  int run() {
+    if (isProbablyLastProcessCall) {
+      int expectedOutputLatency = 0;
+      for (auto &stage : stages) {
+        expectedOutputLatency += stage->getLatencyHint();
+      }
+
+      if (expectedOutputLatency > 0) {
+        ioBuffer.setSize(numChannels,
+                         numInputSamples + expectedOutputLatency,
+                         /* keepExistingContent= */ true,
+                         /* clearExtraSpace= */ true);
+      }
+    }
+
+    for (int c = 0; c < numChannels; c++) {
+      inputChannels.push_back(ioBuffer.getReadPointer(c));
+    }
+
+    Profiler::Context profilerContext = Profiler::getCurrentContext();
+    ThreadPool pool(stages.size());
+    pool.parallelFor(stages.size(), [&](size_t stageIndex, size_t) {
+      Profiler::ScopedContext scopedProfilerContext(profilerContext);
+      try {
+        runStage(stageIndex);
+      } catch (const Aborted &) {
+        // Another stage failed, and its exception will be re-thrown instead.
+      } catch (...) {
+        isAborted = true;
+        throw;
+      }
+    });
+
+    // The output was written starting at the beginning of the buffer, but
+    // callers expect it to be right-aligned:
+    int offset = ioBuffer.getNumSamples() - numOutputSamples;
+    if (offset > 0) {
+      for (int c = 0; c < numChannels; c++) {
+        float *channel = ioBuffer.getWritePointer(c);
+        std::memmove(channel + offset, channel,
+                     sizeof(float) * numOutputSamples);
+      }
+    }
+    return numOutputSamples;
+  }
+
+private:
+  struct Chunk {
+    Chunk(int numChannels, int numSamples)
+        : buffer(numChannels, numSamples) {}
+
+    juce::AudioBuffer<float> buffer;
+    int numSamples = 0;
+    bool isEndOfStream = false;
+  };
+
+  /**
+   * The connection between two adjacent stages. A fixed number of chunks
+   * circulate between them: the upstream stage fills empty chunks and the
+   * downstream stage hands them back once it has read them.
+   */
+  struct Edge {
+    // Enough to absorb some variation in how long each stage takes per block
+    // without using too much memory.
+    static constexpr size_t NumChunks = 4;
+
+    Edge(int numChannels, int blockSize)
+        : filledChunks(NumChunks), emptyChunks(NumChunks) {
+      for (size_t i = 0; i < NumChunks; i++) {
+        chunks.push_back(std::make_unique<Chunk>(numChannels, blockSize));
+        emptyChunks.tryPush(chunks.back().get());
+      }
+    }
+
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    SPSCQueue<Chunk *> filledChunks;
+    SPSCQueue<Chunk *> emptyChunks;
+  };
+
+  // Thrown on the other stages' threads if any stage throws an exception.
+  struct Aborted {};
+
+  template <typename Function> void waitUntil(Function tryToProceed) {
+    for (int attempt = 0; !tryToProceed(); attempt++) {
+      if (isAborted) {
+        throw Aborted();
+      }
+
+      if (attempt < 64) {
+        std::this_thread::yield();
+      } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+      }
+    }
+  }
+
+  void runStage(size_t stageIndex) {
+    std::shared_ptr<Plugin> plugin = stages[stageIndex];
+    juce::AudioBuffer<float> block(numChannels, blockSize);
+
+    // Input state:
+    int inputPosition = 0;
+    Chunk *inputChunk = nullptr;
+    int inputChunkPosition = 0;
+    bool inputFinished = false;
+
+    // The number of samples of silence still to be fed into this stage to
+    // flush out its latency, if this is the last call to process:
+    long long samplesOfSilenceOwed = 0;
+
+    while (true) {
+      int blockSamples = 0;
+
+      // Fill up the block with as much input as we can:
+      while (!inputFinished && blockSamples < blockSize) {
+        int samplesWanted = blockSize - blockSamples;
+
+        if (stageIndex == 0) {
+          int samplesToCopy =
+              std::min(samplesWanted, numInputSamples - inputPosition);
+          for (int c = 0; c < numChannels; c++) {
+            block.copyFrom(c, blockSamples, inputChannels[c] + inputPosition,
+                           samplesToCopy);
+          }
+          inputPosition += samplesToCopy;
+          blockSamples += samplesToCopy;
+          inputFinished = inputPosition == numInputSamples;
+          continue;
+        }
+
+        Edge &inputEdge = *edges[stageIndex - 1];
+        if (!inputChunk) {
+          waitUntil(
+              [&]() { return inputEdge.filledChunks.tryPop(inputChunk); });
+          inputChunkPosition = 0;
+          if (inputChunk->isEndOfStream) {
+            inputFinished = true;
+            break;
+          }
+        }
+
+        int samplesToCopy = std::min(
+            samplesWanted, inputChunk->numSamples - inputChunkPosition);
+        for (int c = 0; c < numChannels; c++) {
+          block.copyFrom(c, blockSamples, inputChunk->buffer, c,
+                         inputChunkPosition, samplesToCopy);
+        }
+        inputChunkPosition += samplesToCopy;
+        blockSamples += samplesToCopy;
+
+        if (inputChunkPosition == inputChunk->numSamples) {
+          inputEdge.emptyChunks.tryPush(inputChunk);
+          inputChunk = nullptr;
+        }
+      }
+
+      // Once all of the input has been received, follow it with silence
+      // (just as process() does) to flush out any delayed output:
+      if (inputFinished && samplesOfSilenceOwed > 0) {
+        int samplesOfSilence =
+            (int)std::min<long long>(blockSize - blockSamples,
+                                     samplesOfSilenceOwed);
+        block.clear(blockSamples, samplesOfSilence);
+        blockSamples += samplesOfSilence;
+        samplesOfSilenceOwed -= samplesOfSilence;
+      }
+
+      if (blockSamples == 0) {
+        break;
+      }
+
+      auto ioBlock = juce::dsp::AudioBlock<float>(
+          block.getArrayOfWritePointers(), numChannels, 0, blockSamples);
+      juce::dsp::ProcessContextReplacing<float> context(ioBlock);
+
+      int outputSamples = profiledProcess(plugin, context);
+      if (outputSamples < 0) {
+        throw std::runtime_error(
+            "A plugin returned a negative number of output samples! "
+            "This is an internal Pedalboard error and should be reported.");
+      }
+
+      int missingSamples = blockSamples - outputSamples;
+      if (missingSamples < 0) {
+        throw std::runtime_error(
+            "A plugin returned more samples than were asked for! "
+            "This is an internal Pedalboard error and should be reported.");
+      }
+
+      if (isProbablyLastProcessCall) {
+        samplesOfSilenceOwed += missingSamples;
+      }
+
+      // Output is right-aligned within each block:
+      writeOutput(stageIndex, block, missingSamples, outputSamples);
+    }
+
+    if (stageIndex + 1 < stages.size()) {
+      Edge &outputEdge = *edges[stageIndex];
+      Chunk *chunk = nullptr;
+      waitUntil([&]() { return outputEdge.emptyChunks.tryPop(chunk); });
+      chunk->numSamples = 0;
+      chunk->isEndOfStream = true;
+      outputEdge.filledChunks.tryPush(chunk);
+    }
+  }
+
+  void writeOutput(size_t stageIndex, const juce::AudioBuffer<float> &block,
+                   int startSample, int numSamples) {
+    if (numSamples == 0) {
+      return;
+    }
+
+    if (stageIndex + 1 < stages.size()) {
+      Edge &outputEdge = *edges[stageIndex];
+      Chunk *chunk = nullptr;
+      waitUntil([&]() { return outputEdge.emptyChunks.tryPop(chunk); });
+      for (int c = 0; c < numChannels; c++) {
+        chunk->buffer.copyFrom(c, 0, block, c, startSample, numSamples);
+      }
+      chunk->numSamples = numSamples;
+      chunk->isEndOfStream = false;
+      outputEdge.filledChunks.tryPush(chunk);
+      return;
+    }
+
+    // The last stage writes directly into ioBuffer. As no stage outputs
+    // more samples than it has been given, the first stage has always read
+    // past any samples we overwrite here. Samples past the end of the input
+    // can only be output once the first stage has read all of its input, so
+    // reallocating ioBuffer here is safe.
+    int endOfOutput = numOutputSamples + numSamples;
+    if (endOfOutput > ioBuffer.getNumSamples()) {
+      ioBuffer.setSize(numChannels, endOfOutput,
+                       /* keepExistingContent= */ true,
+                       /* clearExtraSpace= */ true);
+    }
+
+    for (int c = 0; c < numChannels; c++) {
+      ioBuffer.copyFrom(c, numOutputSamples, block, c, startSample,
+                        numSamples);
+    }
+    numOutputSamples = endOfOutput;
+  }
+
+  juce::AudioBuffer<float> &ioBuffer;
+  const std::vector<std::shared_ptr<Plugin>> &stages;
+  const int numChannels;
+  const int blockSize;
+  const int numInputSamples;
+  const bool isProbablyLastProcessCall;
+
+  std::vector<const float *> inputChannels;
+  std::vector<std::unique_ptr<Edge>> edges;
+
+  // Only accessed by the last stage until all stages have finished:
+  int numOutputSamples = 0;
+
+  std::atomic<bool> isAborted{false};
+};
+
+/**
+ * Process a given audio buffer through a list of plugins in series, like
+ * process(), but run each plugin on its own thread. Useful for speeding up
+ * offline rendering of long buffers through long chains of plugins.
+ */
+inline int processPipelined(juce::AudioBuffer<float> &ioBuffer,
+                            juce::dsp::ProcessSpec spec,
+                            const std::vector<std::shared_ptr<Plugin>> &plugins,
+                            bool isProbablyLastProcessCall) {
+  std::vector<std::shared_ptr<Plugin>> stages;
+  for (auto plugin : plugins) {
+    if (plugin) {
+      stages.push_back(plugin);
+    }
+  }
+
+  if (stages.empty()) {
+    return ioBuffer.getNumSamples();
+  }
+
+  return Pipeline(ioBuffer, spec, stages, isProbablyLastProcessCall).run();
+}
+
+} // namespace Pedalboard
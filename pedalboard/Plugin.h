@@ -19,11 +19,16 @@
 
 #include "BufferUtils.h"
 #include "JuceHeader.h"
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <vector>
 
 static constexpr int DEFAULT_BUFFER_SIZE = 8192;
 
 namespace Pedalboard {
+class Profiler;
+
 /**
  * A base class for all Pedalboard plugins, JUCE-derived or external.
  */
@@ -49,6 +54,23 @@ public:
   virtual int
   process(const juce::dsp::ProcessContextReplacing<float> &context) = 0;
 
+  /**
+   * Process a single buffer of 64-bit audio through this plugin, following
+   * the same rules as the 32-bit version above. This will only be called if
+   * supportsDoublePrecision() returns true.
+   */
+  virtual int
+  process(const juce::dsp::ProcessContextReplacing<double> &context) {
+    throw std::runtime_error(
+        "This plugin does not support 64-bit floating point processing.");
+  }
+
+  /**
+   * Returns true iff this plugin can process 64-bit audio directly, without
+   * first converting it to 32-bit.
+   */
+  virtual bool supportsDoublePrecision() { return false; }
+
   /**
    * Reset this plugin's state, clearing any internal buffers or delay lines.
    */
@@ -87,11 +109,29 @@ public:
    */
   virtual bool acceptsAudioInput() { return true; }
 
+  /**
+   * Create a new, independent instance of this plugin with the same
+   * parameters as this one. The returned plugin will not yet have been
+   * prepared, and shares no mutable state with this plugin, allowing both
+   * to process audio on separate threads at the same time. Large, immutable
+   * data (like impulse responses) should be shared rather than copied, to
+   * keep cloning much cheaper than constructing a new plugin from scratch.
+   *
+   * Returns nullptr if this plugin does not support cloning.
+   */
+  virtual std::shared_ptr<Plugin> clone() { return nullptr; }
+
   // A mutex to gate access to this plugin, as its internals may not be
   // thread-safe. Note: use std::lock or std::scoped_lock when locking multiple
   // plugins to avoid deadlocking.
   std::mutex mutex;
 
+  // The timing information recorded the last time this plugin was called
+  // from Python with profile=True, if any. Use std::atomic_load and
+  // std::atomic_store to access, as this may be accessed from multiple
+  // threads without holding this plugin's mutex.
+  std::shared_ptr<Profiler> lastProfile;
+
   template <typename T>
   ChannelLayout parseAndCacheChannelLayout(
       const py::array_t<T, py::array::c_style> inputArray,
@@ -127,4 +167,27 @@ protected:
   juce::dsp::ProcessSpec lastSpec = {0};
   std::optional<ChannelLayout> lastChannelLayout = {};
 };
+
+/**
+ * Clone each of the provided plugins (preserving any null entries), or
+ * return an empty optional if any of the plugins could not be cloned.
+ */
+inline std::optional<std::vector<std::shared_ptr<Plugin>>>
+clonePlugins(const std::vector<std::shared_ptr<Plugin>> &plugins) {
+  std::vector<std::shared_ptr<Plugin>> clones;
+  clones.reserve(plugins.size());
+  for (auto plugin : plugins) {
+    if (!plugin) {
+      clones.push_back(nullptr);
+      continue;
+    }
+
+    auto clone = plugin->clone();
+    if (!clone) {
+      return {};
+    }
+    clones.push_back(clone);
+  }
+  return clones;
+}
 } // namespace Pedalboard
\ No newline at end of file
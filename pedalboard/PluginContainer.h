@@ -58,6 +58,14 @@ public:
 
   std::vector<std::shared_ptr<Plugin>> &getPlugins() { return plugins; }
 
+  /*
+   * If true, when an entire buffer of audio is passed to this container
+   * from Python, each of its plugins will be run in series on its own thread
+   * (see Pipeline.h) rather than having this container's process() method
+   * called repeatedly.
+   */
+  virtual bool isPipelined() { return false; }
+
   /*
    * Get a flat list of all of the plugins contained
    * by this plugin, not including itself.
@@ -0,0 +1,509 @@
+/*
+ * pedalboard
+ * Copyright 2025 Spotify AB
+ *
+ * Licensed under the GNU Public License, Version 3.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    https://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "JuceHeader.h"
+#include "Plugin.h"
+
+namespace py = pybind11;
+
+namespace Pedalboard {
+
+/**
+ * Records how much time is spent in each plugin's process() method.
+ *
+ * Profiling is opt-in: a Profiler only records timing information while it
+ * is the active profiler on the current thread (see Profiler::ScopedActivation)
+ * and when plugins are called via profiledProcess. When no profiler is active,
+ * profiledProcess costs a single thread-local pointer check.
+ */
+class Profiler {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Entry {
+    std::weak_ptr<Plugin> plugin;
+    std::string name;
+
+    // The index of the entry for the plugin that contains this one, or -1 if
+    // this plugin was called directly.
+    long parentIndex = -1;
+    int depth = 0;
+
+    double wallTimeSeconds = 0;
+    long long samplesProcessed = 0;
+    long long numCalls = 0;
+  };
+
+  struct Event {
+    size_t entryIndex;
+    double startSeconds;
+    double durationSeconds;
+    int numSamples;
+    size_t threadIndex;
+  };
+
+  Profiler(double sampleRate) : sampleRate(sampleRate) {}
+
+  /**
+   * Make a profiler active on the current thread for the lifetime of this
+   * object, restoring the previously-active profiler (if any) afterwards.
+   */
+  class ScopedActivation {
+  public:
+    ScopedActivation(Profiler *profiler)
+        : previousProfiler(getCurrentRef()),
+          previousParentIndex(getCurrentParentIndexRef()) {
+      getCurrentRef() = profiler;
+      getCurrentParentIndexRef() = -1;
+      if (profiler) {
+        profiler->start();
+      }
+    }
+
+    ~ScopedActivation() {
+      if (Profiler *profiler = getCurrentRef()) {
+        profiler->stop();
+      }
+      getCurrentRef() = previousProfiler;
+      getCurrentParentIndexRef() = previousParentIndex;
+    }
+
+    ScopedActivation(const ScopedActivation &) = delete;
+    ScopedActivation &operator=(const ScopedActivation &) = delete;
+
+  private:
+    Profiler *previousProfiler;
+    long previousParentIndex;
+  };
+
+  /**
+   * The profiler active on a thread, and the entry of the plugin currently
+   * being processed on that thread (or -1 if none).
+   */
+  struct Context {
+    Profiler *profiler;
+    long parentIndex;
+  };
+
+  /**
+   * Adopt another thread's profiling context on the current thread for the
+   * lifetime of this object. Used when a container plugin hands work off to
+   * other threads, so that time spent there is attributed to the container.
+   */
+  class ScopedContext {
+  public:
+    ScopedContext(Context context)
+        : previousContext{getCurrentRef(), getCurrentParentIndexRef()} {
+      getCurrentRef() = context.profiler;
+      getCurrentParentIndexRef() = context.parentIndex;
+    }
+
+    ~ScopedContext() {
+      getCurrentRef() = previousContext.profiler;
+      getCurrentParentIndexRef() = previousContext.parentIndex;
+    }
+
+    ScopedContext(const ScopedContext &) = delete;
+    ScopedContext &operator=(const ScopedContext &) = delete;
+
+  private:
+    Context previousContext;
+  };
+
+  /**
+   * Returns the profiler active on the current thread, or nullptr.
+   */
+  static Profiler *getCurrent() { return getCurrentRef(); }
+
+  /**
+   * Returns the profiling context of the current thread, to be passed to a
+   * ScopedContext on another thread.
+   */
+  static Context getCurrentContext() {
+    return {getCurrentRef(), getCurrentParentIndexRef()};
+  }
+
+  /**
+   * Run the provided plugin's process() method, recording how long it took.
+   */
+  template <typename SampleType>
+  int process(const std::shared_ptr<Plugin> &plugin,
+              const juce::dsp::ProcessContextReplacing<SampleType> &context) {
+    long &parentIndex = getCurrentParentIndexRef();
+    long entryIndex = getEntryIndex(plugin, parentIndex);
+
+    long previousParentIndex = parentIndex;
+    parentIndex = entryIndex;
+
+    Clock::time_point eventStart = Clock::now();
+    int samplesOutput;
+    try {
+      samplesOutput = plugin->process(context);
+    } catch (...) {
+      parentIndex = previousParentIndex;
+      throw;
+    }
+    Clock::time_point eventEnd = Clock::now();
+
+    parentIndex = previousParentIndex;
+
+    record(entryIndex, eventStart, eventEnd,
+           context.getInputBlock().getNumSamples());
+    return samplesOutput;
+  }
+
+  double getSampleRate() const { return sampleRate; }
+
+  double getWallTimeSeconds() const {
+    return std::chrono::duration<double>(endTime - startTime).count();
+  }
+
+  const std::vector<Entry> &getEntries() const { return entries; }
+  const std::vector<Event> &getEvents() const { return events; }
+
+  /**
+   * Fill in the human-readable name of each plugin in this profile. Must be
+   * called with the GIL held.
+   */
+  void resolveNames() {
+    for (auto &entry : entries) {
+      if (!entry.name.empty())
+        continue;
+
+      if (auto plugin = entry.plugin.lock()) {
+        py::object pluginClass = py::cast(plugin).attr("__class__");
+        entry.name = pluginClass.attr("__name__").cast<std::string>();
+      } else {
+        entry.name = "Plugin";
+      }
+    }
+  }
+
+  /**
+   * Return the time spent in the given entry's plugin, not including time
+   * spent in any plugins it contains.
+   */
+  double getSelfTimeSeconds(size_t entryIndex) const {
+    double selfTime = entries[entryIndex].wallTimeSeconds;
+    for (const auto &entry : entries) {
+      if (entry.parentIndex == (long)entryIndex) {
+        selfTime -= entry.wallTimeSeconds;
+      }
+    }
+    return std::max(0.0, selfTime);
+  }
+
+  /**
+   * Render the recorded events in the Chrome Trace Event format, viewable in
+   * chrome://tracing or https://ui.perfetto.dev.
+   */
+  std::string toChromeTrace() const {
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "{\"traceEvents\": [";
+    for (size_t i = 0; i < events.size(); i++) {
+      const Event &event = events[i];
+      if (i > 0)
+        ss << ", ";
+      ss << "{\"name\": \"" << escapeJSON(entries[event.entryIndex].name)
+         << "\", \"cat\": \"plugin\", \"ph\": \"X\", \"pid\": 0"
+         << ", \"tid\": " << event.threadIndex
+         << ", \"ts\": " << (event.startSeconds * 1e6)
+         << ", \"dur\": " << (event.durationSeconds * 1e6)
+         << ", \"args\": {\"samples\": " << event.numSamples
+         << ", \"depth\": " << entries[event.entryIndex].depth << "}}";
+    }
+    ss << "], \"displayTimeUnit\": \"ms\", \"otherData\": {\"sample_rate\": "
+       << sampleRate << "}}";
+    return ss.str();
+  }
+
+private:
+  static Profiler *&getCurrentRef() {
+    static thread_local Profiler *current = nullptr;
+    return current;
+  }
+
+  static long &getCurrentParentIndexRef() {
+    static thread_local long parentIndex = -1;
+    return parentIndex;
+  }
+
+  static std::string escapeJSON(const std::string &input) {
+    std::ostringstream ss;
+    for (char c : input) {
+      switch (c) {
+      case '"':
+        ss << "\\\"";
+        break;
+      case '\\':
+        ss << "\\\\";
+        break;
+      default:
+        if ((unsigned char)c < 0x20) {
+          ss << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+             << (int)c << std::dec;
+        } else {
+          ss << c;
+        }
+      }
+    }
+    return ss.str();
+  }
+
+  void start() {
+    std::scoped_lock lock(mutex);
+    if (!hasStarted) {
+      startTime = Clock::now();
+      endTime = startTime;
+      hasStarted = true;
+    }
+  }
+
+  void stop() {
+    std::scoped_lock lock(mutex);
+    endTime = std::max(endTime, Clock::now());
+  }
+
+  long getEntryIndex(const std::shared_ptr<Plugin> &plugin, long parentIndex) {
+    std::scoped_lock lock(mutex);
+    auto key = std::make_pair(plugin.get(), parentIndex);
+    auto existing = entryIndices.find(key);
+    if (existing != entryIndices.end()) {
+      return existing->second;
+    }
+
+    Entry entry;
+    entry.plugin = plugin;
+    entry.parentIndex = parentIndex;
+    entry.depth = parentIndex >= 0 ? entries[parentIndex].depth + 1 : 0;
+    entries.push_back(entry);
+
+    long index = entries.size() - 1;
+    entryIndices[key] = index;
+    return index;
+  }
+
+  void record(long entryIndex, Clock::time_point eventStart,
+              Clock::time_point eventEnd, int numSamples) {
+    std::scoped_lock lock(mutex);
+    Entry &entry = entries[entryIndex];
+    double duration =
+        std::chrono::duration<double>(eventEnd - eventStart).count();
+    entry.wallTimeSeconds += duration;
+    entry.samplesProcessed += numSamples;
+    entry.numCalls++;
+
+    auto threadId = std::this_thread::get_id();
+    auto thread = threadIndices.find(threadId);
+    if (thread == threadIndices.end()) {
+      thread = threadIndices.emplace(threadId, threadIndices.size()).first;
+    }
+
+    events.push_back(
+        {(size_t)entryIndex,
+         std::chrono::duration<double>(eventStart - startTime).count(),
+         duration, numSamples, thread->second});
+  }
+
+  struct EntryKeyHash {
+    size_t operator()(const std::pair<const Plugin *, long> &key) const {
+      return std::hash<const Plugin *>()(key.first) ^
+             (std::hash<long>()(key.second) << 1);
+    }
+  };
+
+  const double sampleRate;
+
+  std::mutex mutex;
+  bool hasStarted = false;
+  Clock::time_point startTime;
+  Clock::time_point endTime;
+
+  std::vector<Entry> entries;
+  std::unordered_map<std::pair<const Plugin *, long>, long, EntryKeyHash>
+      entryIndices;
+  std::vector<Event> events;
+  std::unordered_map<std::thread::id, size_t> threadIndices;
+};
+
+/**
+ * Call plugin->process(context), recording timing information if a Profiler
+ * is active on the current thread.
+ */
+template <typename SampleType>
+int profiledProcess(
+    const std::shared_ptr<Plugin> &plugin,
+    const juce::dsp::ProcessContextReplacing<SampleType> &context) {
+  if (Profiler *profiler = Profiler::getCurrent()) {
+    return profiler->process(plugin, context);
+  }
+  return plugin->process(context);
+}
+
+/**
+ * A read-only view of one plugin's entry in a Profiler, exposed to Python.
+ */
+struct ProfileEntry {
+  std::shared_ptr<Profiler> profiler;
+  size_t index;
+
+  const Profiler::Entry &get() const { return profiler->getEntries()[index]; }
+
+  double getRealtimeFactor() const {
+    const auto &entry = get();
+    if (entry.wallTimeSeconds <= 0)
+      return 0;
+    return (entry.samplesProcessed / profiler->getSampleRate()) /
+           entry.wallTimeSeconds;
+  }
+};
+
+inline void init_profiler(py::module &m) {
+  py::class_<ProfileEntry>(
+      m, "ProfileEntry",
+      "Timing information about a single plugin, as recorded by a call to "
+      ":py:meth:`pedalboard.Plugin.process` with ``profile=True``.\n\n"
+      "*Introduced in v0.9.22.*")
+      .def_property_readonly(
+          "plugin",
+          [](const ProfileEntry &self) -> std::shared_ptr<Plugin> {
+            return self.get().plugin.lock();
+          },
+          "The plugin that was profiled, or ``None`` if it no longer exists.")
+      .def_property_readonly(
+          "name", [](const ProfileEntry &self) { return self.get().name; },
+          "The class name of the plugin that was profiled.")
+      .def_property_readonly(
+          "depth", [](const ProfileEntry &self) { return self.get().depth; },
+          "How deeply nested this plugin is within containers like "
+          ":class:`pedalboard.Chain` or :class:`pedalboard.Mix`. The plugin "
+          "that was called directly has a depth of 0.")
+      .def_property_readonly(
+          "parent",
+          [](const ProfileEntry &self) -> std::optional<ProfileEntry> {
+            long parentIndex = self.get().parentIndex;
+            if (parentIndex < 0)
+              return {};
+            return ProfileEntry{self.profiler, (size_t)parentIndex};
+          },
+          "The entry for the container plugin that called this plugin, or "
+          "``None`` if this plugin was called directly.")
+      .def_property_readonly(
+          "wall_time",
+          [](const ProfileEntry &self) { return self.get().wallTimeSeconds; },
+          "The total time (in seconds) spent processing audio in this plugin, "
+          "including the time spent in any plugins it contains.")
+      .def_property_readonly(
+          "self_time",
+          [](const ProfileEntry &self) {
+            return self.profiler->getSelfTimeSeconds(self.index);
+          },
+          "The total time (in seconds) spent processing audio in this plugin, "
+          "not including the time spent in any plugins it contains.")
+      .def_property_readonly(
+          "samples_processed",
+          [](const ProfileEntry &self) { return self.get().samplesProcessed; },
+          "The total number of samples (per channel) passed to this plugin.")
+      .def_property_readonly(
+          "num_calls",
+          [](const ProfileEntry &self) { return self.get().numCalls; },
+          "The number of blocks of audio passed to this plugin.")
+      .def_property_readonly(
+          "realtime_factor", &ProfileEntry::getRealtimeFactor,
+          "How many times faster than real-time this plugin processed audio. "
+          "(A value of 10 means that one second of audio took 0.1 seconds to "
+          "process.)")
+      .def("__repr__", [](const ProfileEntry &self) {
+        std::ostringstream ss;
+        ss << "<pedalboard.ProfileEntry";
+        ss << " name=\"" << self.get().name << "\"";
+        ss << " depth=" << self.get().depth;
+        ss << " wall_time=" << self.get().wallTimeSeconds;
+        ss << " num_calls=" << self.get().numCalls;
+        ss << " realtime_factor=" << self.getRealtimeFactor();
+        ss << ">";
+        return ss.str();
+      });
+
+  py::class_<Profiler, std::shared_ptr<Profiler>>(
+      m, "Profile",
+      "Per-plugin timing information recorded while processing audio. "
+      "Returned by the ``last_profile`` property of a "
+      ":py:class:`pedalboard.Plugin` after calling "
+      ":py:meth:`pedalboard.Plugin.process` with ``profile=True``.\n\n"
+      "Containers (like :class:`pedalboard.Pedalboard`, "
+      ":class:`pedalboard.Chain` and :class:`pedalboard.Mix`) appear in "
+      "``entries`` before the plugins they contain.\n\n"
+      "*Introduced in v0.9.22.*")
+      .def(py::init([]() {
+        throw py::type_error(
+            "Profile objects cannot be created directly; pass profile=True "
+            "to Plugin.process and use Plugin.last_profile instead.");
+        // This will never be hit, but is required to provide a non-void
+        // type to return from this lambda or else the compiler can't do
+        // type inference.
+        return nullptr;
+      }))
+      .def_property_readonly(
+          "entries",
+          [](std::shared_ptr<Profiler> self) {
+            std::vector<ProfileEntry> entries;
+            for (size_t i = 0; i < self->getEntries().size(); i++) {
+              entries.push_back({self, i});
+            }
+            return entries;
+          },
+          "A list of :class:`pedalboard.ProfileEntry` objects, one for each plugin that "
+          "processed audio.")
+      .def_property_readonly("sample_rate", &Profiler::getSampleRate,
+                             "The sample rate of the audio that was processed.")
+      .def_property_readonly(
+          "wall_time", &Profiler::getWallTimeSeconds,
+          "The total time (in seconds) spent processing audio.")
+      .def(
+          "to_chrome_trace", &Profiler::toChromeTrace,
+          "Return a JSON string in the Chrome Trace Event format, containing "
+          "one event for every block of audio processed by every plugin. Save "
+          "this string to a ``.json`` file and open it in "
+          "``chrome://tracing`` or https://ui.perfetto.dev to visualize it.")
+      .def("__repr__", [](std::shared_ptr<Profiler> self) {
+        std::ostringstream ss;
+        ss << "<pedalboard.Profile";
+        ss << " entries=" << self->getEntries().size();
+        ss << " wall_time=" << self->getWallTimeSeconds();
+        ss << " at " << self.get();
+        ss << ">";
+        return ss.str();
+      });
+}
+
+} // namespace Pedalboard
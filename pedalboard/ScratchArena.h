@@ -0,0 +1,208 @@
+/*
+ * pedalboard
+ * Copyright 2025 Spotify AB
+ *
+ * Licensed under the GNU Public License, Version 3.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    https://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Pedalboard {
+
+/**
+ * Counts the heap allocations made while processing audio (as opposed to
+ * while preparing to process audio), so that tests can verify that
+ * steady-state processing never allocates.
+ *
+ * Allocations are only counted in test builds (built with COUNT_ALLOCATIONS=1,
+ * which defines PEDALBOARD_COUNT_HEAP_ALLOCATIONS). These replace the heap
+ * allocation functions used by Pedalboard (see HeapAllocationHooks.cpp) to
+ * call recordAllocation(). Every allocation made on any thread while a
+ * ScopedCounting object exists is counted.
+ */
+class AllocationCounter {
+public:
+  static constexpr bool isEnabled() {
+#ifdef PEDALBOARD_COUNT_HEAP_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  class ScopedCounting {
+  public:
+    ScopedCounting() { activeScopes.fetch_add(1, std::memory_order_relaxed); }
+    ~ScopedCounting() { activeScopes.fetch_sub(1, std::memory_order_relaxed); }
+
+    ScopedCounting(const ScopedCounting &) = delete;
+    ScopedCounting &operator=(const ScopedCounting &) = delete;
+  };
+
+  static void recordAllocation() noexcept {
+    if (activeScopes.load(std::memory_order_relaxed) > 0) {
+      count.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  static long long getCount() {
+    return count.load(std::memory_order_relaxed);
+  }
+
+private:
+  static inline std::atomic<int> activeScopes{0};
+  static inline std::atomic<long long> count{0};
+};
+
+/**
+ * A region of memory, allocated ahead of time (usually in prepare()), that
+ * can be handed out in pieces while processing audio without calling into
+ * the system allocator. Call rewind() before processing each block to reuse
+ * the same memory again.
+ *
+ * If more memory is requested than was reserved, the arena grows by adding
+ * another region rather than moving any memory that has already been handed
+ * out. The next call to
+ * reserve() consolidates everything back into a single region.
+ */
+class ScratchArena {
+public:
+  static constexpr size_t Alignment = 64;
+
+  /**
+   * Return the number of bytes that a call to allocate<T>(count) will use.
+   */
+  template <typename T> static size_t getAllocationSize(size_t count) {
+    return ((sizeof(T) * count + Alignment - 1) / Alignment) * Alignment;
+  }
+
+  /**
+   * Ensure that at least numBytes can be allocated between calls to
+   * rewind() without growing. Must not be called while memory handed out
+   * by this arena is still in use.
+   */
+  void reserve(size_t numBytes) {
+    numBytes = std::max(numBytes, highWaterMark);
+    if (regions.size() == 1 && regions[0].size >= numBytes) {
+      rewind();
+      return;
+    }
+
+    regions.clear();
+    if (numBytes > 0) {
+      addRegion(numBytes);
+    }
+    highWaterMark = 0;
+    rewind();
+  }
+
+  /**
+   * Make all of the memory in this arena available to be handed out again.
+   */
+  void rewind() {
+    currentRegion = 0;
+    bytesUsedInCurrentRegion = 0;
+    bytesUsed = 0;
+  }
+
+  /**
+   * Rewinds the arena to where it was when this object was created once it
+   * is destroyed, making memory allocated during its lifetime available to
+   * be handed out again while leaving earlier allocations untouched. Scopes
+   * may be nested, but reserve() and rewind() must not be called within one.
+   */
+  class Scope {
+  public:
+    explicit Scope(ScratchArena &arena)
+        : arena(arena), region(arena.currentRegion),
+          bytesUsedInRegion(arena.bytesUsedInCurrentRegion),
+          bytesUsed(arena.bytesUsed) {}
+
+    ~Scope() {
+      arena.currentRegion = region;
+      arena.bytesUsedInCurrentRegion = bytesUsedInRegion;
+      arena.bytesUsed = bytesUsed;
+    }
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+  private:
+    ScratchArena &arena;
+    size_t region;
+    size_t bytesUsedInRegion;
+    size_t bytesUsed;
+  };
+
+  /**
+   * Return uninitialized, 64-byte-aligned memory for count objects of type T,
+   * valid until the next call to rewind() or reserve(), or until the
+   * innermost Scope that was active when it was allocated is destroyed.
+   */
+  template <typename T> T *allocate(size_t count) {
+    static_assert(alignof(T) <= Alignment, "Type is too strictly aligned.");
+    size_t numBytes = getAllocationSize<T>(count);
+
+    while (currentRegion < regions.size() &&
+           bytesUsedInCurrentRegion + numBytes > regions[currentRegion].size) {
+      currentRegion++;
+      bytesUsedInCurrentRegion = 0;
+    }
+
+    if (currentRegion == regions.size()) {
+      // Leave room for further allocations to avoid adding many regions:
+      addRegion(std::max(2 * numBytes, highWaterMark));
+      bytesUsedInCurrentRegion = 0;
+    }
+
+    char *pointer =
+        regions[currentRegion].getAlignedStart() + bytesUsedInCurrentRegion;
+    bytesUsedInCurrentRegion += numBytes;
+    bytesUsed += numBytes;
+    highWaterMark = std::max(highWaterMark, bytesUsed);
+    return reinterpret_cast<T *>(pointer);
+  }
+
+private:
+  struct Region {
+    std::unique_ptr<char[]> data;
+    size_t size;
+
+    char *getAlignedStart() const {
+      uintptr_t address = reinterpret_cast<uintptr_t>(data.get());
+      return data.get() + ((Alignment - (address % Alignment)) % Alignment);
+    }
+  };
+
+  void addRegion(size_t size) {
+    // Over-allocate slightly so that the start of the region can be aligned:
+    regions.push_back(
+        {std::unique_ptr<char[]>(new char[size + Alignment]), size});
+  }
+
+  std::vector<Region> regions;
+  size_t currentRegion = 0;
+  size_t bytesUsedInCurrentRegion = 0;
+
+  // Used to size the arena appropriately when it is next consolidated:
+  size_t bytesUsed = 0;
+  size_t highWaterMark = 0;
+};
+
+} // namespace Pedalboard
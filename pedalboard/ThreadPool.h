@@ -0,0 +1,190 @@
+/*
+ * pedalboard
+ * Copyright 2025 Spotify AB
+ *
+ * Licensed under the GNU Public License, Version 3.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    https://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Pedalboard {
+
+/**
+ * A small, fixed-size pool of native worker threads, used to run
+ * data-parallel work (i.e.: "do this for each of these N items") without
+ * holding the GIL.
+ *
+ * The thread that calls parallelFor() also participates in the work, so a
+ * pool created with numThreads = 4 will spawn only three background threads.
+ *
+ * None of the methods on this class interact with Python, so they may (and
+ * should) be called with the GIL released.
+ */
+class ThreadPool {
+public:
+  using Task = std::function<void(size_t itemIndex, size_t workerIndex)>;
+
+  ThreadPool(size_t numThreads) : numWorkers(std::max<size_t>(1, numThreads)) {
+    for (size_t i = 1; i < numWorkers; i++) {
+      threads.emplace_back([this, i]() { workerLoop(i); });
+    }
+  }
+
+  ~ThreadPool() {
+    {
+      std::unique_lock<std::mutex> lock(stateMutex);
+      isShuttingDown = true;
+    }
+    workAvailable.notify_all();
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /**
+   * The number of workers (including the calling thread) that will be used
+   * to run tasks passed to parallelFor().
+   */
+  size_t getNumWorkers() const { return numWorkers; }
+
+  /**
+   * Call task(itemIndex, workerIndex) once for each itemIndex in
+   * [0, numItems), spread across all of this pool's workers, and block until
+   * all items have been processed.
+   *
+   * workerIndex is always less than getNumWorkers(), and no two concurrent
+   * calls to task will ever receive the same workerIndex, making it safe to
+   * use as an index into per-worker state.
+   *
+   * If any call to task throws, remaining items are skipped and the first
+   * exception thrown is re-thrown on the calling thread.
+   */
+  void parallelFor(size_t numItems, const Task &task) {
+    if (numItems == 0)
+      return;
+
+    // Only one parallelFor may run on a pool at once:
+    std::scoped_lock callLock(callMutex);
+
+    if (numWorkers == 1 || numItems == 1) {
+      for (size_t i = 0; i < numItems; i++) {
+        task(i, 0);
+      }
+      return;
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(stateMutex);
+      currentTask = &task;
+      currentNumItems = numItems;
+      nextItem = 0;
+      firstException = nullptr;
+      busyWorkers = numWorkers - 1;
+      generation++;
+    }
+    workAvailable.notify_all();
+
+    runItems(0);
+
+    std::unique_lock<std::mutex> lock(stateMutex);
+    workFinished.wait(lock, [this]() { return busyWorkers == 0; });
+    currentTask = nullptr;
+
+    if (firstException) {
+      std::rethrow_exception(firstException);
+    }
+  }
+
+  /**
+   * The number of hardware threads available on this machine, or 1 if that
+   * number cannot be determined.
+   */
+  static size_t getDefaultNumThreads() {
+    return std::max(1u, std::thread::hardware_concurrency());
+  }
+
+private:
+  void workerLoop(size_t workerIndex) {
+    unsigned long long lastGeneration = 0;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        workAvailable.wait(lock, [this, lastGeneration]() {
+          return isShuttingDown || generation != lastGeneration;
+        });
+        if (isShuttingDown)
+          return;
+        lastGeneration = generation;
+      }
+
+      runItems(workerIndex);
+
+      {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        busyWorkers--;
+      }
+      workFinished.notify_all();
+    }
+  }
+
+  void runItems(size_t workerIndex) {
+    while (true) {
+      size_t item = nextItem.fetch_add(1);
+      if (item >= currentNumItems)
+        return;
+
+      try {
+        (*currentTask)(item, workerIndex);
+      } catch (...) {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        if (!firstException) {
+          firstException = std::current_exception();
+        }
+        // Skip all remaining items:
+        nextItem = currentNumItems;
+        return;
+      }
+    }
+  }
+
+  const size_t numWorkers;
+  std::vector<std::thread> threads;
+
+  std::mutex callMutex;
+
+  std::mutex stateMutex;
+  std::condition_variable workAvailable;
+  std::condition_variable workFinished;
+  bool isShuttingDown = false;
+  unsigned long long generation = 0;
+  size_t busyWorkers = 0;
+
+  const Task *currentTask = nullptr;
+  size_t currentNumItems = 0;
+  std::atomic<size_t> nextItem{0};
+  std::exception_ptr firstException;
+};
+
+} // namespace Pedalboard
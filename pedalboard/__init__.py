@@ -35,6 +35,10 @@ except ImportError as _e:
         raise
 from pedalboard_native.utils import *  # noqa: F403, F401 # type: ignore
 
+# Profiling results are returned by Plugin.last_profile, and are documented as
+# pedalboard.Profile and pedalboard.ProfileEntry:
+from pedalboard_native.utils import Profile, ProfileEntry  # noqa: F401 # type: ignore
+
 from ._pedalboard import (  # noqa: F401
     _AVAILABLE_PLUGIN_CLASSES,
     AudioProcessorParameter,  # noqa: F401
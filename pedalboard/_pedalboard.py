@@ -52,14 +52,23 @@ class Pedalboard(Chain):
         my_pedalboard.append(Reverb())
         output_audio = my_pedalboard(input_audio)
 
+    If ``pipelined`` is ``True``, each plugin in this :class:`Pedalboard` will be run on its
+    own thread, with blocks of audio passed from one plugin to the next as soon as they have
+    been processed. This can speed up rendering of long audio buffers through many plugins,
+    without changing the output. To run several plugins on the same thread, group them
+    together in a :class:`Chain`. (*Introduced in v0.9.22.*)
+
     .. warning::
         :class:`Pedalboard` objects may only contain effects plugins (i.e.: those for which
         :attr:`is_effect` is ``True``), and cannot contain instrument plugins (i.e.: those
         for which :attr:`is_instrument` is ``True``).
     """
 
-    def __init__(self, plugins: Optional[List[Plugin]] = None):
-        super().__init__(plugins or [])
+    def __init__(self, plugins: Optional[List[Plugin]] = None, pipelined: bool = False):
+        super().__init__(plugins or [], pipelined=pipelined)
+
+    def clone(self) -> "Pedalboard":
+        return Pedalboard(list(super().clone()), pipelined=self.pipelined)
 
     def __repr__(self) -> str:
         return "<{} with {} plugin{}: {}>".format(
@@ -128,6 +128,26 @@ Re-encoding a WAV file as an MP3 in four lines of Python::
                o.write(i.read(1024))
 
 
+Decoding the next few chunks of a file on a background thread while
+processing the current one::
+
+   with AudioFile("input.mp3", prefetch=4) as i:
+       with AudioFile("output.mp3", "w", i.samplerate, i.num_channels) as o:
+           while i.tell() < i.frames:
+               o.write(board(i.read(i.samplerate), i.samplerate, reset=False))
+
+
+Encoding previously-processed chunks on a background thread while
+processing the next one::
+
+   with AudioFile("input.wav") as i:
+       with AudioFile(
+           "output.mp3", "w", i.samplerate, i.num_channels, queue_size=4
+       ) as o:
+           while i.tell() < i.frames:
+               o.write(board(i.read(i.samplerate), i.samplerate, reset=False))
+
+
 .. note::
     Calling the :class:`AudioFile` constructor does not actually return an
     :class:`AudioFile`. If opening an audio file in read ("r") mode, a
@@ -150,9 +170,10 @@ inline void init_audio_file(
                          // instantiate subclasses via __new__.
       .def_static(
           "__new__",
-          [](const py::object *, std::string filename, std::string mode) {
+          [](const py::object *, std::string filename, std::string mode,
+             int prefetch) {
             if (mode == "r") {
-              return std::make_shared<ReadableAudioFile>(filename);
+              return std::make_shared<ReadableAudioFile>(filename, prefetch);
             } else if (mode == "w") {
               throw py::type_error("Opening an audio file for writing requires "
                                    "samplerate and num_channels arguments.");
@@ -162,10 +183,19 @@ inline void init_audio_file(
             }
           },
           py::arg("cls"), py::arg("filename"), py::arg("mode") = "r",
-          "Open an audio file for reading.")
+          py::arg("prefetch") = 0,
+          "Open an audio file for reading.\n\nIf ``prefetch`` is greater "
+          "than zero, a background thread will decode up to ``prefetch`` "
+          "chunks of audio ahead of the current position, allowing "
+          "decoding to overlap with the processing of audio that has "
+          "already been read. Calling :meth:`seek` discards any audio "
+          "decoded ahead of time. Prefetching is only supported when "
+          "reading from a filename.\n\n*The prefetch argument was "
+          "introduced in v0.9.22.*")
       .def_static(
           "__new__",
-          [](const py::object *, py::object filelike, std::string mode) {
+          [](const py::object *, py::object filelike, std::string mode,
+             int bufferSize) {
             if (mode == "r") {
               if (!isReadableFileLike(filelike) &&
                   !tryConvertingToBuffer(filelike)) {
@@ -183,7 +213,7 @@ inline void init_audio_file(
                                                                   filelike));
               } else {
                 return std::make_shared<ReadableAudioFile>(
-                    std::make_unique<PythonInputStream>(filelike));
+                    std::make_unique<PythonInputStream>(filelike, bufferSize));
               }
             } else if (mode == "w") {
               throw py::type_error(
@@ -195,15 +225,28 @@ inline void init_audio_file(
             }
           },
           py::arg("cls"), py::arg("file_like"), py::arg("mode") = "r",
+          py::arg("buffer_size") = 0,
           "Open a file-like object for reading. The provided object must have "
           "``read``, ``seek``, ``tell``, and ``seekable`` methods, and must "
           "return binary data (i.e.: ``open(..., \"w\")`` or ``io.BytesIO``, "
-          "etc.).")
+          "etc.).\n\nIf ``buffer_size`` is greater than zero, data will be "
+          "read from the file-like object in blocks of ``buffer_size`` bytes "
+          "(i.e.: ``256 * 1024``), reducing the number of calls made into "
+          "Python while decoding. When buffering, the position of the "
+          "file-like object may not match the position of the audio data "
+          "being read, and exceptions raised by the file-like object may be "
+          "delayed until the buffered data has been consumed. Objects that "
+          "support the buffer protocol (i.e.: :class:`bytes`, "
+          ":class:`memoryview`, or :class:`io.BytesIO`) are always read "
+          "directly from memory without calling into Python, and ignore "
+          "``buffer_size``.\n\n*The buffer_size argument was introduced in "
+          "v0.9.22.*")
       .def_static(
           "__new__",
           [](const py::object *, std::string filename, std::string mode,
              std::optional<double> sampleRate, int numChannels, int bitDepth,
-             std::optional<std::variant<std::string, float>> quality) {
+             std::optional<std::variant<std::string, float>> quality,
+             int queueSize) {
             if (mode == "r") {
               throw py::type_error(
                   "Opening an audio file for reading does not require "
@@ -218,7 +261,8 @@ inline void init_audio_file(
               }
 
               return std::make_shared<WriteableAudioFile>(
-                  filename, *sampleRate, numChannels, bitDepth, quality);
+                  filename, *sampleRate, numChannels, bitDepth, quality,
+                  queueSize);
             } else {
               throw py::type_error("AudioFile instances can only be opened in "
                                    "read mode (\"r\") or write mode (\"w\").");
@@ -226,7 +270,14 @@ inline void init_audio_file(
           },
           py::arg("cls"), py::arg("filename"), py::arg("mode") = "w",
           py::arg("samplerate") = py::none(), py::arg("num_channels") = 1,
-          py::arg("bit_depth") = 16, py::arg("quality") = py::none())
+          py::arg("bit_depth") = 16, py::arg("quality") = py::none(),
+          py::arg("queue_size") = 0,
+          "Open an audio file for writing.\n\nIf ``queue_size`` is greater "
+          "than zero, audio passed to :meth:`write` will be encoded on a "
+          "background thread, with up to ``queue_size`` chunks of audio "
+          "waiting to be encoded at once. Encoding in the background is "
+          "only supported when writing to a filename.\n\n*The queue_size "
+          "argument was introduced in v0.9.22.*")
       .def_static(
           "__new__",
           [](const py::object *, py::object filelike, std::string mode,
@@ -0,0 +1,322 @@
+/*
+ * pedalboard
+ * Copyright 2025 Spotify AB
+ *
+ * Licensed under the GNU Public License, Version 3.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    https://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "../JuceHeader.h"
+#include "../ThreadPool.h"
+#include "ReadableAudioFile.h"
+#include "ResampledReadableAudioFile.h"
+
+namespace py = pybind11;
+
+namespace Pedalboard {
+
+/**
+ * Open an audio file for reading by load_many, checking that its channels
+ * can be converted to numChannels channels: the file must contain either
+ * numChannels channels or one channel, or numChannels must be 1.
+ */
+inline std::shared_ptr<ReadableAudioFile>
+openAudioFileForLoading(const std::string &path, int numChannels) {
+  auto file = std::make_shared<ReadableAudioFile>(path);
+  const int fileChannels = file->getNumChannels();
+
+  if (fileChannels != numChannels && fileChannels != 1 && numChannels != 1) {
+    throw std::domain_error(
+        "Audio file \"" + path + "\" has " + std::to_string(fileChannels) +
+        " channels, which cannot be converted to " +
+        std::to_string(numChannels) +
+        " channels. (Mono files can be converted to any number of "
+        "channels, and any file can be converted to mono.)");
+  }
+  return file;
+}
+
+/**
+ * Read the provided audio file in full (or its first maxFrames frames, if
+ * provided), resampled to the given sample rate, with its own number of
+ * channels.
+ *
+ * This function does not take or hold the GIL, so many files may be loaded
+ * at once on different threads.
+ */
+inline juce::AudioBuffer<float>
+loadAudioFile(std::shared_ptr<ReadableAudioFile> file, double sampleRate,
+              ResamplingQuality quality, std::optional<long long> maxFrames) {
+  const int fileChannels = file->getNumChannels();
+
+  if (file->getSampleRateAsDouble() == sampleRate) {
+    long long numFrames = file->getLengthInSamples();
+    if (maxFrames)
+      numFrames = std::min(numFrames, *maxFrames);
+
+    juce::AudioBuffer<float> audio(fileChannels, numFrames);
+    long long framesRead = file->readIntoChannels(
+        audio.getArrayOfWritePointers(), numFrames);
+    audio.setSize(fileChannels, framesRead, /* keepExistingContent */ true);
+    return audio;
+  }
+
+  ResampledReadableAudioFile resampledFile(file, sampleRate, quality);
+  if (maxFrames)
+    return resampledFile.readInternal(*maxFrames);
+
+  // We don't know exactly how long the resampled audio will be, so read
+  // until the resampler runs dry:
+  const long long chunkSize = DEFAULT_AUDIO_BUFFER_SIZE_FRAMES * 16;
+  juce::AudioBuffer<float> audio(fileChannels, 0);
+  while (true) {
+    juce::AudioBuffer<float> chunk = resampledFile.readInternal(chunkSize);
+    int offset = audio.getNumSamples();
+    audio.setSize(fileChannels, offset + chunk.getNumSamples(),
+                  /* keepExistingContent */ true);
+    for (int c = 0; c < fileChannels; c++) {
+      audio.copyFrom(c, offset, chunk, c, 0, chunk.getNumSamples());
+    }
+    if (chunk.getNumSamples() < chunkSize)
+      return audio;
+  }
+}
+
+/**
+ * Copy the provided audio into a contiguous output array of shape
+ * [numChannels, outputStride], upmixing mono audio to every output channel
+ * or downmixing to mono by averaging all channels if the channel counts
+ * differ.
+ */
+inline void
+copyAudioWithChannelConversion(const juce::AudioBuffer<float> &audio,
+                               float *outputPointer, int numChannels,
+                               long long outputStride) {
+  const int numFrames = static_cast<int>(
+      std::min<long long>(audio.getNumSamples(), outputStride));
+
+  for (int c = 0; c < numChannels; c++) {
+    float *outputChannel = outputPointer + (c * outputStride);
+
+    if (audio.getNumChannels() == numChannels) {
+      juce::FloatVectorOperations::copy(outputChannel, audio.getReadPointer(c),
+                                        numFrames);
+    } else if (audio.getNumChannels() == 1) {
+      juce::FloatVectorOperations::copy(outputChannel, audio.getReadPointer(0),
+                                        numFrames);
+    } else {
+      const float gain = 1.0f / audio.getNumChannels();
+      juce::FloatVectorOperations::copyWithMultiply(
+          outputChannel, audio.getReadPointer(0), gain, numFrames);
+      for (int i = 1; i < audio.getNumChannels(); i++) {
+        juce::FloatVectorOperations::addWithMultiply(
+            outputChannel, audio.getReadPointer(i), gain, numFrames);
+      }
+    }
+  }
+}
+
+/**
+ * Read up to numFrames frames of the provided audio file, resampled to the
+ * given sample rate, into a contiguous output array of shape [numChannels,
+ * numFrames], padding the rest of the array with silence.
+ *
+ * If the file has numChannels channels, it is decoded (and resampled)
+ * directly into the output array. Otherwise, it's decoded into a temporary
+ * buffer first, which is then up- or downmixed into the output array.
+ *
+ * @return the number of frames read from the file
+ */
+inline long long loadAudioFileInto(std::shared_ptr<ReadableAudioFile> file,
+                                   double sampleRate, int numChannels,
+                                   ResamplingQuality quality,
+                                   float *outputPointer, long long numFrames) {
+  if (file->getNumChannels() != numChannels) {
+    juce::AudioBuffer<float> audio =
+        loadAudioFile(file, sampleRate, quality, numFrames);
+    std::fill_n(outputPointer, numChannels * numFrames, 0.0f);
+    copyAudioWithChannelConversion(audio, outputPointer, numChannels,
+                                   numFrames);
+    return audio.getNumSamples();
+  }
+
+  std::vector<float *> channelPointers(numChannels);
+  for (int c = 0; c < numChannels; c++) {
+    channelPointers[c] = outputPointer + (c * numFrames);
+  }
+
+  if (file->getSampleRateAsDouble() == sampleRate) {
+    // This zeroes any frames past the end of the file itself:
+    return file->readIntoChannels(channelPointers.data(), numFrames);
+  }
+
+  ResampledReadableAudioFile resampledFile(file, sampleRate, quality);
+  long long framesRead =
+      resampledFile.readInternal(numFrames, channelPointers.data());
+  for (int c = 0; c < numChannels; c++) {
+    std::fill_n(channelPointers[c] + framesRead, numFrames - framesRead, 0.0f);
+  }
+  return framesRead;
+}
+
+/**
+ * Load many audio files at once on a pool of native threads, returning a
+ * tuple of (audio, lengths, errors) where audio is a float32 array of shape
+ * (len(paths), numChannels, numFrames). Files that fail to load are left as
+ * silence, with a length of 0 and an error message in errors.
+ */
+inline py::tuple loadMany(const std::vector<std::string> &paths,
+                          double sampleRate, int numChannels,
+                          std::optional<double> duration, int numThreads,
+                          ResamplingQuality quality) {
+  if (sampleRate <= 0)
+    throw std::domain_error("sample_rate must be greater than 0.");
+  if (numChannels < 1)
+    throw std::domain_error("num_channels must be at least 1.");
+  if (duration && *duration < 0)
+    throw std::domain_error("duration must not be negative.");
+
+  const size_t batchSize = paths.size();
+  std::optional<long long> maxFrames;
+  if (duration)
+    maxFrames = (long long)std::round(*duration * sampleRate);
+
+  std::vector<long long> lengths(batchSize, 0);
+  std::vector<std::optional<std::string>> errors(batchSize);
+
+  // If the duration is known up front, audio can be decoded straight into
+  // the output array. Otherwise, we need to hold onto the decoded audio until
+  // we know how long the longest file is.
+  std::vector<juce::AudioBuffer<float>> decodedAudio(maxFrames ? 0 : batchSize);
+  py::array_t<float> output;
+  if (maxFrames) {
+    output = py::array_t<float>(
+        {(long long)batchSize, (long long)numChannels, *maxFrames});
+  }
+
+  size_t numWorkers =
+      numThreads > 0 ? numThreads : ThreadPool::getDefaultNumThreads();
+  numWorkers = std::max<size_t>(1, std::min(numWorkers, batchSize));
+
+  auto copyIntoOutput = [&](float *outputPointer, long long numFrames,
+                            size_t itemIndex,
+                            const juce::AudioBuffer<float> *audio) {
+    float *itemPointer = outputPointer + (itemIndex * numChannels * numFrames);
+    std::fill_n(itemPointer, numChannels * numFrames, 0.0f);
+    if (audio)
+      copyAudioWithChannelConversion(*audio, itemPointer, numChannels,
+                                     numFrames);
+  };
+
+  {
+    float *outputPointer = maxFrames ? output.mutable_data() : nullptr;
+    py::gil_scoped_release release;
+
+    ThreadPool pool(numWorkers);
+    pool.parallelFor(batchSize, [&](size_t itemIndex, size_t) {
+      try {
+        auto file = openAudioFileForLoading(paths[itemIndex], numChannels);
+        if (maxFrames) {
+          lengths[itemIndex] = loadAudioFileInto(
+              file, sampleRate, numChannels, quality,
+              outputPointer + (itemIndex * numChannels * *maxFrames),
+              *maxFrames);
+        } else {
+          decodedAudio[itemIndex] =
+              loadAudioFile(file, sampleRate, quality, maxFrames);
+          lengths[itemIndex] = decodedAudio[itemIndex].getNumSamples();
+        }
+      } catch (const std::exception &e) {
+        errors[itemIndex] = e.what();
+        lengths[itemIndex] = 0;
+        if (maxFrames)
+          copyIntoOutput(outputPointer, *maxFrames, itemIndex, nullptr);
+      }
+    });
+  }
+
+  if (!maxFrames) {
+    long long numFrames = 0;
+    for (long long length : lengths)
+      numFrames = std::max(numFrames, length);
+
+    output = py::array_t<float>(
+        {(long long)batchSize, (long long)numChannels, numFrames});
+    float *outputPointer = output.mutable_data();
+
+    py::gil_scoped_release release;
+    ThreadPool pool(numWorkers);
+    pool.parallelFor(batchSize, [&](size_t itemIndex, size_t) {
+      copyIntoOutput(outputPointer, numFrames, itemIndex,
+                     errors[itemIndex] ? nullptr : &decodedAudio[itemIndex]);
+      decodedAudio[itemIndex] = juce::AudioBuffer<float>();
+    });
+  }
+
+  return py::make_tuple(
+      output, py::array_t<long long>(lengths.size(), lengths.data()),
+      py::cast(errors));
+}
+
+inline void init_load_many(py::module &m) {
+  m.def("load_many", &loadMany, py::arg("paths"), py::arg("sample_rate"),
+        py::arg("num_channels"), py::arg("duration") = py::none(),
+        py::arg("num_threads") = 0,
+        py::arg("quality") = ResamplingQuality::WindowedSinc32, R"(
+Load many audio files at once, decoding, resampling, and stacking them on a
+pool of native threads without holding the GIL.
+
+Returns a tuple of ``(audio, lengths, errors)``:
+
+ - ``audio`` is a ``float32`` :class:`numpy.array` of shape
+   ``(len(paths), num_channels, num_frames)``, where ``num_frames`` is
+   ``duration * sample_rate`` if ``duration`` is provided, or the length of
+   the longest file otherwise. Files shorter than ``num_frames`` are padded
+   with silence, and files longer than ``duration`` are cropped.
+ - ``lengths`` is an ``int64`` :class:`numpy.array` containing the number of
+   frames of audio (before padding) loaded from each file.
+ - ``errors`` is a list containing ``None`` for each file that was loaded
+   successfully, or an error message for each file that could not be loaded.
+   Files that could not be loaded are left as silence in ``audio`` with a
+   length of ``0``; no exception is raised.
+
+Each file is resampled to ``sample_rate`` (if necessary) with the given
+``quality``, exactly as :meth:`ReadableAudioFile.resampled_to` would.
+Mono files are copied to every output channel, and files are downmixed to mono
+(by averaging their channels) if ``num_channels`` is 1; other files with a
+different number of channels than ``num_channels`` produce an error.
+
+If ``num_threads`` is 0 (the default), one thread per CPU core will be used::
+
+    audio, lengths, errors = load_many(
+        ["clip_1.wav", "clip_2.mp3", "clip_3.flac"],
+        sample_rate=16000,
+        num_channels=1,
+        duration=2.5,
+    )
+    assert audio.shape == (3, 1, 40000)
+
+*Introduced in v0.9.22.*
+)");
+}
+
+} // namespace Pedalboard
@@ -0,0 +1,198 @@
+/*
+ * pedalboard
+ * Copyright 2025 Spotify AB
+ *
+ * Licensed under the GNU Public License, Version 3.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    https://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "../JuceHeader.h"
+#include "../ThreadPool.h"
+#include "../juce_overrides/juce_PatchedMP3AudioFormat.h"
+#include "AudioFile.h"
+
+namespace py = pybind11;
+
+namespace Pedalboard {
+
+/**
+ * The metadata of one audio file, as read from its headers.
+ */
+struct ProbeResult {
+  double sampleRate = 0;
+  long long numChannels = 0;
+  long long numFrames = 0;
+  bool exactDurationKnown = false;
+  std::optional<std::string> format;
+  std::optional<std::string> error;
+};
+
+/**
+ * Read the metadata of the audio file at the given path without decoding
+ * any of its audio. Creating a reader only parses the file's headers (i.e.:
+ * WAV and AIFF chunks, FLAC's STREAMINFO block, or MP3 Xing/VBRI headers);
+ * MP3 files without such a header report an estimated length.
+ *
+ * This function does not take or hold the GIL.
+ */
+inline ProbeResult probeAudioFile(juce::AudioFormatManager &formatManager,
+                                  const std::string &path) {
+  ProbeResult result;
+
+  juce::File file(path);
+  if (!file.existsAsFile()) {
+    result.error = "Failed to open audio file: file does not exist: " + path;
+    return result;
+  }
+
+  // createReaderFor(juce::File) is fast, as it only looks at file extension:
+  std::unique_ptr<juce::AudioFormatReader> reader(
+      formatManager.createReaderFor(file));
+  if (!reader) {
+    // This is slower but more thorough:
+    reader.reset(formatManager.createReaderFor(file.createInputStream()));
+  }
+
+  if (!reader) {
+    result.error = "Failed to open audio file: file \"" + path +
+                   "\" does not seem to contain audio data in a known or "
+                   "supported format.";
+    return result;
+  }
+
+  result.sampleRate = reader->sampleRate;
+  result.numChannels = reader->numChannels;
+  result.numFrames = reader->lengthInSamples;
+  result.format = reader->getFormatName().toStdString();
+  result.exactDurationKnown = true;
+  if (auto *positionAware =
+          dynamic_cast<juce::AudioFormatReaderWithPosition *>(reader.get())) {
+    result.exactDurationKnown = !positionAware->lengthIsApproximate();
+  }
+  return result;
+}
+
+/**
+ * Read the metadata of many audio files at once on a pool of native
+ * threads, returning a dictionary of columns (one entry per path in each).
+ * Files that can't be read have zeroes in each numeric column, None as their
+ * format, and an error message in the "errors" column.
+ */
+inline py::dict probe(const std::vector<std::string> &paths, int numThreads) {
+  if (numThreads < 0)
+    throw std::domain_error("num_threads must not be negative.");
+
+  const size_t batchSize = paths.size();
+  std::vector<ProbeResult> results(batchSize);
+
+  size_t numWorkers =
+      numThreads > 0 ? numThreads : ThreadPool::getDefaultNumThreads();
+  numWorkers = std::max<size_t>(1, std::min(numWorkers, batchSize));
+
+  {
+    py::gil_scoped_release release;
+
+    // Registering formats isn't free, so each worker keeps its own manager:
+    std::vector<std::unique_ptr<juce::AudioFormatManager>> formatManagers(
+        numWorkers);
+
+    ThreadPool pool(numWorkers);
+    pool.parallelFor(batchSize, [&](size_t itemIndex, size_t workerIndex) {
+      std::unique_ptr<juce::AudioFormatManager> &formatManager =
+          formatManagers[workerIndex];
+      if (!formatManager) {
+        formatManager = std::make_unique<juce::AudioFormatManager>();
+        registerPedalboardAudioFormats(*formatManager, false);
+      }
+
+      try {
+        results[itemIndex] = probeAudioFile(*formatManager, paths[itemIndex]);
+      } catch (const std::exception &e) {
+        results[itemIndex] = ProbeResult();
+        results[itemIndex].error = e.what();
+      }
+    });
+  }
+
+  py::array_t<double> sampleRates(batchSize);
+  py::array_t<long long> numChannels(batchSize);
+  py::array_t<long long> numFrames(batchSize);
+  py::array_t<bool> exactDurationKnown(batchSize);
+  std::vector<std::optional<std::string>> formats(batchSize);
+  std::vector<std::optional<std::string>> errors(batchSize);
+
+  double *sampleRatePointer = sampleRates.mutable_data();
+  long long *numChannelsPointer = numChannels.mutable_data();
+  long long *numFramesPointer = numFrames.mutable_data();
+  bool *exactDurationKnownPointer = exactDurationKnown.mutable_data();
+  for (size_t i = 0; i < batchSize; i++) {
+    sampleRatePointer[i] = results[i].sampleRate;
+    numChannelsPointer[i] = results[i].numChannels;
+    numFramesPointer[i] = results[i].numFrames;
+    exactDurationKnownPointer[i] = results[i].exactDurationKnown;
+    formats[i] = results[i].format;
+    errors[i] = results[i].error;
+  }
+
+  py::dict columns;
+  columns["samplerate"] = sampleRates;
+  columns["num_channels"] = numChannels;
+  columns["frames"] = numFrames;
+  columns["exact_duration_known"] = exactDurationKnown;
+  columns["format"] = py::cast(formats);
+  columns["errors"] = py::cast(errors);
+  return columns;
+}
+
+inline void init_probe(py::module &m) {
+  m.def("probe", &probe, py::arg("paths"), py::arg("num_threads") = 0, R"(
+Read the sample rate, channel count, and length of many audio files at once
+from their headers, without decoding any audio, on a pool of native threads
+without holding the GIL. This is much faster than opening each file with
+:class:`AudioFile` when indexing large collections of audio files.
+
+Returns a dictionary of columns, each with one entry per path:
+
+ - ``"samplerate"``: a ``float64`` :class:`numpy.array` of sample rates.
+ - ``"num_channels"``: an ``int64`` :class:`numpy.array` of channel counts.
+ - ``"frames"``: an ``int64`` :class:`numpy.array` of lengths, in frames.
+ - ``"exact_duration_known"``: a ``bool`` :class:`numpy.array` that is
+   :py:const:`False` for files whose length is an estimate based on the
+   file's size and bitrate. (See :py:attr:`ReadableAudioFile.exact_duration_known`.)
+ - ``"format"``: a list of the names of each file's format (i.e.:
+   ``"WAV file"`` or ``"MP3 file"``).
+ - ``"errors"``: a list containing ``None`` for each file that was probed
+   successfully, or an error message for each file that could not be read.
+   Files that could not be read have values of ``0`` (or :py:const:`False` or
+   ``None``) in every other column; no exception is raised.
+
+If ``num_threads`` is 0 (the default), one thread per CPU core will be used::
+
+    info = probe(["clip_1.wav", "clip_2.mp3", "clip_3.flac"])
+    durations = info["frames"] / info["samplerate"]
+
+*Introduced in v0.9.22.*
+)");
+}
+
+} // namespace Pedalboard
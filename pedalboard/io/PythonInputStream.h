@@ -17,8 +17,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <mutex>
 #include <optional>
+#include <vector>
 
 namespace py = pybind11;
 
@@ -55,13 +57,40 @@ std::optional<py::buffer> tryConvertingToBuffer(py::object bufferLike) {
 /**
  * A juce::InputStream subclass that fetches its
  * data from a provided Python file-like object.
+ *
+ * If bufferSize is greater than zero, data is read from the file-like object
+ * in blocks of bufferSize bytes, and reads that can be served from the most
+ * recently read block don't touch Python (or the GIL) at all. Seeking only
+ * moves this stream's position; the file-like object itself is only sought
+ * when the next block needs to be read. (This means that the position of the
+ * file-like object may not match the position of this stream, and that
+ * exceptions thrown by the file-like object may only be raised once the
+ * buffered data has been consumed.)
  */
 class PythonInputStream : public juce::InputStream, public PythonFileLike {
 public:
-  PythonInputStream(py::object fileLike) : PythonFileLike(fileLike) {}
+  PythonInputStream(py::object fileLike, int bufferSize = 0)
+      : PythonFileLike(fileLike) {
+    if (bufferSize < 0) {
+      throw std::domain_error(
+          "buffer_size must be greater than or equal to 0, but was " +
+          std::to_string(bufferSize) + ".");
+    }
+    readBuffer.resize(bufferSize);
+  }
   virtual ~PythonInputStream() {}
 
+  /**
+   * The size of the read-ahead buffer used by this stream, in bytes,
+   * or 0 if every read is passed directly to the file-like object.
+   */
+  int getBufferSize() const { return (int)readBuffer.size(); }
+
   juce::int64 getTotalLength() noexcept override {
+    // Buffered streams avoid calling into Python once the length is known:
+    if (isBuffered() && totalLength != -1)
+      return totalLength;
+
     ScopedDowngradeToReadLockWithGIL lock(objectLock);
     ClearErrnoBeforeReturn clearErrnoBeforeReturn;
     py::gil_scoped_acquire acquire;
@@ -86,9 +115,11 @@ public:
       }
     } catch (py::error_already_set e) {
       e.restore();
+      fileLikePosition = -1;
       return -1;
     } catch (const py::builtin_exception &e) {
       e.set_error();
+      fileLikePosition = -1;
       return -1;
     }
 
@@ -99,6 +130,10 @@ public:
     // The buffer should never be null, and a negative size is probably a
     // sign that something is broken!
     jassert(buffer != nullptr && bytesToRead >= 0);
+
+    if (isBuffered())
+      return readBuffered((char *)buffer, bytesToRead);
+
     ScopedDowngradeToReadLockWithGIL lock(objectLock);
     ClearErrnoBeforeReturn clearErrnoBeforeReturn;
 
@@ -106,59 +141,23 @@ public:
     if (PythonException::isPending())
       return 0;
 
-    try {
-      auto readResult = fileLike.attr("read")(bytesToRead);
-
-      if (!py::isinstance<py::bytes>(readResult)) {
-        std::string message =
-            "File-like object passed to AudioFile was expected to return "
-            "bytes from its read(...) method, but "
-            "returned " +
-            py::str(readResult.get_type().attr("__name__"))
-                .cast<std::string>() +
-            ".";
-
-        if (py::hasattr(fileLike, "mode") &&
-            py::str(fileLike.attr("mode")).cast<std::string>() == "r") {
-          message += " (Try opening the stream in \"rb\" mode instead of "
-                     "\"r\" mode if possible.)";
-        }
-
-        throw py::type_error(message);
-        return 0;
-      }
-
-      py::bytes bytesObject = readResult.cast<py::bytes>();
-      char *pythonBuffer = nullptr;
-      py::ssize_t pythonLength = 0;
-
-      if (PYBIND11_BYTES_AS_STRING_AND_SIZE(bytesObject.ptr(), &pythonBuffer,
-                                            &pythonLength)) {
-        throw py::buffer_error(
-            "Internal error: failed to read bytes from bytes object!");
-      }
+    int bytesRead = readFromFileLike(buffer, bytesToRead);
+    if (bytesRead < 0)
+      return 0;
 
-      if (!buffer && pythonLength > 0) {
-        throw py::buffer_error("Internal error: bytes pointer is null, but a "
-                               "non-zero number of bytes were returned!");
-      }
+    lastReadWasSmallerThanExpected = bytesToRead > bytesRead;
+    return bytesRead;
+  }
 
-      if (buffer && pythonLength) {
-        std::memcpy(buffer, pythonBuffer, pythonLength);
-      }
+  bool isExhausted() noexcept override {
+    if (isBuffered()) {
+      if (lastReadWasSmallerThanExpected)
+        return true;
 
-      lastReadWasSmallerThanExpected = bytesToRead > pythonLength;
-      return pythonLength;
-    } catch (py::error_already_set e) {
-      e.restore();
-      return 0;
-    } catch (const py::builtin_exception &e) {
-      e.set_error();
-      return 0;
+      juce::int64 totalLength = getTotalLength();
+      return getPosition() == totalLength;
     }
-  }
 
-  bool isExhausted() noexcept override {
     // Read this up front to avoid releasing the object lock recursively:
     juce::int64 totalLength = getTotalLength();
 
@@ -185,6 +184,9 @@ public:
   }
 
   juce::int64 getPosition() noexcept override {
+    if (isBuffered() && position != -1)
+      return position;
+
     ScopedDowngradeToReadLockWithGIL lock(objectLock);
     ClearErrnoBeforeReturn clearErrnoBeforeReturn;
     py::gil_scoped_acquire acquire;
@@ -193,7 +195,12 @@ public:
       return -1;
 
     try {
-      return fileLike.attr("tell")().cast<juce::int64>();
+      juce::int64 pos = fileLike.attr("tell")().cast<juce::int64>();
+      if (isBuffered()) {
+        position = pos;
+        fileLikePosition = pos;
+      }
+      return pos;
     } catch (py::error_already_set e) {
       e.restore();
       return -1;
@@ -204,6 +211,16 @@ public:
   }
 
   bool setPosition(juce::int64 pos) noexcept override {
+    if (isBuffered()) {
+      // The file-like object will be sought before the next block is read:
+      if (pos < 0)
+        return false;
+
+      position = pos;
+      lastReadWasSmallerThanExpected = false;
+      return true;
+    }
+
     ScopedDowngradeToReadLockWithGIL lock(objectLock);
     ClearErrnoBeforeReturn clearErrnoBeforeReturn;
     py::gil_scoped_acquire acquire;
@@ -228,8 +245,159 @@ public:
   }
 
 private:
+  bool isBuffered() const { return !readBuffer.empty(); }
+
+  /**
+   * Call the file-like object's read method once, copying up to bytesToRead
+   * bytes into the provided buffer. Must be called with the GIL held.
+   * Returns the number of bytes read, or -1 if a Python exception was raised
+   * (in which case that exception will be left pending).
+   */
+  int readFromFileLike(void *buffer, int bytesToRead) {
+    try {
+      auto readResult = fileLike.attr("read")(bytesToRead);
+
+      if (!py::isinstance<py::bytes>(readResult)) {
+        std::string message =
+            "File-like object passed to AudioFile was expected to return "
+            "bytes from its read(...) method, but "
+            "returned " +
+            py::str(readResult.get_type().attr("__name__"))
+                .cast<std::string>() +
+            ".";
+
+        if (py::hasattr(fileLike, "mode") &&
+            py::str(fileLike.attr("mode")).cast<std::string>() == "r") {
+          message += " (Try opening the stream in \"rb\" mode instead of "
+                     "\"r\" mode if possible.)";
+        }
+
+        throw py::type_error(message);
+      }
+
+      py::bytes bytesObject = readResult.cast<py::bytes>();
+      char *pythonBuffer = nullptr;
+      py::ssize_t pythonLength = 0;
+
+      if (PYBIND11_BYTES_AS_STRING_AND_SIZE(bytesObject.ptr(), &pythonBuffer,
+                                            &pythonLength)) {
+        throw py::buffer_error(
+            "Internal error: failed to read bytes from bytes object!");
+      }
+
+      if (!buffer && pythonLength > 0) {
+        throw py::buffer_error("Internal error: bytes pointer is null, but a "
+                               "non-zero number of bytes were returned!");
+      }
+
+      // Never trust a file-like object to return no more than we asked for:
+      pythonLength = std::min<py::ssize_t>(pythonLength, bytesToRead);
+
+      if (buffer && pythonLength) {
+        std::memcpy(buffer, pythonBuffer, pythonLength);
+      }
+
+      return (int)pythonLength;
+    } catch (py::error_already_set e) {
+      e.restore();
+      return -1;
+    } catch (const py::builtin_exception &e) {
+      e.set_error();
+      return -1;
+    }
+  }
+
+  /**
+   * Read bytesToRead bytes from the given offset in the file-like object,
+   * seeking it first only if it's not already at that offset.
+   */
+  int readFromFileLikeAt(char *buffer, int bytesToRead, juce::int64 offset) {
+    ScopedDowngradeToReadLockWithGIL lock(objectLock);
+    ClearErrnoBeforeReturn clearErrnoBeforeReturn;
+    py::gil_scoped_acquire acquire;
+
+    if (PythonException::isPending())
+      return -1;
+
+    if (fileLikePosition != offset) {
+      try {
+        fileLike.attr("seek")(offset);
+      } catch (py::error_already_set e) {
+        e.restore();
+        fileLikePosition = -1;
+        return -1;
+      } catch (const py::builtin_exception &e) {
+        e.set_error();
+        fileLikePosition = -1;
+        return -1;
+      }
+    }
+
+    int bytesRead = readFromFileLike(buffer, bytesToRead);
+    fileLikePosition = bytesRead < 0 ? -1 : offset + bytesRead;
+    return bytesRead;
+  }
+
+  int readBuffered(char *buffer, int bytesToRead) {
+    if (position == -1 && getPosition() == -1)
+      return 0;
+
+    int bytesRead = 0;
+    bool reachedEndOfFileLike = false;
+    while (bytesRead < bytesToRead) {
+      juce::int64 bufferEnd = bufferStart + bufferedBytes;
+      if (position >= bufferStart && position < bufferEnd) {
+        int bytesToCopy = (int)std::min<juce::int64>(bufferEnd - position,
+                                                     bytesToRead - bytesRead);
+        std::memcpy(buffer + bytesRead,
+                    readBuffer.data() + (position - bufferStart),
+                    bytesToCopy);
+        bytesRead += bytesToCopy;
+        position += bytesToCopy;
+        continue;
+      }
+
+      if (reachedEndOfFileLike)
+        break;
+
+      int bytesRemaining = bytesToRead - bytesRead;
+      if (bytesRemaining >= getBufferSize()) {
+        // Reads larger than the buffer bypass it entirely:
+        int result =
+            readFromFileLikeAt(buffer + bytesRead, bytesRemaining, position);
+        if (result <= 0)
+          break;
+
+        bytesRead += result;
+        position += result;
+        reachedEndOfFileLike = result < bytesRemaining;
+      } else {
+        int result =
+            readFromFileLikeAt(readBuffer.data(), getBufferSize(), position);
+        bufferStart = position;
+        bufferedBytes = std::max(0, result);
+        if (result <= 0)
+          break;
+
+        reachedEndOfFileLike = result < getBufferSize();
+      }
+    }
+
+    lastReadWasSmallerThanExpected = bytesRead < bytesToRead;
+    return bytesRead;
+  }
+
   juce::int64 totalLength = -1;
   bool lastReadWasSmallerThanExpected = false;
+
+  // Only used if this stream is buffered:
+  std::vector<char> readBuffer;
+  juce::int64 bufferStart = 0;
+  int bufferedBytes = 0;
+  // This stream's position, or -1 if not yet known:
+  juce::int64 position = -1;
+  // The position of the file-like object, or -1 if not known:
+  juce::int64 fileLikePosition = -1;
 };
 
 /**
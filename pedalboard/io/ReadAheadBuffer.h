@@ -0,0 +1,189 @@
+/*
+ * pedalboard
+ * Copyright 2025 Spotify AB
+ *
+ * Licensed under the GNU Public License, Version 3.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    https://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Pedalboard {
+
+/**
+ * Decodes audio on a background thread into a bounded ring of fixed-size
+ * chunks, allowing a reader to copy already-decoded audio out of memory
+ * while the next chunks are being decoded.
+ *
+ * The decode function is only ever called from the background thread. It is
+ * passed one pointer per channel, each with room for the requested number of
+ * frames, and must return the number of frames it decoded. Returning fewer
+ * frames than requested marks the end of the stream, after which the
+ * background thread exits. Any exception thrown by the decode function is
+ * re-thrown by read() once all of the audio decoded before it has been read.
+ */
+class ReadAheadBuffer {
+public:
+  using DecodeFunction =
+      std::function<long long(float **channelPointers, long long numFrames)>;
+
+  ReadAheadBuffer(size_t numChunks, long long numChannels,
+                  long long framesPerChunk, DecodeFunction decode)
+      : numChannels(numChannels), framesPerChunk(framesPerChunk),
+        decode(decode), chunks(std::max<size_t>(1, numChunks)) {
+    for (Chunk &chunk : chunks) {
+      chunk.samples.resize(numChannels * framesPerChunk);
+    }
+    thread = std::thread(&ReadAheadBuffer::decodeLoop, this);
+  }
+
+  ~ReadAheadBuffer() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopRequested = true;
+    }
+    condition.notify_all();
+    thread.join();
+  }
+
+  ReadAheadBuffer(const ReadAheadBuffer &) = delete;
+  ReadAheadBuffer &operator=(const ReadAheadBuffer &) = delete;
+
+  /**
+   * Copy up to numFrames frames into the provided output channels (one
+   * pointer per channel, any of which may be null to skip that channel),
+   * blocking until enough audio has been decoded. Fewer than numFrames frames
+   * will only be returned if the end of the stream was reached.
+   *
+   * @return the number of frames copied into the output channels
+   */
+  long long read(float *const *outputChannels, long long numFrames) {
+    long long framesCopied = 0;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (framesCopied < numFrames) {
+      condition.wait(lock, [this] { return numFilled > 0 || finished; });
+
+      if (numFilled == 0) {
+        if (error)
+          std::rethrow_exception(error);
+        break;
+      }
+
+      Chunk &chunk = chunks[readIndex];
+      long long framesToCopy =
+          std::min(numFrames - framesCopied, chunk.numFrames - readOffset);
+      for (long long c = 0; c < numChannels; c++) {
+        if (!outputChannels[c])
+          continue;
+        std::copy_n(chunk.samples.data() + (c * framesPerChunk) + readOffset,
+                    framesToCopy, outputChannels[c] + framesCopied);
+      }
+      framesCopied += framesToCopy;
+      readOffset += framesToCopy;
+
+      if (readOffset == chunk.numFrames) {
+        readOffset = 0;
+        readIndex = (readIndex + 1) % chunks.size();
+        numFilled--;
+        condition.notify_all();
+      }
+    }
+
+    return framesCopied;
+  }
+
+  /**
+   * Returns true if the decode function has reached the end of the stream
+   * and all of the audio it decoded has been read.
+   */
+  bool isExhausted() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return finished && !error && numFilled == 0;
+  }
+
+private:
+  struct Chunk {
+    std::vector<float> samples;
+    long long numFrames = 0;
+  };
+
+  void decodeLoop() {
+    std::vector<float *> channelPointers(numChannels);
+
+    while (true) {
+      size_t writeIndex;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this] {
+          return stopRequested || numFilled < chunks.size();
+        });
+        if (stopRequested)
+          return;
+        writeIndex = (readIndex + numFilled) % chunks.size();
+      }
+
+      // The reader never touches a chunk until it's been marked as filled,
+      // so we can decode into it without holding the lock:
+      Chunk &chunk = chunks[writeIndex];
+      for (long long c = 0; c < numChannels; c++) {
+        channelPointers[c] = chunk.samples.data() + (c * framesPerChunk);
+      }
+
+      long long framesDecoded = 0;
+      std::exception_ptr decodeError;
+      try {
+        framesDecoded = decode(channelPointers.data(), framesPerChunk);
+      } catch (...) {
+        decodeError = std::current_exception();
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        chunk.numFrames = framesDecoded;
+        if (framesDecoded > 0)
+          numFilled++;
+        error = decodeError;
+        finished = decodeError || framesDecoded < framesPerChunk;
+      }
+      condition.notify_all();
+
+      if (finished)
+        return;
+    }
+  }
+
+  const long long numChannels;
+  const long long framesPerChunk;
+  const DecodeFunction decode;
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::vector<Chunk> chunks;
+  size_t readIndex = 0;
+  size_t numFilled = 0;
+  long long readOffset = 0;
+  bool finished = false;
+  bool stopRequested = false;
+  std::exception_ptr error;
+  std::thread thread;
+};
+
+} // namespace Pedalboard
@@ -17,7 +17,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <mutex>
+#include <numeric>
 #include <optional>
 
 #include <pybind11/numpy.h>
@@ -25,9 +27,11 @@
 
 #include "../BufferUtils.h"
 #include "../JuceHeader.h"
+#include "../ThreadPool.h"
 #include "../juce_overrides/juce_PatchedMP3AudioFormat.h"
 #include "AudioFile.h"
 #include "PythonInputStream.h"
+#include "ReadAheadBuffer.h"
 
 namespace py = pybind11;
 
@@ -56,11 +60,59 @@ inline long long parseNumSamples(std::variant<double, long long> numSamples) {
   }
 }
 
+/**
+ * Check that the provided NumPy array can be decoded into by read_into: it
+ * must be a writeable, C-contiguous array of shape [numChannels, numFrames],
+ * and the given frame offset must fall within it.
+ *
+ * @return the number of frames after offset to decode into
+ */
+inline long long checkReadIntoArray(py::array out, long long numChannels,
+                                    long long offset) {
+  if (out.ndim() != 2 || out.shape(0) != numChannels) {
+    throw std::domain_error(
+        "The provided output array must have shape (num_channels, "
+        "num_frames) with " +
+        std::to_string(numChannels) + " channels, but has shape " +
+        py::str(out.attr("shape")).cast<std::string>() + ".");
+  }
+
+  if (!(out.flags() & py::array::c_style)) {
+    throw std::domain_error(
+        "The provided output array must be C-contiguous. (Try passing "
+        "numpy.ascontiguousarray(...) instead.)");
+  }
+
+  if (!out.writeable()) {
+    throw std::domain_error("The provided output array is not writeable.");
+  }
+
+  if (!out.dtype().attr("isnative").cast<bool>()) {
+    throw std::domain_error(
+        "The provided output array must use the native byte order.");
+  }
+
+  if (offset < 0 || offset > out.shape(1)) {
+    throw std::domain_error(
+        "The provided offset (" + std::to_string(offset) +
+        ") must be between 0 and the number of frames in the output array (" +
+        std::to_string(out.shape(1)) + ").");
+  }
+
+  return out.shape(1) - offset;
+}
+
 class ReadableAudioFile
     : public AudioFile,
       public std::enable_shared_from_this<ReadableAudioFile> {
 public:
-  ReadableAudioFile(std::string filename) : filename(filename) {
+  ReadableAudioFile(std::string filename, int prefetch = 0)
+      : filename(filename), prefetch(prefetch) {
+    if (prefetch < 0)
+      throw std::domain_error("prefetch must be greater than or equal to "
+                              "zero, but was " +
+                              std::to_string(prefetch) + ".");
+
     registerPedalboardAudioFormats(formatManager, false);
     // This is kind of silly, as nobody else has a reference
     // to this object yet; but it prevents some juce assertions in debug builds:
@@ -174,6 +226,8 @@ public:
     cacheMetadata();
   }
 
+  ~ReadableAudioFile() { stopPrefetching(); }
+
   void cacheMetadata() {
     sampleRate = reader->sampleRate;
     numChannels = reader->numChannels;
@@ -249,9 +303,20 @@ public:
   std::string getFileDatatype() const { return fileDatatype; }
 
   py::array_t<float, py::array::c_style>
-  read(std::variant<double, long long> numSamplesVariant) {
+  read(std::variant<double, long long> numSamplesVariant, int numThreads = 1,
+       std::optional<std::vector<int>> channels = {},
+       std::optional<std::string> downmix = {}) {
     long long numSamples = parseNumSamples(numSamplesVariant);
 
+    if (downmix && *downmix != "mono")
+      throw std::domain_error("downmix must be either None or \"mono\", but "
+                              "was \"" +
+                              *downmix + "\".");
+
+    if (numThreads < 1)
+      throw std::domain_error("num_threads must be at least 1, but was " +
+                              std::to_string(numThreads) + ".");
+
     if (numSamples == 0)
       throw std::domain_error(
           "ReadableAudioFile will not read an entire file at once, due to the "
@@ -265,8 +330,24 @@ public:
     if (!reader)
       throw std::runtime_error("I/O operation on a closed file.");
 
+    const long long numFileChannels = reader->numChannels;
+    if (channels) {
+      if (channels->empty())
+        throw std::domain_error("channels must contain at least one channel.");
+
+      for (int channel : *channels) {
+        if (channel < 0 || channel >= numFileChannels) {
+          throw std::domain_error(
+              "Cannot read channel " + std::to_string(channel) +
+              ", as this file only has " + std::to_string(numFileChannels) +
+              " channel" + (numFileChannels == 1 ? "" : "s") + ".");
+        }
+      }
+    }
+
     // Allocate a buffer to return of up to numSamples:
-    long long numChannels = reader->numChannels;
+    long long numChannels =
+        downmix ? 1 : (channels ? channels->size() : numFileChannels);
     numSamples =
         std::min(numSamples, (reader->lengthInSamples +
                               (lengthCorrection ? *lengthCorrection : 0)) -
@@ -283,7 +364,16 @@ public:
 
     {
       py::gil_scoped_release release;
-      numSamplesToKeep = readInternal(numChannels, numSamples, outputPtr);
+      if (downmix) {
+        numSamplesToKeep = readDownmixed(channels, numSamples, outputPtr,
+                                         numThreads);
+      } else if (channels) {
+        numSamplesToKeep =
+            readChannels(*channels, numSamples, outputPtr, numThreads);
+      } else {
+        numSamplesToKeep =
+            readInternal(numChannels, numSamples, outputPtr, numThreads);
+      }
 
       // After this point, we no longer need to hold the read lock as we don't
       // interact with the reader object anymore. Releasing this early (before
@@ -299,6 +389,323 @@ public:
     return buffer;
   }
 
+  long long readInto(py::array out, long long offset, int numThreads = 1) {
+    if (numThreads < 1)
+      throw std::domain_error("num_threads must be at least 1, but was " +
+                              std::to_string(numThreads) + ".");
+
+    std::optional<juce::ScopedReadLock> scopedLock =
+        std::optional<juce::ScopedReadLock>(objectLock);
+
+    if (!reader)
+      throw std::runtime_error("I/O operation on a closed file.");
+
+    const long long numChannels = reader->numChannels;
+    const long long numFramesToFill =
+        checkReadIntoArray(out, numChannels, offset);
+    const long long numFrames = out.shape(1);
+    const long long numSamples =
+        std::min(numFramesToFill, (reader->lengthInSamples +
+                                   (lengthCorrection ? *lengthCorrection : 0)) -
+                                      currentPosition);
+
+    // Check the output array's dtype before writing anything into it:
+    const py::dtype dtype = out.dtype();
+    if (dtype.kind() == 'i') {
+      if (reader->usesFloatingPointData) {
+        throw py::type_error(
+            "This file contains floating-point audio, which can only be read "
+            "into a float32 array.");
+      }
+
+      if (dtype.itemsize() != 1 && dtype.itemsize() != 2 &&
+          dtype.itemsize() != 4) {
+        throw py::type_error("Cannot read audio into an array of dtype " +
+                             py::str(dtype).cast<std::string>() + ".");
+      }
+
+      const int bitsPerSample = reader->bitsPerSample;
+      if ((bitsPerSample != 8 && bitsPerSample != 16 && bitsPerSample != 32) ||
+          dtype.itemsize() * 8 < bitsPerSample) {
+        throw py::type_error(
+            "This file contains " + std::to_string(bitsPerSample) +
+            "-bit integer audio, which cannot be read into an array of dtype " +
+            py::str(dtype).cast<std::string>() + ".");
+      }
+    } else if (dtype.kind() != 'f' || dtype.itemsize() != 4) {
+      throw py::type_error(
+          "Audio can only be read into a float32 or integer array, but the "
+          "provided output array has dtype " +
+          py::str(dtype).cast<std::string>() + ".");
+    }
+
+    if (dtype.kind() == 'i') {
+      // readIntegerInto only writes the frames it reads, so zero the rest:
+      char *outputPointer = (char *)out.mutable_data();
+      const long long rowSize = numFrames * dtype.itemsize();
+      for (long long c = 0; c < numChannels; c++) {
+        std::memset(outputPointer + (c * rowSize) +
+                        ((offset + numSamples) * dtype.itemsize()),
+                    0, (numFramesToFill - numSamples) * dtype.itemsize());
+      }
+
+      switch (dtype.itemsize()) {
+      case 4:
+        readIntegerInto((int *)out.mutable_data() + offset, numSamples,
+                        numFrames);
+        break;
+      case 2:
+        readIntegerInto((short *)out.mutable_data() + offset, numSamples,
+                        numFrames);
+        break;
+      case 1:
+        readIntegerInto((char *)out.mutable_data() + offset, numSamples,
+                        numFrames);
+        break;
+      }
+      return numSamples;
+    }
+
+    float *outputPointer = (float *)out.mutable_data() + offset;
+    long long numSamplesRead;
+    {
+      py::gil_scoped_release release;
+      numSamplesRead = readInternal(numChannels, numFramesToFill,
+                                    outputPointer, numThreads, numFrames);
+      scopedLock.reset();
+    }
+
+    PythonException::raise();
+    return numSamplesRead;
+  }
+
+  /**
+   * Read numSamples frames of only the given channels (in the given order)
+   * into a contiguous output array of shape [channels.size(), numSamples].
+   * Channels that aren't requested are not copied or converted. This method
+   * does not take or hold the GIL.
+   *
+   * @return the number of samples that were actually read from the file
+   */
+  long long readChannels(const std::vector<int> &channels,
+                         long long numSamples, float *outputPointer,
+                         int numThreads = 1) {
+    std::vector<float *> channelPointers(reader->numChannels, nullptr);
+    for (size_t i = 0; i < channels.size(); i++) {
+      if (!channelPointers[channels[i]])
+        channelPointers[channels[i]] = outputPointer + (i * numSamples);
+    }
+
+    long long numSamplesRead =
+        readIntoChannels(channelPointers.data(), numSamples, numThreads);
+
+    // Channels requested more than once are only decoded once:
+    for (size_t i = 0; i < channels.size(); i++) {
+      float *output = outputPointer + (i * numSamples);
+      if (channelPointers[channels[i]] != output)
+        std::copy_n(channelPointers[channels[i]], numSamples, output);
+    }
+
+    return numSamplesRead;
+  }
+
+  /**
+   * Read numSamples frames from the given channels (or all channels) and
+   * write their average into the provided output array. Audio is decoded
+   * into a small scratch buffer one block at a time and accumulated into the
+   * output, so memory use doesn't grow with the number of channels. This
+   * method does not take or hold the GIL.
+   *
+   * @return the number of samples that were actually read from the file
+   */
+  long long readDownmixed(const std::optional<std::vector<int>> &channels,
+                          long long numSamples, float *outputPointer,
+                          int numThreads = 1) {
+    const long long numFileChannels = reader->numChannels;
+
+    // The number of times each channel contributes to the mix:
+    std::vector<int> weights(numFileChannels, channels ? 0 : 1);
+    if (channels) {
+      for (int channel : *channels)
+        weights[channel]++;
+    }
+    const float scale =
+        1.0f / (channels ? channels->size() : (size_t)numFileChannels);
+
+    // Blocks must be large enough to be worth decoding in parallel:
+    const long long blockSize =
+        numThreads > 1 ? MIN_FRAMES_PER_DECODING_THREAD * numThreads
+                       : (long long)DEFAULT_AUDIO_BUFFER_SIZE_FRAMES;
+    const long long framesPerBlock = std::min(numSamples, blockSize);
+
+    long long numChannelsToDecode = 0;
+    for (int weight : weights)
+      numChannelsToDecode += weight > 0;
+
+    std::vector<float> scratch(numChannelsToDecode * framesPerBlock);
+    std::vector<float *> channelPointers(numFileChannels, nullptr);
+    for (long long c = 0, i = 0; c < numFileChannels; c++) {
+      if (weights[c])
+        channelPointers[c] = scratch.data() + (i++ * framesPerBlock);
+    }
+
+    std::fill_n(outputPointer, numSamples, 0.0f);
+
+    long long framesRead = 0;
+    while (framesRead < numSamples) {
+      long long framesToRead =
+          std::min(framesPerBlock, numSamples - framesRead);
+      long long framesDecoded =
+          readIntoChannels(channelPointers.data(), framesToRead, numThreads);
+
+      for (long long c = 0; c < numFileChannels; c++) {
+        if (weights[c]) {
+          juce::FloatVectorOperations::addWithMultiply(
+              outputPointer + framesRead, channelPointers[c],
+              scale * weights[c], (int)framesDecoded);
+        }
+      }
+
+      framesRead += framesDecoded;
+      if (framesDecoded < framesToRead)
+        break;
+    }
+
+    return framesRead;
+  }
+
+  py::array_t<float, py::array::c_style>
+  readWindows(std::vector<long long> offsets, long long length) {
+    if (length < 1)
+      throw std::domain_error("length must be at least 1, but was " +
+                              std::to_string(length) + ".");
+
+    long long numChannels;
+    {
+      const juce::ScopedReadLock scopedLock(objectLock);
+      if (!reader)
+        throw std::runtime_error("I/O operation on a closed file.");
+      numChannels = reader->numChannels;
+    }
+
+    py::array_t<float, py::array::c_style> output(
+        {(long long)offsets.size(), numChannels, length});
+    float *outputPointer = output.mutable_data();
+
+    {
+      py::gil_scoped_release release;
+      readWindowsInternal(offsets, length, outputPointer);
+    }
+
+    PythonException::raise();
+    return output;
+  }
+
+  /**
+   * Read one window of `length` frames starting at each of the given offsets
+   * into a contiguous output array of shape [offsets.size(), numChannels,
+   * length], zero-padding any windows that extend past the end of the file.
+   *
+   * Windows are read in order of their offsets (rather than in the order
+   * provided) to avoid seeking backwards, and audio shared by overlapping
+   * windows is only decoded once. The read position of the file is left
+   * unchanged. This method does not take or hold the GIL.
+   */
+  void readWindowsInternal(const std::vector<long long> &offsets,
+                           long long length, float *outputPointer) {
+    ScopedTryWriteLock scopedTryWriteLock(objectLock);
+    if (!scopedTryWriteLock.isLocked()) {
+      throw std::runtime_error(
+          "Another thread is currently reading from this AudioFile. Note "
+          "that using multiple concurrent readers on the same AudioFile "
+          "object will produce nondeterministic results.");
+    }
+
+    if (!reader)
+      throw std::runtime_error("I/O operation on a closed file.");
+
+    const long long numChannels = reader->numChannels;
+    const long long endOfFile =
+        reader->lengthInSamples + (lengthCorrection ? *lengthCorrection : 0);
+
+    for (long long offset : offsets) {
+      if (offset < 0 || offset > endOfFile) {
+        throw std::domain_error(
+            "Cannot read a window starting at position " +
+            std::to_string(offset) + ", which is outside of the file (" +
+            std::to_string(endOfFile) + " frames long).");
+      }
+    }
+
+    std::vector<size_t> order(offsets.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return offsets[a] < offsets[b];
+    });
+
+    const long long originalPosition = currentPosition;
+    std::vector<float> scratch;
+
+    const float *previousWindow = nullptr;
+    long long previousOffset = 0;
+    long long previousFramesRead = 0;
+
+    for (size_t index : order) {
+      float *window = outputPointer + (index * numChannels * length);
+      const long long offset = offsets[index];
+      std::fill_n(window, numChannels * length, 0.0f);
+
+      // If this window overlaps the previous one, copy the audio we've
+      // already decoded instead of seeking backwards to decode it again:
+      long long framesRead = 0;
+      if (previousWindow && offset < previousOffset + previousFramesRead) {
+        framesRead =
+            std::min(length, previousOffset + previousFramesRead - offset);
+        for (long long c = 0; c < numChannels; c++) {
+          std::copy_n(previousWindow + (c * length) + (offset - previousOffset),
+                      framesRead, window + (c * length));
+        }
+      }
+
+      const long long readStart = offset + framesRead;
+      const long long framesToRead = std::min(
+          length - framesRead,
+          reader->lengthInSamples +
+              (lengthCorrection ? *lengthCorrection : 0) - readStart);
+
+      if (framesToRead > 0) {
+        if (readStart != currentPosition) {
+          stopPrefetching();
+          currentPosition = readStart;
+        }
+
+        if (framesToRead == length) {
+          framesRead = readInternal(numChannels, framesToRead, window);
+        } else {
+          // readInternal produces a contiguous [numChannels, framesToRead]
+          // array, which needs to be copied into the window's tail:
+          scratch.resize(numChannels * framesToRead);
+          long long framesDecoded =
+              readInternal(numChannels, framesToRead, scratch.data());
+          for (long long c = 0; c < numChannels; c++) {
+            std::copy_n(scratch.data() + (c * framesToRead), framesDecoded,
+                        window + (c * length) + framesRead);
+          }
+          framesRead += framesDecoded;
+        }
+      }
+
+      previousWindow = window;
+      previousOffset = offset;
+      previousFramesRead = framesRead;
+    }
+
+    if (currentPosition != originalPosition) {
+      stopPrefetching();
+      currentPosition = originalPosition;
+    }
+  }
+
   /**
    * Read the given number of frames (samples in each channel) from this audio
    * file into the given output pointers. This method does not take or hold the
@@ -310,12 +717,19 @@ public:
    * @param outputPointer A pointer to the contiguous floating-point output
    *                      array to write to of shape [numChannels,
    * numSamplesToFill].
+   * @param numThreads The maximum number of threads to decode with, if this
+   *                   file's format supports decoding in parallel.
+   * @param outputStride The distance (in samples) between the start of each
+   *                     channel in the output array, or 0 if each channel
+   *                     is exactly as long as the number of frames that can
+   *                     be read from the file.
    *
    * @return the number of samples that were actually read from the file
    */
   long long readInternal(const long long numChannels,
                          const long long numSamplesToFill,
-                         float *outputPointer) {
+                         float *outputPointer, int numThreads = 1,
+                         long long outputStride = 0) {
     // Note: We take a "write" lock here as calling readInternal will
     // advance internal state:
     ScopedTryWriteLock scopedTryWriteLock(objectLock);
@@ -326,46 +740,122 @@ public:
           "object will produce nondeterministic results.");
     }
 
+    if (!outputStride) {
+      outputStride = std::max(
+          0LL, std::min(numSamplesToFill,
+                        (reader->lengthInSamples +
+                         (lengthCorrection ? *lengthCorrection : 0)) -
+                            currentPosition));
+    }
+
+    const long long numFileChannels = reader->numChannels;
+    float **channelPointers =
+        (float **)alloca(numFileChannels * sizeof(float *));
+    for (long long c = 0; c < numFileChannels; c++) {
+      channelPointers[c] =
+          c < numChannels ? outputPointer + (outputStride * c) : nullptr;
+    }
+
+    return readIntoChannels(channelPointers, numSamplesToFill, numThreads);
+  }
+
+  /**
+   * Read the given number of frames from this audio file into the given
+   * output pointers, one per channel in the file, each with room for
+   * numSamplesToFill samples. Channels with a null output pointer are not
+   * copied or converted at all. This method does not take or hold the GIL.
+   *
+   * @return the number of samples that were actually read from the file
+   */
+  long long readIntoChannels(float *const *outputChannels,
+                             const long long numSamplesToFill,
+                             int numThreads = 1) {
+    // Note: We take a "write" lock here as reading will advance internal
+    // state:
+    ScopedTryWriteLock scopedTryWriteLock(objectLock);
+    if (!scopedTryWriteLock.isLocked()) {
+      throw std::runtime_error(
+          "Another thread is currently reading from this AudioFile. Note "
+          "that using multiple concurrent readers on the same AudioFile "
+          "object will produce nondeterministic results.");
+    }
+
+    const long long numChannels = reader->numChannels;
+
     // If the file being read does not have enough content, it _should_ pad
     // the rest of the array with zeroes. Unfortunately, this does not seem to
     // be true in practice, so we pre-zero the array to be returned here:
-    std::fill_n(outputPointer, numChannels * numSamplesToFill, 0);
+    for (long long c = 0; c < numChannels; c++) {
+      if (outputChannels[c])
+        std::fill_n(outputChannels[c], numSamplesToFill, 0);
+    }
 
     long long numSamples = std::min(
         numSamplesToFill,
         (reader->lengthInSamples + (lengthCorrection ? *lengthCorrection : 0)) -
             currentPosition);
 
-    long long numSamplesToKeep = numSamples;
+    long long numPartitions = 1;
+    if (numThreads > 1 && supportsParallelDecoding()) {
+      numPartitions = std::min<long long>(
+          numThreads, numSamples / MIN_FRAMES_PER_DECODING_THREAD);
+    }
 
-    float **channelPointers = (float **)alloca(numChannels * sizeof(float *));
-    for (long long c = 0; c < numChannels; c++) {
-      channelPointers[c] = ((float *)outputPointer) + (numSamples * c);
+    long long numSamplesToKeep;
+    if (numPartitions > 1) {
+      numSamplesToKeep =
+          readInParallel(outputChannels, numSamples, numPartitions);
+    } else if (prefetch > 0) {
+      numSamplesToKeep = readPrefetched(outputChannels, numSamples);
+    } else {
+      numSamplesToKeep = decode(*reader, outputChannels, numChannels,
+                                numSamples, currentPosition, lengthCorrection);
     }
 
-    if (reader->usesFloatingPointData || reader->bitsPerSample == 32) {
-      auto readResult = reader->read(channelPointers, numChannels,
-                                     currentPosition, numSamples);
+    currentPosition += numSamplesToKeep;
+    return numSamplesToKeep;
+  }
+
+  /**
+   * Decode up to numSamples frames from the given position in the file into
+   * the given channel pointers, updating the given length correction if the
+   * end of the file was reached. This method does not lock or modify any
+   * other state on this object, so that it can be called from prefetching or
+   * parallel decoding threads; callers must ensure that only one thread uses
+   * each reader at once.
+   *
+   * @return the number of samples that were actually read from the file
+   */
+  long long decode(juce::AudioFormatReader &source,
+                   float *const *channelPointers,
+                   long long numChannels, long long numSamples,
+                   long long position, std::optional<long long> &correction) {
+    numSamples = std::min(
+        numSamples,
+        (source.lengthInSamples + (correction ? *correction : 0)) - position);
+
+    long long numSamplesToKeep = numSamples;
+
+    if (source.usesFloatingPointData || source.bitsPerSample == 32) {
+      auto readResult = source.read((float **)channelPointers, numChannels,
+                                    position, numSamples);
 
       juce::int64 samplesRead = numSamples;
       if (juce::AudioFormatReaderWithPosition *positionAware =
-              dynamic_cast<juce::AudioFormatReaderWithPosition *>(
-                  reader.get())) {
-        samplesRead = positionAware->getCurrentPosition() - currentPosition;
+              dynamic_cast<juce::AudioFormatReaderWithPosition *>(&source)) {
+        samplesRead = positionAware->getCurrentPosition() - position;
       }
 
-      bool hitEndOfFile =
-          (samplesRead + currentPosition) == reader->lengthInSamples;
+      bool hitEndOfFile = (samplesRead + position) == source.lengthInSamples;
 
       // We read some data, but not as much as we asked for!
       // This will only happen for lossy, header-optional formats
       // like MP3.
       if (samplesRead < numSamples || hitEndOfFile) {
-        lengthCorrection =
-            (samplesRead + currentPosition) - reader->lengthInSamples;
+        correction = (samplesRead + position) - source.lengthInSamples;
       } else if (!readResult) {
         PythonException::raise();
-        throwReadError(currentPosition, numSamples, samplesRead);
+        throwReadError(position, numSamples, samplesRead);
       }
       numSamplesToKeep = samplesRead;
     } else {
@@ -373,12 +863,11 @@ public:
       // and do the floating-point conversion ourselves to work around
       // floating-point imprecision in JUCE when reading formats smaller than
       // 32-bit (i.e.: 16-bit audio is off by about 0.003%)
-      auto readResult =
-          reader->readSamples((int **)channelPointers, numChannels, 0,
-                              currentPosition, numSamplesToKeep);
+      auto readResult = source.readSamples((int **)channelPointers, numChannels,
+                                           0, position, numSamplesToKeep);
       if (!readResult) {
         PythonException::raise();
-        throwReadError(currentPosition, numSamples);
+        throwReadError(position, numSamples);
       }
 
       // When converting 24-bit, 16-bit, or 8-bit data from int to float,
@@ -388,7 +877,7 @@ public:
       // the least significant bits are zero, effectively losing precision.
       // Instead, here we set the scale factor appropriately.
       int maxValueAsInt;
-      switch (reader->bitsPerSample) {
+      switch (source.bitsPerSample) {
       case 24:
         maxValueAsInt = 0x7FFFFF00;
         break;
@@ -400,19 +889,20 @@ public:
         break;
       default:
         throw std::runtime_error("Not sure how to convert data from " +
-                                 std::to_string(reader->bitsPerSample) +
+                                 std::to_string(source.bitsPerSample) +
                                  " bits per sample to floating point!");
       }
       float scaleFactor = 1.0f / static_cast<float>(maxValueAsInt);
 
       for (long long c = 0; c < numChannels; c++) {
+        if (!channelPointers[c])
+          continue;
         juce::FloatVectorOperations::convertFixedToFloat(
             channelPointers[c], (const int *)channelPointers[c], scaleFactor,
             static_cast<int>(numSamples));
       }
     }
 
-    currentPosition += numSamplesToKeep;
     return numSamplesToKeep;
   }
 
@@ -470,7 +960,22 @@ public:
     py::array_t<SampleType> buffer = py::array_t<SampleType>(
         {(long long)numChannels, (long long)numSamples});
 
-    py::buffer_info outputInfo = buffer.request();
+    readIntegerInto(buffer.mutable_data(), numSamples, numSamples);
+    return buffer;
+  }
+
+  /**
+   * Read numSamples frames of integer audio data from the current position
+   * into the provided channel-major output array, in which each channel
+   * starts outputStride samples after the previous one. The caller must
+   * ensure that numSamples frames are available to read, and must hold the
+   * GIL (which is released while decoding).
+   */
+  template <typename SampleType>
+  void readIntegerInto(SampleType *outputPointer, long long numSamples,
+                       long long outputStride) {
+    const juce::ScopedReadLock readLock(objectLock);
+    long long numChannels = reader->numChannels;
 
     {
       py::gil_scoped_release release;
@@ -481,12 +986,13 @@ public:
                                    "-bit integer data.");
         }
 
-        std::memset((void *)outputInfo.ptr, 0,
-                    numChannels * numSamples * sizeof(SampleType));
+        for (long long c = 0; c < numChannels; c++) {
+          std::fill_n(outputPointer + (outputStride * c), numSamples, 0);
+        }
 
         int **channelPointers = (int **)alloca(numChannels * sizeof(int *));
         for (long long c = 0; c < numChannels; c++) {
-          channelPointers[c] = ((int *)outputInfo.ptr) + (numSamples * c);
+          channelPointers[c] = ((int *)outputPointer) + (outputStride * c);
         }
 
         bool readResult = false;
@@ -498,6 +1004,7 @@ public:
                 "that using multiple concurrent readers on the same AudioFile "
                 "object will produce nondeterministic results.");
           }
+          stopPrefetching();
           readResult = reader->readSamples(channelPointers, numChannels, 0,
                                            currentPosition, numSamples);
         }
@@ -534,6 +1041,7 @@ public:
                   "AudioFile object will produce nondeterministic results.");
             }
 
+            stopPrefetching();
             readResult = reader->readSamples(channelPointers, numChannels, 0,
                                              currentPosition + startSample,
                                              samplesToRead);
@@ -548,7 +1056,7 @@ public:
           char shift = 32 - reader->bitsPerSample;
           for (long long c = 0; c < numChannels; c++) {
             SampleType *outputChannelPointer =
-                (((SampleType *)outputInfo.ptr) + (c * numSamples));
+                outputPointer + (c * outputStride);
             for (long long i = 0; i < samplesToRead; i++) {
               outputChannelPointer[startSample + i] = intBuffers[c][i] >> shift;
             }
@@ -567,7 +1075,6 @@ public:
           "AudioFile object will produce nondeterministic results.");
     }
     currentPosition += numSamples;
-    return buffer;
   }
 
   void seek(long long targetPosition) {
@@ -602,6 +1109,9 @@ public:
           "using multiple concurrent readers on the same AudioFile object will "
           "produce nondeterministic results.");
     }
+
+    if (targetPosition != currentPosition)
+      stopPrefetching();
     currentPosition = targetPosition;
   }
 
@@ -618,6 +1128,8 @@ public:
           "Another thread is currently reading from this AudioFile; it cannot "
           "be closed until the other thread completes its operation.");
     }
+    stopPrefetching();
+
     // Note: This may deallocate a Python object, so must be called with the
     // GIL held:
     reader.reset();
@@ -657,8 +1169,58 @@ public:
     return true;
   }
 
+  py::bytes buildFrameIndex() {
+    juce::MemoryBlock index;
+    {
+      py::gil_scoped_release release;
+      ScopedTryWriteLock scopedTryWriteLock(objectLock);
+      if (!scopedTryWriteLock.isLocked()) {
+        throw std::runtime_error(
+            "Another thread is currently reading from this AudioFile. Note "
+            "that using multiple concurrent readers on the same AudioFile "
+            "object will produce nondeterministic results.");
+      }
+
+      juce::AudioFormatReaderWithPosition *indexableReader =
+          getIndexableReader();
+      stopPrefetching();
+      indexableReader->buildFrameIndex();
+      applyFrameIndex();
+      index = indexableReader->getFrameIndex();
+    }
+
+    PythonException::raise();
+    return py::bytes(static_cast<const char *>(index.getData()),
+                     index.getSize());
+  }
+
+  void loadFrameIndex(py::bytes serializedIndex) {
+    std::string index = serializedIndex;
+
+    py::gil_scoped_release release;
+    ScopedTryWriteLock scopedTryWriteLock(objectLock);
+    if (!scopedTryWriteLock.isLocked()) {
+      throw std::runtime_error(
+          "Another thread is currently reading from this AudioFile. Note "
+          "that using multiple concurrent readers on the same AudioFile "
+          "object will produce nondeterministic results.");
+    }
+
+    juce::AudioFormatReaderWithPosition *indexableReader =
+        getIndexableReader();
+    stopPrefetching();
+    if (!indexableReader->loadFrameIndex(index.data(), index.size())) {
+      throw std::domain_error(
+          "The provided frame index is invalid or was not built from this "
+          "file's contents. Call build_frame_index() to build a new one.");
+    }
+    applyFrameIndex();
+  }
+
   std::optional<std::string> getFilename() const { return filename; }
 
+  int getPrefetch() const { return prefetch; }
+
   PythonInputStream *getPythonInputStream() const {
     if (!filename.empty()) {
       return nullptr;
@@ -684,6 +1246,187 @@ public:
   }
 
 private:
+  // Reads shorter than this (per thread) aren't worth splitting up, as
+  // opening another reader can take as long as decoding this much audio:
+  static constexpr long long MIN_FRAMES_PER_DECODING_THREAD = 65536;
+
+  /**
+   * Returns true if this file can be decoded by multiple readers at once,
+   * each starting at an arbitrary frame. This requires a file on disk (so
+   * that more readers can be opened) in a format whose frames can be decoded
+   * independently: PCM data in WAV or AIFF files, or FLAC frames.
+   */
+  bool supportsParallelDecoding() const {
+    if (filename.empty())
+      return false;
+
+    juce::String formatName = reader->getFormatName();
+    return formatName == "WAV file" || formatName == "AIFF file" ||
+           formatName == "FLAC file";
+  }
+
+  /**
+   * Read numSamples frames from the current position by splitting the range
+   * to read into numPartitions contiguous partitions and decoding each on its
+   * own thread, with its own reader, directly into its slice of the output
+   * array. The last partition is decoded by this object's reader, leaving it
+   * positioned to continue reading from the end of this read. Must be called
+   * while holding a write lock on objectLock.
+   */
+  long long readInParallel(float *const *outputChannels, long long numSamples,
+                           long long numPartitions) {
+    // The prefetching thread (if any) would otherwise be using our reader:
+    stopPrefetching();
+
+    const long long numChannels = reader->numChannels;
+    long long framesPerPartition = numSamples / numPartitions;
+    std::vector<long long> framesDecoded(numPartitions, 0);
+
+    // The last partition may update its length correction while the others
+    // are reading theirs, so each partition gets its own copy; the last
+    // partition's copy is stored once all partitions have been decoded.
+    const std::optional<long long> initialLengthCorrection = lengthCorrection;
+    std::optional<long long> lastPartitionLengthCorrection =
+        initialLengthCorrection;
+
+    ThreadPool pool(numPartitions);
+    pool.parallelFor(numPartitions, [&](size_t partition, size_t) {
+      bool isLastPartition = (long long)partition == numPartitions - 1;
+      long long startFrame = partition * framesPerPartition;
+      long long numFrames = isLastPartition ? numSamples - startFrame
+                                            : framesPerPartition;
+
+      std::vector<float *> channelPointers(numChannels);
+      for (long long c = 0; c < numChannels; c++) {
+        channelPointers[c] =
+            outputChannels[c] ? outputChannels[c] + startFrame : nullptr;
+      }
+
+      if (isLastPartition) {
+        framesDecoded[partition] = decode(
+            *reader, channelPointers.data(), numChannels, numFrames,
+            currentPosition + startFrame, lastPartitionLengthCorrection);
+        return;
+      }
+
+      std::unique_ptr<juce::AudioFormatReader> partitionReader(
+          formatManager.createReaderFor(juce::File(filename)));
+      if (!partitionReader)
+        throw std::runtime_error("Failed to open audio file \"" + filename +
+                                 "\" for parallel decoding.");
+
+      std::optional<long long> partitionLengthCorrection =
+          initialLengthCorrection;
+      framesDecoded[partition] = decode(
+          *partitionReader, channelPointers.data(), numChannels, numFrames,
+          currentPosition + startFrame, partitionLengthCorrection);
+    });
+
+    lengthCorrection = lastPartitionLengthCorrection;
+
+    // The partitions should all decode in full, but if one comes up short,
+    // only return the contiguous audio before it:
+    long long numSamplesRead = 0;
+    for (long long partition = 0; partition < numPartitions; partition++) {
+      numSamplesRead += framesDecoded[partition];
+      if (partition < numPartitions - 1 &&
+          framesDecoded[partition] < framesPerPartition)
+        break;
+    }
+    return numSamplesRead;
+  }
+
+  /**
+   * Copy up to numSamples frames of audio from the current position into the
+   * given output channels (skipping any null channels), starting a
+   * background thread to decode audio ahead of the current position if one is
+   * not already running. Must be called while holding a write lock on
+   * objectLock.
+   */
+  long long readPrefetched(float *const *outputChannels, long long numSamples) {
+    const long long numChannels = reader->numChannels;
+    if (!readAheadBuffer) {
+      prefetchPosition = currentPosition;
+      prefetchLengthCorrection = lengthCorrection;
+      readAheadBuffer = std::make_unique<ReadAheadBuffer>(
+          prefetch, numChannels,
+          std::max(numSamples, (long long)DEFAULT_AUDIO_BUFFER_SIZE_FRAMES),
+          [this, numChannels](float **channelPointers, long long numFrames) {
+            long long framesDecoded =
+                decode(*reader, channelPointers, numChannels, numFrames,
+                       prefetchPosition, prefetchLengthCorrection);
+            prefetchPosition += framesDecoded;
+            return framesDecoded;
+          });
+    }
+
+    long long numSamplesRead;
+    try {
+      numSamplesRead = readAheadBuffer->read(outputChannels, numSamples);
+    } catch (...) {
+      // Discard any audio decoded after the point of failure, so that the
+      // next read retries from the current position (as it would if we
+      // weren't prefetching):
+      stopPrefetching();
+      throw;
+    }
+
+    if (readAheadBuffer->isExhausted())
+      lengthCorrection = prefetchLengthCorrection;
+
+    return numSamplesRead;
+  }
+
+  /**
+   * Stop the prefetching thread (if any), discarding any audio it has
+   * decoded. The prefetching thread may need the GIL to report an error, so
+   * the GIL is released (if held) while waiting for that thread to stop.
+   */
+  void stopPrefetching() {
+    if (!readAheadBuffer)
+      return;
+
+    if (PyGILState_Check()) {
+      py::gil_scoped_release release;
+      readAheadBuffer.reset();
+    } else {
+      readAheadBuffer.reset();
+    }
+  }
+
+  /**
+   * Return this file's reader if it supports frame indices, or throw an
+   * exception if it does not. Must be called with objectLock held.
+   */
+  juce::AudioFormatReaderWithPosition *getIndexableReader() {
+    if (!reader)
+      throw std::runtime_error("I/O operation on a closed file.");
+
+    auto *positionAware =
+        dynamic_cast<juce::AudioFormatReaderWithPosition *>(reader.get());
+    if (!positionAware) {
+      throw std::domain_error(
+          "Frame indices are only supported for MP3 files. " +
+          reader->getFormatName().toStdString() +
+          "s already provide exact lengths and fast seeking.");
+    }
+    return positionAware;
+  }
+
+  /**
+   * Update our cached length after the reader has built or loaded a frame
+   * index, which replaces any estimated length with an exact one. Must be
+   * called with objectLock held for writing.
+   */
+  void applyFrameIndex() {
+    if (reader->lengthInSamples == numFrames)
+      return;
+
+    numFrames = reader->lengthInSamples;
+    lengthCorrection = {};
+    currentPosition = std::min<long long>(currentPosition, numFrames);
+  }
+
   void throwReadError(long long currentPosition, long long numSamples,
                       long long samplesRead = -1) {
     std::ostringstream ss;
@@ -750,6 +1493,15 @@ private:
   // will be greater than 0; if fewer are present, `lengthCorrection` will
   // be less than 0.
   std::optional<long long> lengthCorrection = {};
+
+  // If prefetch is greater than zero, up to that many chunks of audio are
+  // decoded ahead of currentPosition by readAheadBuffer's thread, which owns
+  // the reader (and the prefetch* fields below) while it runs. Declared after
+  // reader so that the thread is stopped before the reader is destroyed.
+  int prefetch = 0;
+  std::unique_ptr<ReadAheadBuffer> readAheadBuffer;
+  long long prefetchPosition = 0;
+  std::optional<long long> prefetchLengthCorrection = {};
 };
 
 inline py::class_<ReadableAudioFile, AudioFile,
@@ -795,29 +1547,31 @@ inline void init_readable_audio_file(
     py::class_<ReadableAudioFile, AudioFile, std::shared_ptr<ReadableAudioFile>>
         &pyReadableAudioFile) {
   pyReadableAudioFile
-      .def(py::init([](std::string filename) -> ReadableAudioFile * {
+      .def(py::init([](std::string filename,
+                       int prefetch) -> ReadableAudioFile * {
              // This definition is only here to provide nice docstrings.
              throw std::runtime_error(
                  "Internal error: __init__ should never be called, as this "
                  "class implements __new__.");
            }),
-           py::arg("filename"))
-      .def(py::init([](py::object filelike) -> ReadableAudioFile * {
+           py::arg("filename"), py::arg("prefetch") = 0)
+      .def(py::init([](py::object filelike,
+                       int bufferSize) -> ReadableAudioFile * {
              // This definition is only here to provide nice docstrings.
              throw std::runtime_error(
                  "Internal error: __init__ should never be called, as this "
                  "class implements __new__.");
            }),
-           py::arg("file_like"))
+           py::arg("file_like"), py::arg("buffer_size") = 0)
       .def_static(
           "__new__",
-          [](const py::object *, std::string filename) {
-            return std::make_shared<ReadableAudioFile>(filename);
+          [](const py::object *, std::string filename, int prefetch) {
+            return std::make_shared<ReadableAudioFile>(filename, prefetch);
           },
-          py::arg("cls"), py::arg("filename"))
+          py::arg("cls"), py::arg("filename"), py::arg("prefetch") = 0)
       .def_static(
           "__new__",
-          [](const py::object *, py::object filelike) {
+          [](const py::object *, py::object filelike, int bufferSize) {
             if (!isReadableFileLike(filelike) &&
                 !tryConvertingToBuffer(filelike)) {
               throw py::type_error(
@@ -834,11 +1588,13 @@ inline void init_readable_audio_file(
                                                                 filelike));
             } else {
               return std::make_shared<ReadableAudioFile>(
-                  std::make_unique<PythonInputStream>(filelike));
+                  std::make_unique<PythonInputStream>(filelike, bufferSize));
             }
           },
-          py::arg("cls"), py::arg("file_like"))
-      .def("read", &ReadableAudioFile::read, py::arg("num_frames") = 0, R"(
+          py::arg("cls"), py::arg("file_like"), py::arg("buffer_size") = 0)
+      .def("read", &ReadableAudioFile::read, py::arg("num_frames") = 0,
+           py::arg("num_threads") = 1, py::arg("channels") = py::none(),
+           py::arg("downmix") = py::none(), R"(
 Read the given number of frames (samples in each channel) from this audio file at its current position.
 
 ``num_frames`` is a required argument, as audio files can be deceptively large. (Consider that 
@@ -859,10 +1615,79 @@ in which this may occur.)
 For most (but not all) audio files, the minimum possible sample value will be ``-1.0f`` and the
 maximum sample value will be ``+1.0f``.
 
+If ``num_threads`` is greater than 1, large reads from WAV, AIFF, and FLAC files on disk will be
+split into up to ``num_threads`` contiguous ranges, each of which will be decoded on its own
+thread by its own reader. The returned audio is identical to that returned when
+``num_threads`` is 1. Reads from other formats, from file-like objects, or of fewer than 65,536
+frames per thread are decoded on the calling thread as usual::
+
+    with AudioFile("three_hour_recording.flac") as f:
+        audio = f.read(f.frames, num_threads=8)
+
+To read only some of this file's channels, pass a list of channel indices as ``channels``;
+the returned array will contain one row per requested channel, in the order requested.
+Channels that are not requested are not copied or converted. To mix all of the channels
+(or just those in ``channels``) down to a single channel by averaging them, pass
+``downmix="mono"``; the returned array will have shape ``(1, <length>)``::
+
+    with AudioFile("surround.wav") as f:
+        front = f.read(f.frames, channels=[0, 1])
+        f.seek(0)
+        mono = f.read(f.frames, downmix="mono")
+
 .. note::
     For convenience, the ``num_frames`` argument may be a floating-point number. However, if the
     provided number of frames contains a fractional part (i.e.: ``1.01`` instead of ``1.00``) then
     an exception will be thrown, as a fractional number of samples cannot be returned.
+
+*The num_threads, channels, and downmix arguments were introduced in v0.9.22.*
+)")
+      .def("read_into", &ReadableAudioFile::readInto, py::arg("out"),
+           py::arg("offset") = 0, py::arg("num_threads") = 1, R"(
+Read audio from this file at its current position directly into ``out``, an
+existing C-contiguous :class:`numpy.array` of shape ``(num_channels, frames)``,
+and return the number of frames read.
+
+Audio is written into ``out[:, offset:]``, reading as many frames as fit (or
+as remain in the file). Any frames past the end of the file are set to zero.
+Unlike :meth:`read`, no new array is allocated, which makes :meth:`read_into`
+well suited to filling preallocated (i.e.: ring or pinned) buffers in a loop::
+
+   buffer = np.zeros((f.num_channels, 16000), dtype=np.float32)
+   while f.tell() < f.frames:
+      frames_read = f.read_into(buffer)
+      process(buffer[:, :frames_read])
+
+If ``out`` is a ``float32`` array, it will be filled with the same data returned
+by :meth:`read`. If ``out`` is an integer array (``int8``, ``int16``, or
+``int32``) wide enough to hold this file's samples, it will be filled with the
+raw data returned by :meth:`read_raw`.
+
+*Introduced in v0.9.22.*
+)")
+      .def("read_windows", &ReadableAudioFile::readWindows, py::arg("offsets"),
+           py::arg("length"), R"(
+Read many windows of ``length`` frames from this file at once, each starting
+at one of the provided ``offsets`` (in frames), and return them as a single
+32-bit floating-point :class:`numpy.array` of shape
+``(len(offsets), num_channels, length)``.
+
+This produces the same audio as calling :meth:`seek` and :meth:`read` for each
+offset in turn, but does so in one native call without holding the GIL.
+Windows are decoded in order of their offsets to avoid seeking backwards, and
+audio shared by overlapping windows is only decoded once. This makes
+:meth:`read_windows` well suited to sampling random crops from a file::
+
+   with AudioFile("podcast.mp3") as f:
+      offsets = np.random.randint(0, f.frames - 16000, size=32)
+      crops = f.read_windows(offsets, 16000)
+      assert crops.shape == (32, f.num_channels, 16000)
+
+Windows that extend past the end of the file are padded with zeros. Offsets
+must be between ``0`` and :py:attr:`frames` (inclusive). The read position of
+this file (as returned by :meth:`tell`) is not changed.
+
+*Introduced in v0.9.22.*
 )")
       .def("read_raw", &ReadableAudioFile::readRaw, py::arg("num_frames") = 0,
            R"(
@@ -895,6 +1720,58 @@ in which this may occur.)
       .def("seek", &ReadableAudioFile::seek, py::arg("position"),
            "Seek this file to the provided location in frames. Future reads "
            "will start from this position.")
+      .def("build_frame_index", &ReadableAudioFile::buildFrameIndex, R"(
+Scan this file once from start to finish to find the position of every frame
+of compressed audio, returning a serialized copy of the resulting index as
+:class:`bytes`.
+
+Once an index has been built (or loaded with :meth:`load_frame_index`),
+:py:attr:`frames` is exact, :py:attr:`exact_duration_known` is
+:py:const:`True`, and :meth:`seek` can jump straight to any position without
+first scanning through the file. This is useful when reading many short
+excerpts from random positions in long MP3 files.
+
+Scanning a file only parses frame headers and does not decode any audio, so
+it's much faster than reading the file. The returned index can be stored
+(e.g.: in a sidecar file) and passed to :meth:`load_frame_index` when the
+same file is opened again to avoid scanning it a second time::
+
+   from pathlib import Path
+
+   index_path = Path("podcast.mp3.index")
+   with AudioFile("podcast.mp3") as f:
+      if index_path.exists():
+         f.load_frame_index(index_path.read_bytes())
+      else:
+         index_path.write_bytes(f.build_frame_index())
+
+      f.seek(f.frames // 2)
+      excerpt = f.read(f.samplerate * 10)
+
+Calling this method again on a file that is already indexed does not scan the
+file again. The read position of the file is not changed.
+
+.. note::
+    Frame indices are only supported for MP3 files, as every other
+    supported format already provides exact lengths and fast seeking.
+    Calling this method on a file in another format raises a
+    :class:`ValueError`.
+
+*Introduced in v0.9.22.*
+)")
+      .def("load_frame_index", &ReadableAudioFile::loadFrameIndex,
+           py::arg("index"), R"(
+Load a frame index previously returned by :meth:`build_frame_index`
+for this file, giving this file an exact length and fast seeking without
+scanning the file. See :meth:`build_frame_index` for more details.
+
+A :class:`ValueError` is raised if the provided index is corrupt or was built
+from a different file. (Indices are validated against the file's size and the
+position of its first frame, so an index built from a different version of the
+same file may not always be detected.)
+
+*Introduced in v0.9.22.*
+)")
       .def("tell", &ReadableAudioFile::tell,
            "Return the current position of the read pointer in this audio "
            "file, in frames. This value will increase as :meth:`read` is "
@@ -940,6 +1817,19 @@ in which this may occur.)
       .def_property_readonly("closed", &ReadableAudioFile::isClosed,
                              "True iff this file is closed (and no longer "
                              "usable), False otherwise.")
+      .def_property_readonly("prefetch", &ReadableAudioFile::getPrefetch,
+                             R"(
+The maximum number of chunks of audio that will be decoded ahead of the
+current position on a background thread, or ``0`` if audio is only decoded
+when :meth:`read` is called.
+
+Each chunk is as long as the :meth:`read` call that started prefetching, or
+8,192 frames, whichever is longer. Prefetching starts on the first call to
+:meth:`read`, and restarts on the next call to :meth:`read` after each call to
+:meth:`seek`.
+
+*Introduced in v0.9.22.*
+)")
       .def_property_readonly(
           "samplerate", &ReadableAudioFile::getSampleRate,
           "The sample rate of this file in samples (per channel) per second "
@@ -17,7 +17,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <mutex>
+#include <numeric>
 #include <optional>
 
 #include <pybind11/numpy.h>
@@ -67,6 +69,10 @@ static inline int inputBufferSizeFor(ResamplingQuality quality) {
   return 0;
 }
 
+// When reading windows, gaps between windows of up to this many frames (or
+// the window length, if longer) are read through rather than seeked over:
+static constexpr long long MAX_WINDOW_GAP_TO_READ_THROUGH = 65536;
+
 class ResampledReadableAudioFile
     : public AudioFile,
       public std::enable_shared_from_this<ResampledReadableAudioFile> {
@@ -165,6 +171,44 @@ public:
                                      ChannelLayout::NotInterleaved, 0);
   }
 
+  long long readInto(py::array out, long long offset) {
+    if (isClosed())
+      throw std::runtime_error("I/O operation on a closed file.");
+
+    const long long numChannels = getNumChannels();
+    const long long numFramesToFill =
+        checkReadIntoArray(out, numChannels, offset);
+
+    if (out.dtype().kind() != 'f' || out.dtype().itemsize() != 4) {
+      throw py::type_error(
+          "Resampled audio can only be read into a float32 array, but the "
+          "provided output array has dtype " +
+          py::str(out.dtype()).cast<std::string>() + ".");
+    }
+
+    const long long numFrames = out.shape(1);
+    float *outputPointer = (float *)out.mutable_data() + offset;
+    std::vector<float *> channelPointers(numChannels);
+    for (long long c = 0; c < numChannels; c++) {
+      channelPointers[c] = outputPointer + (c * numFrames);
+    }
+
+    long long numSamplesRead;
+    {
+      py::gil_scoped_release release;
+      numSamplesRead = readInternal(numFramesToFill, channelPointers.data());
+    }
+
+    // Zero out any frames past the end of the file:
+    for (long long c = 0; c < numChannels; c++) {
+      std::fill_n(channelPointers[c] + numSamplesRead,
+                  numFramesToFill - numSamplesRead, 0.0f);
+    }
+
+    PythonException::raise();
+    return numSamplesRead;
+  }
+
   /**
    * Read samples from the underlying audio file, resample them, and return a
    * juce::AudioBuffer containing the result without holding the GIL.
@@ -173,6 +217,26 @@ public:
    * @return juce::AudioBuffer<float> The resulting audio.
    */
   juce::AudioBuffer<float> readInternal(long long numSamples) {
+    juce::AudioBuffer<float> resampledBuffer(audioFile->getNumChannels(),
+                                             numSamples);
+    long long samplesRead =
+        readInternal(numSamples, resampledBuffer.getArrayOfWritePointers());
+    if (samplesRead < numSamples) {
+      resampledBuffer.setSize(resampledBuffer.getNumChannels(), samplesRead,
+                              /* keepExistingContent */ true);
+    }
+    return resampledBuffer;
+  }
+
+  /**
+   * Read samples from the underlying audio file and resample them into the
+   * provided channel pointers (one per channel, each with room for
+   * numSamples samples) without holding the GIL.
+   *
+   * @return the number of samples written to each channel, which will only
+   *         be less than numSamples if the end of the file was reached.
+   */
+  long long readInternal(long long numSamples, float *const *outputChannels) {
     // Note: We take a "write" lock here as calling readInternal will
     // advance internal state:
     ScopedTryWriteLock scopedTryWriteLock(objectLock);
@@ -183,24 +247,23 @@ public:
           "object will produce nondeterministic results.");
     }
 
+    const int numChannels = audioFile->getNumChannels();
     long long samplesInResampledBuffer = 0;
-    juce::AudioBuffer<float> resampledBuffer(audioFile->getNumChannels(),
-                                             numSamples);
 
     // Any samples in the existing outputBuffer from last time
-    // should be copied into resampledBuffer:
+    // should be copied into the output:
     int samplesToPullFromOutputBuffer =
         std::min(outputBuffer.getNumSamples(), (int)numSamples);
     if (samplesToPullFromOutputBuffer > 0) {
-      for (int c = 0; c < resampledBuffer.getNumChannels(); c++) {
-        resampledBuffer.copyFrom(c, 0, outputBuffer, c, 0,
-                                 samplesToPullFromOutputBuffer);
+      for (int c = 0; c < numChannels; c++) {
+        std::copy_n(outputBuffer.getReadPointer(c),
+                    samplesToPullFromOutputBuffer, outputChannels[c]);
       }
       samplesInResampledBuffer += samplesToPullFromOutputBuffer;
 
       // Remove the used samples from outputBuffer:
       if (outputBuffer.getNumSamples() - samplesToPullFromOutputBuffer) {
-        for (int c = 0; c < resampledBuffer.getNumChannels(); c++) {
+        for (int c = 0; c < numChannels; c++) {
           // Use std::memmove instead of copyFrom here, as copyFrom is not
           // overlap-safe.
           std::memmove(
@@ -213,125 +276,99 @@ public:
       outputBuffer.setSize(outputBuffer.getNumChannels(),
                            outputBuffer.getNumSamples() -
                                samplesToPullFromOutputBuffer,
-                           /* keepExistingContent */ true);
+                           /* keepExistingContent */ true,
+                           /* clearExtraSpace */ false,
+                           /* avoidReallocating */ true);
     }
 
-    long long inputSamplesRequired =
-        (long long)(((numSamples - samplesToPullFromOutputBuffer) *
-                     audioFile->getSampleRateAsDouble()) /
-                    resampler.getTargetSampleRate());
-
-    // Make a juce::AudioBuffer that contains contiguous memory,
-    // which we can pass to readInternal:
-    std::vector<float> contiguousSourceSampleBuffer;
-    std::vector<float *> contiguousSourceSampleBufferPointers =
-        std::vector<float *>(audioFile->getNumChannels());
-
     while (samplesInResampledBuffer < numSamples) {
-      // Cut or expand the contiguousSourceSampleBuffer to the required size:
-      contiguousSourceSampleBuffer.resize(
-          // Note: we need at least one element in this buffer or else we'll
-          // have no channel pointers to pass into the juce::AudioFile
-          // constructor!
-          std::max(1LL, audioFile->getNumChannels() * inputSamplesRequired));
-      std::fill_n(contiguousSourceSampleBuffer.begin(),
-                  contiguousSourceSampleBuffer.size(), 0);
-      for (int c = 0; c < audioFile->getNumChannels(); c++) {
-        contiguousSourceSampleBufferPointers[c] =
-            contiguousSourceSampleBuffer.data() + (c * inputSamplesRequired);
+      const long long samplesRemaining = numSamples - samplesInResampledBuffer;
+
+      // Pull as many source frames as the resampler can use without producing
+      // more output than was requested, one bounded block at a time:
+      long long inputSamplesRequired =
+          std::clamp(resampler.getMaxInputSamplesFor(samplesRemaining), 1LL,
+                     MAX_SOURCE_FRAMES_PER_BLOCK);
+
+      if (sourceBlock.getNumChannels() != numChannels ||
+          sourceBlock.getNumSamples() < inputSamplesRequired) {
+        sourceBlock.setSize(numChannels, inputSamplesRequired,
+                            /* keepExistingContent */ false,
+                            /* clearExtraSpace */ false,
+                            /* avoidReallocating */ true);
       }
 
-      juce::AudioBuffer<float> sourceSamples = juce::AudioBuffer<float>(
-          contiguousSourceSampleBufferPointers.data(),
-          audioFile->getNumChannels(), inputSamplesRequired);
-      std::optional<juce::AudioBuffer<float>> resamplerInput;
-
-      if (inputSamplesRequired > 0) {
-        // Read from the underlying audioFile into our contiguous buffer,
-        // which causes the sourceSamples AudioBuffer to be filled:
-        long long samplesRead = audioFile->readInternal(
-            audioFile->getNumChannels(), inputSamplesRequired,
-            contiguousSourceSampleBuffer.data());
-
-        // Resize the sourceSamples buffer to the number of samples read,
-        // without reallocating the memory underneath
-        // (still points at contiguousSourceSampleBuffer):
-        sourceSamples.setSize(audioFile->getNumChannels(), samplesRead,
-                              /* keepExistingContent */ true,
-                              /* clearExtraSpace */ false,
-                              /* avoidReallocating */ true);
-
-        if (samplesRead < inputSamplesRequired) {
-          for (int c = 0; c < audioFile->getNumChannels(); c++) {
-            contiguousSourceSampleBufferPointers[c] =
-                contiguousSourceSampleBuffer.data() + (c * samplesRead);
-          }
-          sourceSamples = juce::AudioBuffer<float>(
-              contiguousSourceSampleBufferPointers.data(),
-              audioFile->getNumChannels(), samplesRead);
-        }
+      long long samplesRead = audioFile->readIntoChannels(
+          sourceBlock.getArrayOfWritePointers(), inputSamplesRequired);
 
-        // If the underlying source ran out of samples, tell the resampler that
-        // we're done by feeding in an empty optional rather than an empty
-        // buffer:
-        if (sourceSamples.getNumSamples() == 0) {
-          resamplerInput = {};
-        } else {
-          resamplerInput = {sourceSamples};
-        }
-      } else {
-        resamplerInput = {sourceSamples};
+      // If the underlying source ran out of samples, tell the resampler that
+      // we're done by feeding in an empty optional rather than an empty
+      // buffer:
+      std::optional<juce::AudioBuffer<float>> resamplerInput;
+      std::optional<long long> numInputSamples;
+      if (samplesRead > 0) {
+        // This buffer refers to sourceBlock's memory without copying it:
+        resamplerInput = juce::AudioBuffer<float>(
+            sourceBlock.getArrayOfWritePointers(), numChannels, samplesRead);
+        numInputSamples = samplesRead;
       }
 
-      // TODO: Provide an alternative interface to write to the output buffer
-      juce::AudioBuffer<float> newResampledSamples =
-          resampler.process(resamplerInput);
-
-      int offsetInNewResampledSamples = 0;
-      if (newResampledSamples.getNumSamples() >
-          numSamples - samplesInResampledBuffer) {
-        int samplesToCache = newResampledSamples.getNumSamples() -
-                             (numSamples - samplesInResampledBuffer);
-        outputBuffer.setSize(newResampledSamples.getNumChannels(),
-                             samplesToCache);
-        for (int c = 0; c < outputBuffer.getNumChannels(); c++) {
-          outputBuffer.copyFrom(c, 0, newResampledSamples, c,
-                                newResampledSamples.getNumSamples() -
-                                    samplesToCache,
-                                samplesToCache);
-        }
-      }
+      long long numOutputSamples =
+          resampler.getNumOutputSamplesFor(numInputSamples);
 
-      if (!resamplerInput && newResampledSamples.getNumSamples() == 0) {
-        resampledBuffer.setSize(resampledBuffer.getNumChannels(),
-                                samplesInResampledBuffer,
-                                /* keepExistingContent */ true);
-        break;
-      }
+      if (numOutputSamples <= samplesRemaining) {
+        // Resample directly into the caller's memory:
+        juce::AudioBuffer<float> destination(
+            outputChannels, numChannels, (int)samplesInResampledBuffer,
+            (int)samplesRemaining);
+        numOutputSamples = resampler.process(resamplerInput, destination);
+        samplesInResampledBuffer += numOutputSamples;
 
-      int startSample = samplesInResampledBuffer;
-      int samplesToCopy = std::min(
-          newResampledSamples.getNumSamples() - offsetInNewResampledSamples,
-          (int)(numSamples - samplesInResampledBuffer));
-      if (samplesToCopy > 0) {
-        for (int c = 0; c < resampledBuffer.getNumChannels(); c++) {
-          resampledBuffer.copyFrom(c, startSample, newResampledSamples, c,
-                                   offsetInNewResampledSamples, samplesToCopy);
+        if (!resamplerInput && numOutputSamples == 0) {
+          break;
         }
+      } else {
+        // Only the last few samples of a read (or a flush) can produce more
+        // output than we need; cache the rest for the next call:
+        outputBuffer.setSize(numChannels, numOutputSamples,
+                             /* keepExistingContent */ false,
+                             /* clearExtraSpace */ false,
+                             /* avoidReallocating */ true);
+        resampler.process(resamplerInput, outputBuffer);
+
+        int samplesToCache = numOutputSamples - samplesRemaining;
+        for (int c = 0; c < numChannels; c++) {
+          std::copy_n(outputBuffer.getReadPointer(c), samplesRemaining,
+                      outputChannels[c] + samplesInResampledBuffer);
+          std::memmove(outputBuffer.getWritePointer(c),
+                       outputBuffer.getReadPointer(c, samplesRemaining),
+                       samplesToCache * sizeof(float));
+        }
+        outputBuffer.setSize(numChannels, samplesToCache,
+                             /* keepExistingContent */ true,
+                             /* clearExtraSpace */ false,
+                             /* avoidReallocating */ true);
+        samplesInResampledBuffer += samplesRemaining;
       }
-      samplesInResampledBuffer += samplesToCopy;
-
-      // TODO: Tune this carefully to avoid unnecessary calls to read()
-      // Too large, and we buffer too much audio using too much memory
-      // Too short, and we slow down
-      inputSamplesRequired = 1;
     }
-    positionInTargetSampleRate += resampledBuffer.getNumSamples();
-    return resampledBuffer;
+    positionInTargetSampleRate += samplesInResampledBuffer;
+    return samplesInResampledBuffer;
   }
 
   void seek(long long targetPosition) {
-    py::gil_scoped_release release;
+    {
+      py::gil_scoped_release release;
+      seekInternal(targetPosition);
+    }
+
+    PythonException::raise();
+  }
+
+  /**
+   * Seek to the given position in the target sample rate without taking or
+   * holding the GIL.
+   */
+  void seekInternal(long long targetPosition) {
     {
       ScopedTryWriteLock scopedTryWriteLock(objectLock);
       if (!scopedTryWriteLock.isLocked()) {
@@ -379,8 +416,117 @@ public:
         this->readInternal(numSamples);
       }
     }
+  }
+
+  py::array_t<float, py::array::c_style>
+  readWindows(std::vector<long long> offsets, long long length) {
+    if (length < 1)
+      throw std::domain_error("length must be at least 1, but was " +
+                              std::to_string(length) + ".");
+
+    if (isClosed())
+      throw std::runtime_error("I/O operation on a closed file.");
+
+    const long long endOfFile = getLengthInSamples();
+    for (long long offset : offsets) {
+      if (offset < 0 || offset > endOfFile) {
+        throw std::domain_error(
+            "Cannot read a window starting at position " +
+            std::to_string(offset) + ", which is outside of the file (" +
+            std::to_string(endOfFile) + " frames long).");
+      }
+    }
+
+    const long long numChannels = getNumChannels();
+    py::array_t<float, py::array::c_style> output(
+        {(long long)offsets.size(), numChannels, length});
+    float *outputPointer = output.mutable_data();
+
+    {
+      py::gil_scoped_release release;
+      readWindowsInternal(offsets, length, outputPointer);
+    }
 
     PythonException::raise();
+    return output;
+  }
+
+  /**
+   * Read one window of `length` frames (at the target sample rate) starting
+   * at each of the given offsets into a contiguous output array of shape
+   * [offsets.size(), numChannels, length], zero-padding any windows that
+   * extend past the end of the file.
+   *
+   * Windows are read in order of their offsets. Audio shared by overlapping
+   * windows is copied rather than resampled twice, and short gaps between
+   * windows are read through rather than seeked over, as seeking requires
+   * resetting the resampler. The read position is left unchanged. This method
+   * does not take or hold the GIL.
+   */
+  void readWindowsInternal(const std::vector<long long> &offsets,
+                           long long length, float *outputPointer) {
+    ScopedTryWriteLock scopedTryWriteLock(objectLock);
+    if (!scopedTryWriteLock.isLocked()) {
+      throw std::runtime_error(
+          "Another thread is currently reading from this AudioFile. Note "
+          "that using multiple concurrent readers on the same AudioFile "
+          "object will produce nondeterministic results.");
+    }
+
+    const long long numChannels = audioFile->getNumChannels();
+
+    std::vector<size_t> order(offsets.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return offsets[a] < offsets[b];
+    });
+
+    const long long originalPosition = positionInTargetSampleRate;
+
+    const float *previousWindow = nullptr;
+    long long previousOffset = 0;
+    long long previousFramesRead = 0;
+
+    for (size_t index : order) {
+      float *window = outputPointer + (index * numChannels * length);
+      const long long offset = offsets[index];
+      std::fill_n(window, numChannels * length, 0.0f);
+
+      long long framesRead = 0;
+      if (previousWindow && offset < previousOffset + previousFramesRead) {
+        framesRead =
+            std::min(length, previousOffset + previousFramesRead - offset);
+        for (long long c = 0; c < numChannels; c++) {
+          std::copy_n(previousWindow + (c * length) + (offset - previousOffset),
+                      framesRead, window + (c * length));
+        }
+      }
+
+      if (framesRead < length) {
+        const long long readStart = offset + framesRead;
+        const long long gap = readStart - positionInTargetSampleRate;
+        if (gap < 0 ||
+            gap > std::max(length, MAX_WINDOW_GAP_TO_READ_THROUGH)) {
+          seekInternal(readStart);
+        } else if (gap > 0) {
+          readInternal(gap);
+        }
+
+        juce::AudioBuffer<float> audio = readInternal(length - framesRead);
+        for (long long c = 0; c < numChannels; c++) {
+          std::copy_n(audio.getReadPointer(c), audio.getNumSamples(),
+                      window + (c * length) + framesRead);
+        }
+        framesRead += audio.getNumSamples();
+      }
+
+      previousWindow = window;
+      previousOffset = offset;
+      previousFramesRead = framesRead;
+    }
+
+    if (positionInTargetSampleRate != originalPosition)
+      seekInternal(originalPosition);
   }
 
   long long tell() const {
@@ -440,9 +586,15 @@ public:
   }
 
 private:
+  // The largest number of source frames decoded and passed to the resampler
+  // at once, which bounds the size of sourceBlock:
+  static constexpr long long MAX_SOURCE_FRAMES_PER_BLOCK = 65536;
+
   const std::shared_ptr<ReadableAudioFile> audioFile;
   StreamResampler<float> resampler;
   juce::AudioBuffer<float> outputBuffer;
+  // Scratch space for source frames, reused across calls to readInternal:
+  juce::AudioBuffer<float> sourceBlock;
   long long positionInTargetSampleRate = 0;
   juce::ReadWriteLock objectLock;
   bool _isClosed = false;
@@ -537,6 +689,39 @@ maximum sample value will be ``+1.0f``.
     For convenience, the ``num_frames`` argument may be a floating-point number. However, if the
     provided number of frames contains a fractional part (i.e.: ``1.01`` instead of ``1.00``) then
     an exception will be thrown, as a fractional number of samples cannot be returned.
+)")
+      .def("read_into", &ResampledReadableAudioFile::readInto, py::arg("out"),
+           py::arg("offset") = 0, R"(
+Read audio (at the target sample rate) from this file at its current position
+directly into ``out``, an existing C-contiguous ``float32``
+:class:`numpy.array` of shape ``(num_channels, frames)``, and return the
+number of frames read.
+
+Audio is written into ``out[:, offset:]``, reading as many frames as fit (or
+as remain in the file). Any frames past the end of the file are set to zero.
+Unlike :meth:`read`, no new array is returned, which makes :meth:`read_into`
+well suited to filling preallocated buffers in a loop.
+
+*Introduced in v0.9.22.*
+)")
+      .def("read_windows", &ResampledReadableAudioFile::readWindows,
+           py::arg("offsets"), py::arg("length"), R"(
+Read many windows of ``length`` frames (at the target sample rate) from this
+file at once, each starting at one of the provided ``offsets``, and return
+them as a single 32-bit floating-point :class:`numpy.array` of shape
+``(len(offsets), num_channels, length)``.
+
+This is equivalent to calling :meth:`seek` and :meth:`read` for each offset in
+turn, but runs in one native call without holding the GIL. Windows are read
+in order of their offsets, audio shared by overlapping windows is only
+resampled once, and short gaps between windows are read through rather than
+seeked over (as each seek requires resetting the resampler).
+
+Windows that extend past the end of the file are padded with zeros. Offsets
+must be between ``0`` and :py:attr:`frames` (inclusive). The read position of
+this file (as returned by :meth:`tell`) is not changed.
+
+*Introduced in v0.9.22.*
 )")
       .def("seekable", &ResampledReadableAudioFile::isSeekable,
            "Returns True if this file is currently open and calls to seek() "
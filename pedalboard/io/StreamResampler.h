@@ -28,122 +28,82 @@ public:
                   int numChannels, ResamplingQuality quality)
       : sourceSampleRate(sourceSampleRate), targetSampleRate(targetSampleRate),
         numChannels(numChannels), quality(quality) {
-    overflowSamples.resize(numChannels);
-    resamplers.resize(numChannels);
+    resampler.setQuality(quality);
+    resampler.setNumChannels(numChannels);
+    resampler.setSampleRates(sourceSampleRate, targetSampleRate);
+    resampler.reset();
 
-    for (int i = 0; i < numChannels; i++) {
-      resamplers[i].setQuality(quality);
-      resamplers[i].reset();
-    }
+    inputPointers.resize(numChannels);
+    outputPointers.resize(numChannels);
 
     resamplerRatio = sourceSampleRate / targetSampleRate;
-    inputLatency = resamplers[0].getBaseLatency();
+    inputLatency = resampler.getBaseLatency();
     outputLatency = inputLatency / resamplerRatio;
 
     outputSamplesToSkip = outputLatency;
   }
 
+  /**
+   * Resample the provided input (or flush the resampler, if no input is
+   * provided) and return a newly-allocated buffer containing all of the
+   * resampled audio that is ready.
+   */
   juce::AudioBuffer<SampleType>
-  process(std::optional<juce::AudioBuffer<SampleType>> &_input,
+  process(std::optional<juce::AudioBuffer<SampleType>> &input,
           double maxSamplesToReturn = 1e40) {
-    if (_input && _input->getNumChannels() != numChannels) {
-      throw std::domain_error(
-          "Expected " + std::to_string(numChannels) +
-          "-channel input, but was provided a buffer with " +
-          std::to_string(_input->getNumChannels()) + " channels and " +
-          std::to_string(_input->getNumSamples()) + " samples.");
-    }
+    checkNumInputChannels(input);
 
     std::scoped_lock lock(mutex);
+    long long numOutputSamples =
+        getNumOutputSamplesFor_unlocked(getNumSamples(input));
+    juce::AudioBuffer<SampleType> output(numChannels, (int)numOutputSamples);
+    process_unlocked(input, output);
+    return output;
+  }
 
-    juce::AudioBuffer<SampleType> input;
-    bool isFlushing = false;
-    int numNewInputSamples = 0;
-
-    if (_input) {
-      input = prependWith(*_input, overflowSamples);
-      numNewInputSamples = input.getNumSamples();
-    } else {
-      isFlushing = true;
-      int samplesToFlush = inputLatency;
-
-      input = juce::AudioBuffer<float>(numChannels, samplesToFlush);
-      inputSamplesBufferedInResampler = 0;
-      input.clear();
-      input = prependWith(input, overflowSamples);
-    }
-
-    double expectedResampledSamples =
-        std::max(0.0, ((totalSamplesInput + input.getNumSamples()) *
-                       targetSampleRate / sourceSampleRate) -
-                          totalSamplesOutput);
-
-    // TODO: Don't copy the entire input buffer multiple times here!
-    juce::AudioBuffer<SampleType> output(input.getNumChannels(),
-                                         (int)expectedResampledSamples);
-
-    for (size_t c = 0; c < input.getNumChannels(); c++) {
-      if (input.getNumSamples() > 0) {
-        long long inputSamplesConsumed = resamplers[c].process(
-            resamplerRatio, input.getReadPointer(c), output.getWritePointer(c),
-            (int)expectedResampledSamples);
-
-        if (c == 0) {
-          if (!isFlushing) {
-            totalSamplesInput += inputSamplesConsumed;
-          }
-          totalSamplesOutput += (int)expectedResampledSamples;
-        }
-
-        if (!isFlushing) {
-          for (int i = inputSamplesConsumed; i < input.getNumSamples(); i++) {
-            overflowSamples[c].push_back(input.getReadPointer(c)[i]);
-          }
-          if (c == 0) {
-            inputSamplesBufferedInResampler += inputSamplesConsumed;
-            if (inputSamplesBufferedInResampler > inputLatency) {
-              inputSamplesBufferedInResampler = inputLatency;
-            }
-          }
-        }
-      }
-    }
-
-    // Chop off the first _n_ samples if necessary:
-    if (outputSamplesToSkip > 0) {
-      long long intOutputSamplesToSkip = (int)std::round(outputSamplesToSkip);
-      if (intOutputSamplesToSkip) {
-        outputSamplesToSkip -=
-            std::min(intOutputSamplesToSkip, (long long)output.getNumSamples());
-
-        int newNumOutputSamples =
-            output.getNumSamples() - intOutputSamplesToSkip;
-        if (newNumOutputSamples <= 0) {
-          if (isFlushing) {
-            reset_unlocked();
-          }
-          return juce::AudioBuffer<SampleType>(input.getNumChannels(), 0);
-        }
-
-        juce::AudioBuffer<SampleType> choppedOutput(input.getNumChannels(),
-                                                    newNumOutputSamples);
-        for (int c = 0; c < numChannels; c++) {
-          choppedOutput.copyFrom(c, 0, output, c, intOutputSamplesToSkip,
-                                 newNumOutputSamples);
-        }
-
-        if (isFlushing) {
-          reset_unlocked();
-        }
-        return choppedOutput;
-      }
+  /**
+   * Resample the provided input (or flush the resampler, if no input is
+   * provided), writing the resampled audio directly into the provided output
+   * buffer (which may refer to memory owned by the caller) rather than
+   * allocating a new buffer.
+   *
+   * The output buffer must have room for at least as many samples as
+   * getNumOutputSamplesFor() reports; if it does not, an exception is thrown
+   * before any state is changed.
+   *
+   * @return the number of samples written to the start of each output channel.
+   */
+  long long process(std::optional<juce::AudioBuffer<SampleType>> &input,
+                    juce::AudioBuffer<SampleType> &output) {
+    checkNumInputChannels(input);
+    if (output.getNumChannels() != numChannels) {
+      throw std::domain_error(
+          "Expected " + std::to_string(numChannels) +
+          "-channel output, but was provided a buffer with " +
+          std::to_string(output.getNumChannels()) + " channels.");
     }
 
-    if (isFlushing) {
-      reset_unlocked();
+    std::scoped_lock lock(mutex);
+    long long numOutputSamples =
+        getNumOutputSamplesFor_unlocked(getNumSamples(input));
+    if (numOutputSamples > output.getNumSamples()) {
+      throw std::domain_error(
+          "The provided output buffer has room for " +
+          std::to_string(output.getNumSamples()) + " samples, but " +
+          std::to_string(numOutputSamples) +
+          " resampled samples would be returned.");
     }
+    return process_unlocked(input, output);
+  }
 
-    return output;
+  /**
+   * Returns the number of samples that the next call to process() will return
+   * if passed numInputSamples new input samples, or if flushed (if
+   * numInputSamples is empty).
+   */
+  long long getNumOutputSamplesFor(std::optional<long long> numInputSamples) {
+    std::scoped_lock lock(mutex);
+    return getNumOutputSamplesFor_unlocked(numInputSamples);
   }
 
   void reset() {
@@ -152,15 +112,12 @@ public:
   }
 
   void reset_unlocked() {
-    for (auto &r : resamplers) {
-      r.reset();
-    }
+    resampler.reset();
 
     inputSamplesBufferedInResampler = 0;
     outputSamplesToSkip = outputLatency;
-    for (auto &overflowBuffer : overflowSamples) {
-      overflowBuffer.clear();
-    }
+    overflowStart = 0;
+    numOverflowSamples = 0;
 
     totalSamplesInput = 0;
     totalSamplesOutput = 0;
@@ -179,7 +136,40 @@ public:
   }
 
   // TODO: Rename me!
-  int getOverflowSamples() const { return overflowSamples[0].size(); }
+  int getOverflowSamples() const { return numOverflowSamples; }
+
+  /**
+   * Returns the largest number of new input samples that can be passed to the
+   * next call to process() without it returning more than numOutputSamples
+   * samples, taking into account any overflow samples already held and any
+   * output latency that has yet to be skipped.
+   */
+  long long getMaxInputSamplesFor(long long numOutputSamples) {
+    std::scoped_lock lock(mutex);
+
+    long long samplesToSkip =
+        outputSamplesToSkip > 0 ? (long long)std::round(outputSamplesToSkip)
+                                : 0;
+    long long numInputSamples = std::max(
+        0LL, (long long)std::ceil((double)(totalSamplesOutput +
+                                           numOutputSamples + samplesToSkip +
+                                           1) *
+                                  resamplerRatio) -
+                 1 - totalSamplesInput - numOverflowSamples);
+
+    // Correct for any floating-point rounding in the estimate above by using
+    // the exact same calculation that process() will use:
+    while (numInputSamples > 0 &&
+           getNumOutputSamplesFor_unlocked(numInputSamples) >
+               numOutputSamples) {
+      numInputSamples--;
+    }
+    while (getNumOutputSamplesFor_unlocked(numInputSamples + 1) <=
+           numOutputSamples) {
+      numInputSamples++;
+    }
+    return numInputSamples;
+  }
 
   /**
    * Advance the internal state of this resampler, as if the given
@@ -189,6 +179,17 @@ public:
    * the resampler, but will not clear all of the samples buffered internally.
    */
   long long advanceResamplerState(long long numOutputSamples) {
+    if (resampler.isPolyphase(resamplerRatio)) {
+      // Polyphase resamplers track their position exactly, so can be advanced
+      // in constant time:
+      long long numInputSamplesUsed =
+          resampler.advancePolyphase(numOutputSamples);
+
+      totalSamplesOutput += numOutputSamples;
+      totalSamplesInput += numInputSamplesUsed;
+      return numInputSamplesUsed;
+    }
+
     double newSubSamplePos = 1.0;
     long long numOutputSamplesToProduce = numOutputSamples;
 
@@ -236,10 +237,13 @@ public:
     }
 
     float zero = 0.0;
-    for (auto &resampler : resamplers) {
-      // This effectively sets the new subsample position:
-      resampler.process(newSubSamplePos, &zero, &zero, 1);
-    }
+    float discarded = 0.0;
+    std::vector<const float *> zeroInputs(numChannels, &zero);
+    std::vector<float *> discardedOutputs(numChannels, &discarded);
+
+    // This effectively sets the new subsample position:
+    resampler.process(newSubSamplePos, zeroInputs.data(),
+                      discardedOutputs.data(), 1);
 
     totalSamplesOutput += numOutputSamples;
     totalSamplesInput += numInputSamplesUsed;
@@ -254,33 +258,264 @@ public:
   }
 
 private:
-  juce::AudioBuffer<SampleType>
-  prependWith(juce::AudioBuffer<SampleType> &input,
-              std::vector<std::vector<SampleType>> &toPrepend) {
-    int prependSize = toPrepend[0].size();
-    juce::AudioBuffer<SampleType> output(input.getNumChannels(),
-                                         input.getNumSamples() + prependSize);
-
-    for (int c = 0; c < input.getNumChannels(); c++) {
-      SampleType *channelPointer = output.getWritePointer(c);
-      for (int i = 0; i < prependSize; i++) {
-        channelPointer[i] = toPrepend[c][i];
+  void checkNumInputChannels(
+      const std::optional<juce::AudioBuffer<SampleType>> &input) const {
+    if (input && input->getNumChannels() != numChannels) {
+      throw std::domain_error(
+          "Expected " + std::to_string(numChannels) +
+          "-channel input, but was provided a buffer with " +
+          std::to_string(input->getNumChannels()) + " channels and " +
+          std::to_string(input->getNumSamples()) + " samples.");
+    }
+  }
+
+  static std::optional<long long>
+  getNumSamples(const std::optional<juce::AudioBuffer<SampleType>> &input) {
+    if (input)
+      return input->getNumSamples();
+    return {};
+  }
+
+  /**
+   * Returns the number of output samples the resampler will produce (before
+   * any latency is skipped) if given numInputSamples new input samples, or
+   * if flushed (if numInputSamples is empty).
+   */
+  long long
+  getNumResampledSamples_unlocked(std::optional<long long> numInputSamples) {
+    long long totalInputSamples =
+        numOverflowSamples +
+        (numInputSamples ? *numInputSamples : getNumFlushSamples());
+    if (totalInputSamples == 0)
+      return 0;
+
+    return (long long)std::max(0.0,
+                               ((totalSamplesInput + totalInputSamples) *
+                                targetSampleRate / sourceSampleRate) -
+                                   totalSamplesOutput);
+  }
+
+  long long getNumOutputSamplesToSkip_unlocked(long long numResampledSamples) {
+    if (outputSamplesToSkip <= 0)
+      return 0;
+    return std::min((long long)std::round(outputSamplesToSkip),
+                    numResampledSamples);
+  }
+
+  long long
+  getNumOutputSamplesFor_unlocked(std::optional<long long> numInputSamples) {
+    long long numResampledSamples =
+        getNumResampledSamples_unlocked(numInputSamples);
+    return numResampledSamples -
+           getNumOutputSamplesToSkip_unlocked(numResampledSamples);
+  }
+
+  int getNumFlushSamples() const { return (int)inputLatency; }
+
+  long long
+  process_unlocked(std::optional<juce::AudioBuffer<SampleType>> &input,
+                   juce::AudioBuffer<SampleType> &output) {
+    const bool isFlushing = !input;
+    const long long numNewInputSamples =
+        isFlushing ? getNumFlushSamples() : input->getNumSamples();
+    const long long numResampledSamples =
+        getNumResampledSamples_unlocked(getNumSamples(input));
+    const long long numSamplesToSkip =
+        getNumOutputSamplesToSkip_unlocked(numResampledSamples);
+
+    if (isFlushing) {
+      inputSamplesBufferedInResampler = 0;
+      if (silence.getNumSamples() < numNewInputSamples) {
+        silence.setSize(numChannels, (int)numNewInputSamples);
+        silence.clear();
       }
-      toPrepend[c].clear();
+    }
 
-      output.copyFrom(c, prependSize, input, c, 0, input.getNumSamples());
+    if (numSamplesToSkip > skippedSamples.getNumSamples())
+      skippedSamples.setSize(numChannels, (int)numSamplesToSkip);
+
+    long long inputSamplesConsumed = 0;
+    if (numOverflowSamples + numNewInputSamples > 0) {
+      inputSamplesConsumed = resampleChannels(
+          isFlushing ? silence.getArrayOfReadPointers()
+                     : input->getArrayOfReadPointers(),
+          numNewInputSamples, numResampledSamples, numSamplesToSkip,
+          output.getArrayOfWritePointers());
+      totalSamplesOutput += numResampledSamples;
     }
 
-    return output;
+    outputSamplesToSkip -= numSamplesToSkip;
+
+    if (isFlushing) {
+      reset_unlocked();
+    } else {
+      totalSamplesInput += inputSamplesConsumed;
+      inputSamplesBufferedInResampler = (int)std::min(
+          (double)inputSamplesBufferedInResampler + inputSamplesConsumed,
+          inputLatency);
+
+      // Keep any input samples the resampler didn't use for the next call:
+      int samplesUsedFromOverflow =
+          (int)std::min(inputSamplesConsumed, (long long)numOverflowSamples);
+      removeFromOverflow(samplesUsedFromOverflow);
+
+      long long newSamplesUsed = inputSamplesConsumed - samplesUsedFromOverflow;
+      if (newSamplesUsed < numNewInputSamples) {
+        appendToOverflow(*input, newSamplesUsed,
+                         numNewInputSamples - newSamplesUsed);
+      }
+    }
+
+    return numResampledSamples - numSamplesToSkip;
+  }
+
+  /**
+   * Run the resampler over the overflow samples for every channel, followed
+   * by newInputs, to produce numResampledSamples samples per channel. The
+   * first numSamplesToSkip of those are discarded and the rest are written to
+   * outputs.
+   *
+   * @return the number of input samples consumed from each channel, including
+   * overflow samples.
+   */
+  long long resampleChannels(const SampleType *const *newInputs,
+                             long long numNewInputSamples,
+                             long long numResampledSamples,
+                             long long numSamplesToSkip,
+                             SampleType *const *outputs) {
+    // Resample numSamples output samples (all of which are either skipped or
+    // kept) starting at output sample i, reading from the given offset into
+    // each channel of input:
+    auto resample = [&](const SampleType *const *inputs, long long offset,
+                        long long i, long long numSamples) {
+      for (int c = 0; c < numChannels; c++) {
+        inputPointers[c] = inputs[c] + offset;
+        outputPointers[c] = i < numSamplesToSkip
+                                ? skippedSamples.getWritePointer(c) + i
+                                : outputs[c] + (i - numSamplesToSkip);
+      }
+      return (long long)resampler.process(resamplerRatio, inputPointers.data(),
+                                          outputPointers.data(),
+                                          (int)numSamples);
+    };
+
+    long long samplesConsumed = 0;
+    long long i = 0;
+
+    if (numOverflowSamples > 0) {
+      // The resampler needs contiguous input, so copy the (few) overflow
+      // samples into a staging buffer, followed by just enough new input to
+      // produce one more output sample. Produce one output sample at a time
+      // until the resampler has consumed every overflow sample, after which
+      // it can read directly from newInputs.
+      int numNewSamplesToStage = (int)std::min(
+          numNewInputSamples, (long long)std::ceil(resamplerRatio) + 1);
+      stagingSamples.setSize(numChannels,
+                             numOverflowSamples + numNewSamplesToStage, false,
+                             false, true);
+      for (int c = 0; c < numChannels; c++) {
+        copyFromOverflow(c, stagingSamples.getWritePointer(c));
+        std::copy_n(newInputs[c], numNewSamplesToStage,
+                    stagingSamples.getWritePointer(c) + numOverflowSamples);
+      }
+
+      for (; i < numResampledSamples && samplesConsumed < numOverflowSamples;
+           i++) {
+        samplesConsumed += resample(stagingSamples.getArrayOfReadPointers(),
+                                    samplesConsumed, i, 1);
+      }
+    }
+
+    if (i < numResampledSamples) {
+      // From here on, every overflow sample has been consumed, so the
+      // resampler can read directly from newInputs:
+      long long offset = samplesConsumed - numOverflowSamples;
+
+      if (i < numSamplesToSkip) {
+        long long samplesToSkip = numSamplesToSkip - i;
+        long long consumed = resample(newInputs, offset, i, samplesToSkip);
+        offset += consumed;
+        samplesConsumed += consumed;
+        i += samplesToSkip;
+      }
+
+      if (i < numResampledSamples) {
+        samplesConsumed +=
+            resample(newInputs, offset, i, numResampledSamples - i);
+      }
+    }
+
+    return samplesConsumed;
+  }
+
+  void copyFromOverflow(int channel, SampleType *destination) const {
+    const int capacity = overflowSamples.getNumSamples();
+    const SampleType *ring = overflowSamples.getReadPointer(channel);
+    int firstChunkSize = std::min(numOverflowSamples, capacity - overflowStart);
+    std::copy_n(ring + overflowStart, firstChunkSize, destination);
+    std::copy_n(ring, numOverflowSamples - firstChunkSize,
+                destination + firstChunkSize);
+  }
+
+  void removeFromOverflow(int numSamples) {
+    if (numSamples == 0)
+      return;
+    overflowStart =
+        (overflowStart + numSamples) % overflowSamples.getNumSamples();
+    numOverflowSamples -= numSamples;
+  }
+
+  void appendToOverflow(const juce::AudioBuffer<SampleType> &source,
+                        long long startSample, long long numSamples) {
+    int capacity = overflowSamples.getNumSamples();
+    if (numOverflowSamples + numSamples > capacity) {
+      // Grow (and unwrap) the ring buffer:
+      int newCapacity = (int)std::max((long long)capacity * 2,
+                                      numOverflowSamples + numSamples);
+      juce::AudioBuffer<SampleType> newOverflowSamples(numChannels,
+                                                       newCapacity);
+      for (int c = 0; c < numChannels; c++) {
+        copyFromOverflow(c, newOverflowSamples.getWritePointer(c));
+      }
+      overflowSamples = std::move(newOverflowSamples);
+      overflowStart = 0;
+      capacity = newCapacity;
+    }
+
+    int writePosition = (overflowStart + numOverflowSamples) % capacity;
+    int firstChunkSize =
+        (int)std::min(numSamples, (long long)(capacity - writePosition));
+    for (int c = 0; c < numChannels; c++) {
+      const SampleType *channelSource = source.getReadPointer(c, startSample);
+      SampleType *ring = overflowSamples.getWritePointer(c);
+      std::copy_n(channelSource, firstChunkSize, ring + writePosition);
+      std::copy_n(channelSource + firstChunkSize, numSamples - firstChunkSize,
+                  ring);
+    }
+    numOverflowSamples += numSamples;
   }
 
   double sourceSampleRate;
   double targetSampleRate;
   ResamplingQuality quality;
-  std::vector<VariableQualityResampler> resamplers;
+  VariableQualityResampler resampler;
 
   double resamplerRatio = 1.0;
-  std::vector<std::vector<SampleType>> overflowSamples;
+
+  // Input samples that have been passed to process() but not yet consumed
+  // by the resampler, stored as a ring buffer of numOverflowSamples samples
+  // per channel starting at overflowStart:
+  juce::AudioBuffer<SampleType> overflowSamples;
+  int overflowStart = 0;
+  int numOverflowSamples = 0;
+
+  // Scratch space reused across calls to process():
+  juce::AudioBuffer<SampleType> stagingSamples;
+  juce::AudioBuffer<SampleType> skippedSamples;
+  juce::AudioBuffer<SampleType> silence;
+  std::vector<const SampleType *> inputPointers;
+  std::vector<SampleType *> outputPointers;
+
   double inputLatency = 0;
   double outputLatency = 0;
 
@@ -298,6 +533,54 @@ private:
   std::optional<ChannelLayout> lastChannelLayout = {};
 };
 
+/**
+ * Check that the provided NumPy array can be written into by
+ * StreamResampler.process, given the number of channels and channel layout
+ * of the audio being resampled.
+ */
+inline py::array_t<float, py::array::c_style>
+asStreamResamplerOutputArray(py::array outputArray, int numChannels,
+                             ChannelLayout layout) {
+  if (outputArray.dtype().char_() != 'f') {
+    throw py::type_error("StreamResampler can only write resampled audio into "
+                         "a 32-bit floating point array, but the provided "
+                         "output array has dtype " +
+                         py::str(outputArray.dtype()).cast<std::string>() +
+                         ".");
+  }
+
+  if (!(outputArray.flags() & py::array::c_style)) {
+    throw std::domain_error(
+        "The provided output array must be C-contiguous. (Try passing "
+        "numpy.ascontiguousarray(...) instead.)");
+  }
+
+  if (!outputArray.writeable()) {
+    throw std::domain_error("The provided output array is not writeable.");
+  }
+
+  bool shapeMatches;
+  if (outputArray.ndim() == 1) {
+    shapeMatches = numChannels == 1;
+  } else if (outputArray.ndim() == 2) {
+    shapeMatches = layout == ChannelLayout::Interleaved
+                       ? outputArray.shape(1) == numChannels
+                       : outputArray.shape(0) == numChannels;
+  } else {
+    shapeMatches = false;
+  }
+
+  if (!shapeMatches) {
+    throw std::domain_error(
+        "The provided output array must have " + std::to_string(numChannels) +
+        " channel(s) in the same layout as the input, but has shape " +
+        py::str(outputArray.attr("shape")).cast<std::string>() + ".");
+  }
+
+  return py::reinterpret_borrow<py::array_t<float, py::array::c_style>>(
+      outputArray);
+}
+
 inline void init_stream_resampler(py::module &m) {
   py::class_<StreamResampler<float>, std::shared_ptr<StreamResampler<float>>>
       resampler(
@@ -359,7 +642,8 @@ inline void init_stream_resampler(py::module &m) {
   resampler.def(
       "process",
       [](StreamResampler<float> &resampler,
-         std::optional<py::array_t<float, py::array::c_style>> input) {
+         std::optional<py::array_t<float, py::array::c_style>> input,
+         std::optional<py::array> out) {
         std::optional<juce::AudioBuffer<float>> inputBuffer;
         if (input) {
           std::optional<ChannelLayout> layout =
@@ -375,20 +659,56 @@ inline void init_stream_resampler(py::module &m) {
           inputBuffer = convertPyArrayIntoJuceBuffer(*input, *layout);
         }
 
-        juce::AudioBuffer<float> output;
+        if (!out) {
+          juce::AudioBuffer<float> output;
+          {
+            py::gil_scoped_release release;
+            output = resampler.process(inputBuffer);
+          }
+
+          return copyJuceBufferIntoPyArray(
+              output, *resampler.getLastChannelLayout(), 0);
+        }
+
+        ChannelLayout layout = resampler.getLastChannelLayout().value_or(
+            ChannelLayout::NotInterleaved);
+        py::array_t<float, py::array::c_style> outputArray =
+            asStreamResamplerOutputArray(*out, resampler.getNumChannels(),
+                                         layout);
+
+        // Planar output arrays can be written into directly; interleaved
+        // arrays need to be interleaved from a temporary buffer.
+        juce::AudioBuffer<float> outputBuffer =
+            layout == ChannelLayout::NotInterleaved
+                ? juce::AudioBuffer<float>(
+                      convertPyArrayIntoJuceBuffer(outputArray, layout))
+                : juce::AudioBuffer<float>(resampler.getNumChannels(),
+                                           outputArray.shape(0));
+
+        long long numSamplesWritten;
         {
           py::gil_scoped_release release;
-          output = resampler.process(inputBuffer);
+          numSamplesWritten = resampler.process(inputBuffer, outputBuffer);
         }
 
-        return copyJuceBufferIntoPyArray(output,
-                                         *resampler.getLastChannelLayout(), 0);
+        return copyJuceBufferIntoExistingPyArray(
+            juce::AudioBuffer<float>(outputBuffer.getArrayOfWritePointers(),
+                                     outputBuffer.getNumChannels(),
+                                     (int)numSamplesWritten),
+            layout, 0, outputArray);
       },
-      py::arg("input") = py::none(),
+      py::arg("input") = py::none(), py::arg("out") = py::none(),
       "Resample a 32-bit floating-point audio buffer. The returned buffer may "
       "be smaller than the provided buffer depending on the quality method "
       "used. Call :meth:`process()` without any arguments to flush the "
-      "internal buffers and return all remaining audio.");
+      "internal buffers and return all remaining audio.\n\nIf ``out`` is "
+      "provided, the resampled audio will be written into it (and a view of "
+      "the portion that was written returned) instead of allocating a new "
+      "array. ``out`` must be a C-contiguous ``float32`` array with the same "
+      "channel layout as the input and room for at least as many samples as "
+      "will be returned; if it is too small, an exception is raised and no "
+      "audio is consumed.\n\n*The ``out`` argument was introduced in "
+      "v0.9.22.*");
 
   resampler.def("reset", &StreamResampler<float>::reset,
                 "Used to reset the internal state of this resampler. Call this "
@@ -0,0 +1,134 @@
+/*
+ * pedalboard
+ * Copyright 2025 Spotify AB
+ *
+ * Licensed under the GNU Public License, Version 3.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    https://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Pedalboard {
+
+/**
+ * Runs tasks (i.e.: encoding chunks of audio) in order on a background
+ * thread, allowing a writer to hand off each chunk and continue producing
+ * the next one. At most maxQueuedTasks tasks may be waiting at once; push()
+ * blocks until there's room for another.
+ *
+ * If a task throws, all tasks queued after it are discarded and the
+ * exception is re-thrown (once) by the next call to push() or drain().
+ */
+class WriteBehindQueue {
+public:
+  using Task = std::function<void()>;
+
+  explicit WriteBehindQueue(size_t maxQueuedTasks)
+      : maxQueuedTasks(std::max<size_t>(1, maxQueuedTasks)) {
+    thread = std::thread(&WriteBehindQueue::runLoop, this);
+  }
+
+  /**
+   * Stop the background thread after its current task completes,
+   * discarding any tasks that have not yet started. Call drain() first to
+   * wait for every queued task to run.
+   */
+  ~WriteBehindQueue() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopRequested = true;
+    }
+    condition.notify_all();
+    thread.join();
+  }
+
+  WriteBehindQueue(const WriteBehindQueue &) = delete;
+  WriteBehindQueue &operator=(const WriteBehindQueue &) = delete;
+
+  void push(Task task) {
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock,
+                   [this] { return error || tasks.size() < maxQueuedTasks; });
+    rethrowError();
+    tasks.push_back(std::move(task));
+    condition.notify_all();
+  }
+
+  /**
+   * Block until every queued task has run, re-throwing the first exception
+   * thrown by any of them (if it has not already been re-thrown).
+   */
+  void drain() {
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [this] { return tasks.empty() && !taskRunning; });
+    rethrowError();
+  }
+
+private:
+  // Must be called with the mutex held.
+  void rethrowError() {
+    if (error) {
+      std::exception_ptr toThrow = error;
+      error = nullptr;
+      std::rethrow_exception(toThrow);
+    }
+  }
+
+  void runLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      condition.wait(lock, [this] { return stopRequested || !tasks.empty(); });
+      if (stopRequested)
+        return;
+
+      Task task = std::move(tasks.front());
+      tasks.pop_front();
+      taskRunning = true;
+      lock.unlock();
+
+      std::exception_ptr taskError;
+      try {
+        task();
+      } catch (...) {
+        taskError = std::current_exception();
+      }
+
+      lock.lock();
+      taskRunning = false;
+      if (taskError) {
+        error = taskError;
+        tasks.clear();
+      }
+      condition.notify_all();
+    }
+  }
+
+  const size_t maxQueuedTasks;
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::deque<Task> tasks;
+  bool taskRunning = false;
+  bool stopRequested = false;
+  std::exception_ptr error;
+  std::thread thread;
+};
+
+} // namespace Pedalboard
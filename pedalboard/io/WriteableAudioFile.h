@@ -25,9 +25,11 @@
 
 #include "../BufferUtils.h"
 #include "../JuceHeader.h"
+#include "../ScratchArena.h"
 #include "AudioFile.h"
 #include "LameMP3AudioFormat.h"
 #include "PythonOutputStream.h"
+#include "WriteBehindQueue.h"
 
 namespace py = pybind11;
 
@@ -222,15 +224,17 @@ public:
   WriteableAudioFile(
       std::string filename, double writeSampleRate, int numChannels = 1,
       int bitDepth = 16,
-      std::optional<std::variant<std::string, float>> qualityInput = {})
+      std::optional<std::variant<std::string, float>> qualityInput = {},
+      int queueSize = 0)
       : WriteableAudioFile(filename, nullptr, writeSampleRate, numChannels,
-                           bitDepth, qualityInput) {}
+                           bitDepth, qualityInput, queueSize) {}
 
   WriteableAudioFile(
       std::string filename,
       std::unique_ptr<juce::OutputStream> providedOutputStream,
       double writeSampleRate, int numChannels = 1, int bitDepth = 16,
-      std::optional<std::variant<std::string, float>> qualityInput = {}) {
+      std::optional<std::variant<std::string, float>> qualityInput = {},
+      int queueSize = 0) {
     pybind11::gil_scoped_release release;
 
     // This is kind of silly, as nobody else has a reference
@@ -252,6 +256,19 @@ public:
                               "non-zero num_channels.");
     }
 
+    if (queueSize < 0) {
+      throw std::domain_error("queue_size must be greater than or equal to "
+                              "zero, but was " +
+                              std::to_string(queueSize) + ".");
+    }
+
+    if (queueSize > 0 && providedOutputStream) {
+      // Writing to a Python file-like object requires the GIL, which would
+      // prevent encoding from overlapping with the caller's work:
+      throw py::type_error("queue_size is only supported when writing to a "
+                           "filename, not a file-like object.");
+    }
+
     // Tiny quality-of-life improvement to try to detect if people have swapped
     // the num_channels and samplerate arguments:
     if ((numChannels == 48000 || numChannels == 44100 || numChannels == 22050 ||
@@ -433,6 +450,10 @@ public:
         writer.reset();
         throw;
       }
+
+      this->queueSize = queueSize;
+      if (queueSize > 0)
+        writeBehindQueue = std::make_unique<WriteBehindQueue>(queueSize);
     }
   }
 
@@ -440,6 +461,12 @@ public:
     // We need to release the writer here, as it may call .write() in its
     // destructor, and we need to hold the ScopedWriteLock if it does:
     juce::ScopedWriteLock writeLock(objectLock);
+    try {
+      stopEncoding();
+    } catch (...) {
+      // There's nowhere to report an encoder error from a destructor; close()
+      // should be called (i.e.: by using a context manager) to surface it.
+    }
     writer.reset();
   }
 
@@ -539,37 +566,45 @@ public:
           std::to_string(numChannels) + "-channel audio!");
     }
 
+    // Only one thread may use this object's scratch buffers at a time:
+    std::unique_lock<std::mutex> scratchLock(scratchMutex, std::try_to_lock);
+    if (!scratchLock.owns_lock()) {
+      throw std::runtime_error(
+          "Another thread is currently writing to this AudioFile. Note "
+          "that using multiple concurrent writers on the same AudioFile "
+          "object will produce nondeterministic results.");
+    }
+
     // Depending on the input channel layout, we need to copy data
     // differently. This loop is duplicated here to move the if statement
     // outside of the tight loop, as we don't need to re-check that the input
     // channel is still the same on every iteration of the loop.
     switch (*lastChannelLayout) {
     case ChannelLayout::Interleaved: {
-      std::vector<std::vector<SampleType>> deinterleaveBuffers;
-
       // Use a temporary buffer to chunk the audio input
       // and pass it into the writer, chunk by chunk, rather
       // than de-interleaving the entire buffer at once:
-      deinterleaveBuffers.resize(numChannels);
+      deinterleaveScratch.rewind();
 
       const SampleType **channelPointers =
           (const SampleType **)alloca(numChannels * sizeof(SampleType *));
+      SampleType **deinterleavePointers =
+          (SampleType **)alloca(numChannels * sizeof(SampleType *));
+      for (int c = 0; c < numChannels; c++) {
+        deinterleavePointers[c] = deinterleaveScratch.allocate<SampleType>(
+            std::min(numSamples, DEFAULT_AUDIO_BUFFER_SIZE_FRAMES));
+        channelPointers[c] = deinterleavePointers[c];
+      }
+
       for (int startSample = 0; startSample < numSamples;
            startSample += DEFAULT_AUDIO_BUFFER_SIZE_FRAMES) {
         int samplesToWrite = std::min(numSamples - startSample,
                                       DEFAULT_AUDIO_BUFFER_SIZE_FRAMES);
 
-        for (int c = 0; c < numChannels; c++) {
-          deinterleaveBuffers[c].resize(samplesToWrite);
-          channelPointers[c] = deinterleaveBuffers[c].data();
-
-          // We're de-interleaving the data here, so we can't use copyFrom.
-          for (unsigned int i = 0; i < samplesToWrite; i++) {
-            deinterleaveBuffers[c][i] =
-                ((SampleType
-                      *)(inputInfo.ptr))[((i + startSample) * numChannels) + c];
-          }
-        }
+        // We're de-interleaving the data here, so we can't use copyFrom.
+        deinterleaveSamples(((const SampleType *)(inputInfo.ptr)) +
+                                ((size_t)startSample * numChannels),
+                            deinterleavePointers, numChannels, samplesToWrite);
 
         bool writeSuccessful =
             write(channelPointers, numChannels, samplesToWrite);
@@ -620,18 +655,26 @@ public:
             unsigned int bufferSize = DEFAULT_AUDIO_BUFFER_SIZE_FRAMES>
   bool writeConvertingTo(const InputType **channels, int numChannels,
                          unsigned int numSamples) {
-    std::vector<std::vector<TargetType>> targetTypeBuffers;
-    targetTypeBuffers.resize(numChannels);
+    // Must be called with scratchMutex held. This may be called recursively
+    // (i.e.: converting short to int, then int to float), so only release the
+    // memory allocated by this call once it returns:
+    ScratchArena::Scope conversionScope(conversionScratch);
 
+    TargetType **targetTypeBuffers =
+        (TargetType **)alloca(numChannels * sizeof(TargetType *));
     const TargetType **channelPointers =
         (const TargetType **)alloca(numChannels * sizeof(TargetType *));
+    for (int c = 0; c < numChannels; c++) {
+      targetTypeBuffers[c] = conversionScratch.allocate<TargetType>(
+          std::min(numSamples, bufferSize));
+      channelPointers[c] = targetTypeBuffers[c];
+    }
+
     for (unsigned int startSample = 0; startSample < numSamples;
          startSample += bufferSize) {
       int samplesToWrite = std::min(numSamples - startSample, bufferSize);
 
       for (int c = 0; c < numChannels; c++) {
-        targetTypeBuffers[c].resize(samplesToWrite);
-        channelPointers[c] = targetTypeBuffers[c].data();
 
         if constexpr (std::is_integral<InputType>::value) {
           if constexpr (std::is_integral<TargetType>::value) {
@@ -646,7 +689,7 @@ public:
             constexpr auto scaleFactor =
                 1.0f / static_cast<float>(std::numeric_limits<int>::max());
             juce::FloatVectorOperations::convertFixedToFloat(
-                targetTypeBuffers[c].data(), channels[c] + startSample,
+                targetTypeBuffers[c], channels[c] + startSample,
                 scaleFactor, samplesToWrite);
           } else {
             // We should never get here - this would only be true
@@ -687,14 +730,7 @@ public:
         if (writer->isFloatingPoint()) {
           return writeConvertingTo<float>(channels, numChannels, numSamples);
         } else {
-          ScopedTryWriteLock scopedTryWriteLock(objectLock);
-          if (!scopedTryWriteLock.isLocked()) {
-            throw std::runtime_error(
-                "Another thread is currently writing to this AudioFile. Note "
-                "that using multiple concurrent writers on the same AudioFile "
-                "object will produce nondeterministic results.");
-          }
-          return writer->write(channels, numSamples);
+          return writeToWriter(channels, numChannels, numSamples);
         }
       } else {
         return writeConvertingTo<int>(channels, numChannels, numSamples);
@@ -704,24 +740,10 @@ public:
         // Just pass the floating point data into the writer as if it were
         // integer data. If the writer requires floating-point input data, this
         // works (and is documented!)
-        ScopedTryWriteLock scopedTryWriteLock(objectLock);
-        if (!scopedTryWriteLock.isLocked()) {
-          throw std::runtime_error(
-              "Another thread is currently writing to this AudioFile. Note "
-              "that using multiple concurrent writers on the same AudioFile "
-              "object will produce nondeterministic results.");
-        }
-        return writer->write((const int **)channels, numSamples);
+        return writeToWriter((const int **)channels, numChannels, numSamples);
       } else {
         // Convert floating-point to fixed point, but let JUCE do that for us:
-        ScopedTryWriteLock scopedTryWriteLock(objectLock);
-        if (!scopedTryWriteLock.isLocked()) {
-          throw std::runtime_error(
-              "Another thread is currently writing to this AudioFile. Note "
-              "that using multiple concurrent writers on the same AudioFile "
-              "object will produce nondeterministic results.");
-        }
-        return writer->writeFromFloatArrays(channels, numChannels, numSamples);
+        return writeToWriter(channels, numChannels, numSamples);
       }
     } else {
       // We must have double-format data:
@@ -729,6 +751,60 @@ public:
     }
   }
 
+  /**
+   * Pass audio in the format expected by the writer (integers, or floats
+   * punned as integers) to the writer, or pass floats to be converted to
+   * fixed-point by JUCE. If encoding happens in the background, the audio
+   * is copied into the queue and this method returns immediately.
+   */
+  template <typename SampleType>
+  bool writeToWriter(const SampleType **channels, int numChannels,
+                     unsigned int numSamples) {
+    if (writeBehindQueue) {
+      std::vector<SampleType> chunk((size_t)numChannels * numSamples);
+      for (int c = 0; c < numChannels; c++) {
+        std::copy_n(channels[c], numSamples, chunk.data() + (c * numSamples));
+      }
+
+      // The queue's thread is the only thread that touches the writer until
+      // the queue is drained, so it doesn't need to take the object lock:
+      writeBehindQueue->push(
+          [this, chunk = std::move(chunk), numChannels, numSamples]() {
+            const SampleType **chunkPointers = (const SampleType **)alloca(
+                numChannels * sizeof(SampleType *));
+            for (int c = 0; c < numChannels; c++) {
+              chunkPointers[c] = chunk.data() + (c * numSamples);
+            }
+
+            if (!callWriter(chunkPointers, numChannels, numSamples)) {
+              throw std::runtime_error("Unable to write data to audio file.");
+            }
+          });
+      return true;
+    }
+
+    ScopedTryWriteLock scopedTryWriteLock(objectLock);
+    if (!scopedTryWriteLock.isLocked()) {
+      throw std::runtime_error(
+          "Another thread is currently writing to this AudioFile. Note "
+          "that using multiple concurrent writers on the same AudioFile "
+          "object will produce nondeterministic results.");
+    }
+    return callWriter(channels, numChannels, numSamples);
+  }
+
+  template <typename SampleType>
+  bool callWriter(const SampleType **channels, int numChannels,
+                  unsigned int numSamples) {
+    if constexpr (std::is_same<SampleType, int>::value) {
+      return writer->write(channels, numSamples);
+    } else {
+      static_assert(std::is_same<SampleType, float>::value,
+                    "Only int and float data can be passed to the writer");
+      return writer->writeFromFloatArrays(channels, numChannels, numSamples);
+    }
+  }
+
   void flush() {
     const juce::ScopedReadLock scopedReadLock(objectLock);
     if (!writer)
@@ -745,6 +821,8 @@ public:
             "that using multiple concurrent writers on the same AudioFile "
             "object will produce nondeterministic results.");
       }
+      if (writeBehindQueue)
+        writeBehindQueue->drain();
       flushSucceeded = writer->flush();
     }
 
@@ -766,7 +844,18 @@ public:
           "Another thread is currently writing to this AudioFile; it cannot "
           "be closed until the other thread completes its operation.");
     }
+
+    // Close the file even if the encoder failed, but still report the error:
+    std::exception_ptr encoderError;
+    try {
+      stopEncoding();
+    } catch (...) {
+      encoderError = std::current_exception();
+    }
     writer.reset();
+
+    if (encoderError)
+      std::rethrow_exception(encoderError);
   }
 
   bool isClosed() const {
@@ -803,6 +892,8 @@ public:
 
   std::optional<std::string> getQuality() const { return quality; }
 
+  int getQueueSize() const { return queueSize; }
+
   long getNumChannels() const {
     const juce::ScopedReadLock scopedReadLock(objectLock);
     if (!writer)
@@ -869,6 +960,24 @@ public:
   }
 
 private:
+  /**
+   * Wait for any audio queued for encoding to be passed to the writer, then
+   * stop the encoding thread, re-throwing the first error it encountered.
+   * The GIL is released (if held) while waiting.
+   */
+  void stopEncoding() {
+    if (!writeBehindQueue)
+      return;
+
+    std::unique_ptr<WriteBehindQueue> queue = std::move(writeBehindQueue);
+    if (PyGILState_Check()) {
+      py::gil_scoped_release release;
+      queue->drain();
+    } else {
+      queue->drain();
+    }
+  }
+
   juce::AudioFormatManager formatManager;
   std::string filename;
   std::optional<std::string> quality;
@@ -877,6 +986,15 @@ private:
   juce::ReadWriteLock objectLock;
   int framesWritten = 0;
   std::optional<ChannelLayout> lastChannelLayout = {};
+  int queueSize = 0;
+  std::unique_ptr<WriteBehindQueue> writeBehindQueue;
+
+  // Temporary buffers reused across calls to write() to avoid allocating on
+  // every write. These are bounded by DEFAULT_AUDIO_BUFFER_SIZE_FRAMES frames
+  // per channel, and freed along with this object.
+  std::mutex scratchMutex;
+  ScratchArena deinterleaveScratch;
+  ScratchArena conversionScratch;
 };
 
 inline py::class_<WriteableAudioFile, AudioFile,
@@ -939,8 +1057,8 @@ inline void init_writeable_audio_file(
   pyWriteableAudioFile
       .def(py::init([](std::string filename, double sampleRate, int numChannels,
                        int bitDepth,
-                       std::optional<std::variant<std::string, float>> quality)
-                        -> WriteableAudioFile * {
+                       std::optional<std::variant<std::string, float>> quality,
+                       int queueSize) -> WriteableAudioFile * {
              // This definition is only here to provide nice docstrings.
              throw std::runtime_error(
                  "Internal error: __init__ should never be called, as this "
@@ -948,7 +1066,7 @@ inline void init_writeable_audio_file(
            }),
            py::arg("filename"), py::arg("samplerate"),
            py::arg("num_channels") = 1, py::arg("bit_depth") = 16,
-           py::arg("quality") = py::none())
+           py::arg("quality") = py::none(), py::arg("queue_size") = 0)
       .def(py::init(
                [](py::object filelike, double sampleRate, int numChannels,
                   int bitDepth,
@@ -966,18 +1084,21 @@ inline void init_writeable_audio_file(
           "__new__",
           [](const py::object *, std::string filename,
              std::optional<double> sampleRate, int numChannels, int bitDepth,
-             std::optional<std::variant<std::string, float>> quality) {
+             std::optional<std::variant<std::string, float>> quality,
+             int queueSize) {
             if (!sampleRate) {
               throw py::type_error(
                   "Opening an audio file for writing requires a samplerate "
                   "argument to be provided.");
             }
             return std::make_shared<WriteableAudioFile>(
-                filename, *sampleRate, numChannels, bitDepth, quality);
+                filename, *sampleRate, numChannels, bitDepth, quality,
+                queueSize);
           },
           py::arg("cls"), py::arg("filename"),
           py::arg("samplerate") = py::none(), py::arg("num_channels") = 1,
-          py::arg("bit_depth") = 16, py::arg("quality") = py::none())
+          py::arg("bit_depth") = 16, py::arg("quality") = py::none(),
+          py::arg("queue_size") = 0)
       .def_static(
           "__new__",
           [](const py::object *, py::object filelike,
@@ -1069,10 +1190,15 @@ inline void init_writeable_audio_file(
            "Attempt to flush this audio file's contents to disk. Not all "
            "formats support flushing, so this may throw a RuntimeError. (If "
            "this happens, closing the file will reliably force a flush to "
-           "occur.)")
+           "occur.)\n\nIf :py:attr:`queue_size` is greater than zero, this "
+           "method first waits for all queued audio to be encoded, and "
+           "raises any error that occurred while encoding it.")
       .def("close", &WriteableAudioFile::close,
            "Close this file, flushing its contents to disk and rendering this "
-           "object unusable for further writing.")
+           "object unusable for further writing.\n\nIf "
+           ":py:attr:`queue_size` is greater than zero, this method first "
+           "waits for all queued audio to be encoded, and raises any error "
+           "that occurred while encoding it (after closing the file).")
       .def("__enter__", &WriteableAudioFile::enter)
       .def("__exit__", &WriteableAudioFile::exit)
       .def("__repr__",
@@ -1113,6 +1239,20 @@ inline void init_writeable_audio_file(
       .def_property_readonly("num_channels",
                              &WriteableAudioFile::getNumChannels,
                              "The number of channels in this file.")
+      .def_property_readonly("queue_size", &WriteableAudioFile::getQueueSize,
+                             R"(
+The maximum number of chunks of audio that may be waiting to be encoded on a
+background thread, or ``0`` if audio is encoded during each call to
+:meth:`write`.
+
+If greater than zero, :meth:`write` copies the provided audio into a queue and
+returns immediately (unless the queue is full), allowing the caller to
+prepare the next chunk of audio while the previous one is being encoded.
+Errors that occur while encoding are raised by the next call to
+:meth:`write`, :meth:`flush`, or :meth:`close`.
+
+*Introduced in v0.9.22.*
+)")
       .def_property_readonly("frames", &WriteableAudioFile::getFramesWritten,
                              "The total number of frames (samples per "
                              "channel) written to this file so far.")
@@ -1,5 +1,11 @@
 #include "juce_BlockingConvolution.h"
 
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
 /*
   ==============================================================================
 
@@ -35,6 +41,126 @@
 namespace juce {
 namespace dsp {
 
+//==============================================================================
+/**
+ * NOTE(pedalboard): A process-wide cache of the frequency-domain impulse
+ * response segments used by ConvolutionEngine, which are expensive to compute
+ * for long impulse responses. Segments are keyed by a hash of the (resampled,
+ * normalised, single-channel) impulse response samples they were computed
+ * from and by the engine's block size, so every engine using the same impulse
+ * response at the same sample rate and block size shares one read-only copy.
+ * Segments are freed when the last engine using them is destroyed.
+ *
+ * As different impulse responses may share a hash, each entry also keeps a
+ * copy of the samples it was computed from, which are compared on every hit.
+ */
+class ImpulseResponseSpectrumCache {
+public:
+  using Segments = std::vector<AudioBuffer<float>>;
+
+  struct Key {
+    uint64 contentHash;
+    size_t numSamples;
+    size_t blockSize;
+
+    bool operator<(const Key &other) const {
+      return std::tie(contentHash, numSamples, blockSize) <
+             std::tie(other.contentHash, other.numSamples, other.blockSize);
+    }
+  };
+
+  static ImpulseResponseSpectrumCache &getInstance() {
+    static ImpulseResponseSpectrumCache instance;
+    return instance;
+  }
+
+  // A 64-bit FNV-1a hash, computed over whole samples at a time to keep
+  // hashing long impulse responses fast:
+  static uint64 hash(const float *samples, size_t numSamples) {
+    uint64 result = 14695981039346656037ull;
+    for (size_t i = 0; i < numSamples; i++) {
+      uint32 bits;
+      std::memcpy(&bits, samples + i, sizeof(bits));
+      result = (result ^ bits) * 1099511628211ull;
+    }
+    return result;
+  }
+
+  template <typename ComputeFunction>
+  std::shared_ptr<const Segments> getOrCompute(const float *samples,
+                                               size_t numSamples,
+                                               size_t blockSize,
+                                               ComputeFunction compute) {
+    Key key{hash(samples, numSamples), numSamples, blockSize};
+
+    bool isHashCollision = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto it = entries.find(key);
+      if (it != entries.end()) {
+        if (auto entry = it->second.lock()) {
+          if (entry->matches(samples, numSamples))
+            return {entry, &entry->segments};
+          isHashCollision = true;
+        }
+      }
+    }
+
+    // Another impulse response with the same hash is already cached, so
+    // don't cache these segments:
+    if (isHashCollision)
+      return std::make_shared<const Segments>(compute());
+
+    // Compute segments without holding the lock, to allow engines for
+    // different impulse responses to be created in parallel:
+    auto entry = std::make_shared<const Entry>(
+        Entry{std::vector<float>(samples, samples + numSamples), compute()});
+
+    std::lock_guard<std::mutex> lock(mutex);
+    removeExpiredEntries();
+
+    auto &cachedEntry = entries[key];
+    if (auto existingEntry = cachedEntry.lock()) {
+      if (existingEntry->matches(samples, numSamples))
+        return {existingEntry, &existingEntry->segments};
+      return {entry, &entry->segments};
+    }
+
+    cachedEntry = entry;
+    return {entry, &entry->segments};
+  }
+
+  size_t size() {
+    std::lock_guard<std::mutex> lock(mutex);
+    removeExpiredEntries();
+    return entries.size();
+  }
+
+private:
+  struct Entry {
+    std::vector<float> samples;
+    Segments segments;
+
+    bool matches(const float *otherSamples, size_t numOtherSamples) const {
+      return samples.size() == numOtherSamples &&
+             std::memcmp(samples.data(), otherSamples,
+                         numOtherSamples * sizeof(float)) == 0;
+    }
+  };
+
+  void removeExpiredEntries() {
+    for (auto it = entries.begin(); it != entries.end();) {
+      if (it->second.expired())
+        it = entries.erase(it);
+      else
+        ++it;
+    }
+  }
+
+  std::mutex mutex;
+  std::map<Key, std::weak_ptr<const Entry>> entries;
+};
+
 //==============================================================================
 //==============================================================================
 struct ConvolutionEngine {
@@ -65,28 +191,38 @@ struct ConvolutionEngine {
         };
 
     updateSegmentsIfNecessary(numInputSegments, buffersInputSegments);
-    updateSegmentsIfNecessary(numSegments, buffersImpulseSegments);
 
-    auto FFTTempObject = std::make_unique<FFT>(roundToInt(std::log2(fftSize)));
-    size_t currentPtr = 0;
+    impulseSegments = ImpulseResponseSpectrumCache::getInstance().getOrCompute(
+        samples, numSamples, blockSize, [&]() {
+          ImpulseResponseSpectrumCache::Segments segments;
+          for (size_t i = 0; i < numSegments; ++i)
+            segments.push_back({1, static_cast<int>(fftSize * 2)});
 
-    for (auto &buf : buffersImpulseSegments) {
-      buf.clear();
+          auto FFTTempObject =
+              std::make_unique<FFT>(roundToInt(std::log2(fftSize)));
+          size_t currentPtr = 0;
 
-      auto *impulseResponse = buf.getWritePointer(0);
+          for (auto &buf : segments) {
+            buf.clear();
 
-      if (&buf == &buffersImpulseSegments.front())
-        impulseResponse[0] = 1.0f;
+            auto *impulseResponse = buf.getWritePointer(0);
 
-      FloatVectorOperations::copy(
-          impulseResponse, samples + currentPtr,
-          static_cast<int>(jmin(fftSize - blockSize, numSamples - currentPtr)));
+            if (&buf == &segments.front())
+              impulseResponse[0] = 1.0f;
 
-      FFTTempObject->performRealOnlyForwardTransform(impulseResponse);
-      prepareForConvolution(impulseResponse);
+            FloatVectorOperations::copy(
+                impulseResponse, samples + currentPtr,
+                static_cast<int>(
+                    jmin(fftSize - blockSize, numSamples - currentPtr)));
 
-      currentPtr += (fftSize - blockSize);
-    }
+            FFTTempObject->performRealOnlyForwardTransform(impulseResponse);
+            prepareForConvolution(impulseResponse);
+
+            currentPtr += (fftSize - blockSize);
+          }
+
+          return segments;
+        });
 
     reset();
   }
@@ -147,7 +283,7 @@ struct ConvolutionEngine {
 
           convolutionProcessingAndAccumulate(
               buffersInputSegments[index].getWritePointer(0),
-              buffersImpulseSegments[i].getWritePointer(0), outputTempData);
+              (*impulseSegments)[i].getReadPointer(0), outputTempData);
         }
       }
 
@@ -155,7 +291,7 @@ struct ConvolutionEngine {
                                   static_cast<int>(fftSize + 1));
 
       convolutionProcessingAndAccumulate(
-          inputSegmentData, buffersImpulseSegments.front().getWritePointer(0),
+          inputSegmentData, impulseSegments->front().getReadPointer(0),
           outputData);
 
       updateSymmetricFrequencyDomainData(outputData);
@@ -244,14 +380,14 @@ struct ConvolutionEngine {
 
           convolutionProcessingAndAccumulate(
               buffersInputSegments[index].getWritePointer(0),
-              buffersImpulseSegments[i].getWritePointer(0), outputTempData);
+              (*impulseSegments)[i].getReadPointer(0), outputTempData);
         }
 
         FloatVectorOperations::copy(outputData, outputTempData,
                                     static_cast<int>(fftSize + 1));
 
         convolutionProcessingAndAccumulate(
-            inputSegmentData, buffersImpulseSegments.front().getWritePointer(0),
+            inputSegmentData, impulseSegments->front().getReadPointer(0),
             outputData);
 
         updateSymmetricFrequencyDomainData(outputData);
@@ -346,7 +482,10 @@ struct ConvolutionEngine {
   size_t currentSegment = 0, inputDataPos = 0;
 
   AudioBuffer<float> bufferInput, bufferOutput, bufferTempOutput, bufferOverlap;
-  std::vector<AudioBuffer<float>> buffersInputSegments, buffersImpulseSegments;
+  std::vector<AudioBuffer<float>> buffersInputSegments;
+
+  // Shared with every other engine using the same impulse response:
+  std::shared_ptr<const ImpulseResponseSpectrumCache::Segments> impulseSegments;
 };
 
 //==============================================================================
@@ -640,14 +779,47 @@ public:
   void setImpulseResponse(BufferWithSampleRate &&buf,
                           Convolution::Stereo stereo, Convolution::Trim trim,
                           Convolution::Normalise normalise) {
+    setImpulseResponse(
+        std::make_shared<const AudioBuffer<float>>(std::move(buf.buffer)),
+        buf.sampleRate, stereo, trim, normalise);
+  }
+
+  // It is safe to call this method simultaneously with other public
+  // member functions.
+  void setImpulseResponse(std::shared_ptr<const AudioBuffer<float>> buf,
+                          double sampleRate, Convolution::Stereo stereo,
+                          Convolution::Trim trim,
+                          Convolution::Normalise normalise) {
     wantsNormalise = normalise;
-    originalSampleRate = buf.sampleRate;
+    originalSampleRate = sampleRate;
+
+    const auto maxNumChannels = stereo == Convolution::Stereo::yes ? 2 : 1;
+    const bool needsCorrection = trim == Convolution::Trim::yes ||
+                                 buf->getNumChannels() == 0 ||
+                                 buf->getNumChannels() > maxNumChannels ||
+                                 buf->getNumSamples() == 0;
+
+    // Avoid copying the impulse response if it can be used as-is:
+    if (needsCorrection) {
+      impulseResponse = std::make_shared<const AudioBuffer<float>>([&] {
+        auto corrected = fixNumChannels(*buf, stereo);
+        return trim == Convolution::Trim::yes ? trimImpulseResponse(corrected)
+                                              : corrected;
+      }());
+    } else {
+      impulseResponse = std::move(buf);
+    }
 
-    impulseResponse = [&] {
-      auto corrected = fixNumChannels(buf.buffer, stereo);
-      return trim == Convolution::Trim::yes ? trimImpulseResponse(corrected)
-                                            : corrected;
-    }();
+    engine = makeEngine();
+  }
+
+  // Use the same (already loaded and preprocessed) impulse response as
+  // another factory. The impulse response itself is never modified after
+  // being loaded, so it is shared rather than copied.
+  void setImpulseResponse(const BlockingConvolutionEngineFactory &other) {
+    wantsNormalise = other.wantsNormalise;
+    originalSampleRate = other.originalSampleRate;
+    impulseResponse = other.impulseResponse;
 
     engine = makeEngine();
   }
@@ -663,7 +835,7 @@ public:
 private:
   std::unique_ptr<MultichannelEngine> makeEngine() {
     auto resampled = resampleImpulseResponse(
-        impulseResponse, originalSampleRate, processSpec.sampleRate);
+        *impulseResponse, originalSampleRate, processSpec.sampleRate);
 
     if (wantsNormalise == Convolution::Normalise::yes)
       normaliseImpulseResponse(resampled);
@@ -679,14 +851,15 @@ private:
         shouldBeZeroLatency);
   }
 
-  static AudioBuffer<float> makeImpulseBuffer() {
-    AudioBuffer<float> result(1, 1);
-    result.setSample(0, 0, 1.0f);
+  static std::shared_ptr<const AudioBuffer<float>> makeImpulseBuffer() {
+    auto result = std::make_shared<AudioBuffer<float>>(1, 1);
+    result->setSample(0, 0, 1.0f);
     return result;
   }
 
   ProcessSpec processSpec{44100.0, 128, 2};
-  AudioBuffer<float> impulseResponse = makeImpulseBuffer();
+  std::shared_ptr<const AudioBuffer<float>> impulseResponse =
+      makeImpulseBuffer();
   double originalSampleRate = processSpec.sampleRate;
   Convolution::Normalise wantsNormalise = Convolution::Normalise::no;
   const Convolution::Latency latency;
@@ -761,6 +934,18 @@ public:
                        normalise);
   }
 
+  void loadImpulseResponse(std::shared_ptr<const AudioBuffer<float>> buffer,
+                           double originalSampleRate,
+                           Convolution::Stereo stereo, Convolution::Trim trim,
+                           Convolution::Normalise normalise) {
+    engineFactory.setImpulseResponse(std::move(buffer), originalSampleRate,
+                                     stereo, trim, normalise);
+  }
+
+  void loadImpulseResponse(const Impl &other) {
+    engineFactory.setImpulseResponse(other.engineFactory);
+  }
+
 private:
   BlockingConvolutionEngineFactory engineFactory;
 };
@@ -806,6 +991,19 @@ void BlockingConvolution::loadImpulseResponse(
                              trim, normalise);
 }
 
+void BlockingConvolution::loadImpulseResponse(
+    std::shared_ptr<const AudioBuffer<float>> buffer, double originalSampleRate,
+    Convolution::Stereo stereo, Convolution::Trim trim,
+    Convolution::Normalise normalise) {
+  pimpl->loadImpulseResponse(std::move(buffer), originalSampleRate, stereo,
+                             trim, normalise);
+}
+
+void BlockingConvolution::loadImpulseResponse(
+    const BlockingConvolution &other) {
+  pimpl->loadImpulseResponse(*other.pimpl);
+}
+
 void BlockingConvolution::prepare(const ProcessSpec &spec) {
   pimpl->prepare(spec);
   isActive = true;
@@ -833,5 +1031,9 @@ int BlockingConvolution::getCurrentIRSize() const {
 
 int BlockingConvolution::getLatency() const { return pimpl->getLatency(); }
 
+size_t BlockingConvolution::getSpectrumCacheSize() {
+  return ImpulseResponseSpectrumCache::getInstance().size();
+}
+
 } // namespace dsp
 } // namespace juce
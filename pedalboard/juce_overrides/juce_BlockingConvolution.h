@@ -189,6 +189,36 @@ public:
                            Convolution::Trim requiresTrimming,
                            Convolution::Normalise requiresNormalisation);
 
+  /** This function loads an impulse response from an audio buffer that may
+      be shared with other objects. If the buffer does not need to be trimmed
+      or have channels removed, it is used as-is without being copied, so it
+      must not be modified after being passed to this function.
+
+      @param buffer                   the AudioBuffer to use
+      @param bufferSampleRate         the sampleRate of the data in the
+     AudioBuffer
+      @param isStereo                 selects either stereo or mono
+      @param requiresTrimming         optionally trim the start and the end of
+     the impulse response
+      @param requiresNormalisation    optionally normalise the impulse response
+     amplitude
+  */
+  void loadImpulseResponse(std::shared_ptr<const AudioBuffer<float>> buffer,
+                           double bufferSampleRate,
+                           Convolution::Stereo isStereo,
+                           Convolution::Trim requiresTrimming,
+                           Convolution::Normalise requiresNormalisation);
+
+  /** This function loads the same impulse response as another
+      BlockingConvolution object, without reading or trimming it again.
+      The (immutable) impulse response data is shared between both objects,
+      so this is much cheaper than loading it from scratch.
+
+      @param other                    the object to copy the impulse response
+     from
+  */
+  void loadImpulseResponse(const BlockingConvolution &other);
+
   /** This function returns the size of the current IR in samples. */
   int getCurrentIRSize() const;
 
@@ -200,6 +230,16 @@ public:
   */
   int getLatency() const;
 
+  /** Returns the number of distinct sets of frequency-domain impulse
+      response segments currently shared between all BlockingConvolution
+      objects in this process.
+
+      Every convolution engine that uses the same impulse response data with
+      the same maximum block size reuses the same segments, rather than
+      partitioning and transforming the impulse response again.
+  */
+  static size_t getSpectrumCacheSize();
+
 private:
   //==============================================================================
   BlockingConvolution(const Convolution::Latency &,
@@ -1,5 +1,9 @@
 #include "../JuceHeader.h"
 
+#include <map>
+#include <memory>
+#include <mutex>
+
 inline double sinc(const double x) {
   if (x == 0)
     return 1;
@@ -7,41 +11,66 @@ inline double sinc(const double x) {
          (juce::MathConstants<double>::pi * x);
 }
 
-inline double besselI0(int K, double x) {
-  // Modified Bessel function of order 0.
-  double sum = 0;
-  for (int k = 0; k < K; k++) {
-    sum += pow(pow(x, 2) / 4, k) / pow(tgamma(k + 1), 2);
+/**
+ * The modified Bessel function of order 0, evaluated with the first
+ * numTerms terms of its power series. The terms' denominators don't depend
+ * on x, so are computed once up front when evaluating the function many times
+ * (i.e.: once for every point of a Kaiser window).
+ */
+class BesselI0 {
+public:
+  explicit BesselI0(int numTerms) : denominators(numTerms) {
+    for (int k = 0; k < numTerms; k++) {
+      denominators[k] = pow(tgamma(k + 1), 2);
+    }
   }
-  return sum;
-}
+
+  double operator()(double x) const {
+    const double quarterXSquared = pow(x, 2) / 4;
+    double sum = 0;
+    for (size_t k = 0; k < denominators.size(); k++) {
+      sum += pow(quarterXSquared, (double)k) / denominators[k];
+    }
+    return sum;
+  }
+
+private:
+  std::vector<double> denominators;
+};
 
 template <int NumZeros, int Precision>
 std::vector<float> calculateSincTable(double rolloff, double kaiserBeta,
                                       int besselPrecision) {
   const int n = Precision * NumZeros;
-
-  // Make the right hand side of the kaiser window with the provided beta:
-  std::vector<float> kaiserWindow(n + 1);
-  double besselI0OfBeta = besselI0(besselPrecision, kaiserBeta);
-  for (int i = 0; i <= n; i++) {
-    double alpha = (2 * n) / 2.0;
-    double x = (i - alpha) / alpha;
-    kaiserWindow[i] =
-        besselI0(besselPrecision, kaiserBeta * sqrt(1 - (x * x))) /
-        besselI0OfBeta;
-  }
+  const BesselI0 besselI0(besselPrecision);
+  const double besselI0OfBeta = besselI0(kaiserBeta);
+  const double alpha = (2 * n) / 2.0;
 
   std::vector<float> sinc_win(n + 1 // for the 0th element (magnitude 1)
                               + 2 // for the two extra zero elements at the end
   );
   for (int i = 0; i <= n; i++) {
+    // Multiply by the right hand side of the kaiser window with the provided
+    // beta (rounded to float first, as it always has been):
+    double x = ((n - i) - alpha) / alpha;
+    float kaiserWindow =
+        besselI0(kaiserBeta * sqrt(1 - (x * x))) / besselI0OfBeta;
+
     double linspace = NumZeros * ((double)i / (double)n);
-    sinc_win[i] = rolloff * sinc(linspace * rolloff) * kaiserWindow[n - i];
+    sinc_win[i] = rolloff * sinc(linspace * rolloff) * kaiserWindow;
   }
   return sinc_win;
 }
 
+/**
+ * Returns the windowed sinc lookup table for the given number of zero
+ * crossings and precision, calculating it on first use. (This takes a few
+ * milliseconds for the largest tables, so is deferred until a resampler of
+ * the corresponding quality is actually created.)
+ *
+ * Each table is a function-local static, so is initialized exactly once even
+ * if multiple threads request it at the same time.
+ */
 template <int NumZeros, int Precision>
 const std::vector<float> &getSincTable() {
   float rolloff = 0.990;
@@ -65,8 +94,9 @@ const std::vector<float> &getSincTable() {
     besselPrecision = 16;
   }
 
-  static std::vector<float> sinc_win = calculateSincTable<NumZeros, Precision>(
-      rolloff, kaiserBeta, besselPrecision);
+  static const std::vector<float> sinc_win =
+      calculateSincTable<NumZeros, Precision>(rolloff, kaiserBeta,
+                                              besselPrecision);
   return sinc_win;
 }
 
@@ -187,13 +217,17 @@ struct FastWindowedSincTraits {
    JUCE's built-in FastWindowedSincInterpolator in that it also passes the
    sampling ratio to the interpolator logic, allowing us to implement a low-pass
    filter simultaneously while the resampling occurs.
+
+   A single interpolator can also process multiple channels at once (see
+   setNumChannels), in which case the sinc coefficients for each output frame
+   are computed once and applied to every channel.
 */
 template <class InterpolatorTraits> class FastWindowedSincInterpolator {
 public:
-  FastWindowedSincInterpolator() noexcept {
+  FastWindowedSincInterpolator() {
     lookupTable = &getSincTable<InterpolatorTraits::NumCrossings,
                                 InterpolatorTraits::DistanceBetweenCrossings>();
-    reset();
+    setNumChannels(1);
   }
 
   FastWindowedSincInterpolator(FastWindowedSincInterpolator &&) noexcept =
@@ -217,29 +251,65 @@ public:
   void reset() noexcept {
     indexBuffer = 0;
     subSamplePos = 1.0;
-    std::fill(std::begin(lastInputSamples), std::end(lastInputSamples), 0.0f);
+    for (auto &channelInputSamples : lastInputSamples)
+      channelInputSamples.fill(0.0f);
+  }
+
+  /** Sets the number of channels passed to each call to process(), and
+      resets the state of the interpolator. */
+  void setNumChannels(int numChannels) {
+    lastInputSamples.resize(numChannels);
+    reset();
   }
 
+  int getNumChannels() const noexcept { return (int)lastInputSamples.size(); }
+
+  /** Resamples a single channel of audio. Only valid if this interpolator
+      was configured for one channel. */
   int process(double speedRatio, const float *inputSamples,
               float *outputSamples, int numOutputSamplesToProduce) noexcept {
+    jassert(getNumChannels() == 1);
+    return interpolate(speedRatio, &inputSamples, &outputSamples,
+                       numOutputSamplesToProduce);
+  }
+
+  /** Resamples every channel of audio at once, given one input and one output
+      pointer per channel. */
+  int process(double speedRatio, const float *const *inputSamples,
+              float *const *outputSamples,
+              int numOutputSamplesToProduce) noexcept {
     return interpolate(speedRatio, inputSamples, outputSamples,
                        numOutputSamplesToProduce);
   }
 
 private:
   //==============================================================================
-  forcedinline void pushInterpolationSample(float newValue) noexcept {
-    lastInputSamples[indexBuffer] = newValue;
+  forcedinline void pushInterpolationSamples(const float *const *inputs,
+                                             int index) noexcept {
+    for (size_t c = 0; c < lastInputSamples.size(); c++)
+      lastInputSamples[c][indexBuffer] = inputs[c][index];
 
     if (++indexBuffer == InterpolatorTraits::BufferSize)
       indexBuffer = 0;
   }
 
+  forcedinline void
+  writeOutputSamples(float *const *outputs, int index, double speedRatio,
+                     const std::array<float, InterpolatorTraits::BufferSize>
+                         &sincValues) noexcept {
+    for (size_t c = 0; c < lastInputSamples.size(); c++) {
+      outputs[c][index] = InterpolatorTraits::valueAtOffset(
+          lastInputSamples[c].data(), indexBuffer, speedRatio, sincValues);
+    }
+  }
+
   //==============================================================================
-  int interpolate(double speedRatio, const float *input, float *output,
+  int interpolate(double speedRatio, const float *const *input,
+                  float *const *output,
                   int numOutputSamplesToProduce) noexcept {
     auto pos = subSamplePos;
     int numUsed = 0;
+    int numProduced = 0;
 
     const float *lookupTablePointer = lookupTable->data();
 
@@ -272,26 +342,27 @@ private:
       }
     }
 
+    // Note that the sinc coefficients for each output frame only depend on
+    // its sub-sample position, so are computed (or looked up) just once for
+    // all channels:
     if (!cachedSincValueTables.empty()) {
       while (numOutputSamplesToProduce > 0) {
         while (pos >= 1.0) {
-          pushInterpolationSample(input[numUsed++]);
+          pushInterpolationSamples(input, numUsed++);
           pos -= 1.0;
         }
 
         // Check if we have a cached sinc table and create one if necessary:
-        if (cachedSincValueTables.find({speedRatio, pos}) ==
-            cachedSincValueTables.end()) {
+        auto cachedSincValues = cachedSincValueTables.find({speedRatio, pos});
+        if (cachedSincValues == cachedSincValueTables.end()) {
           // This should not happen; we should have precomputed all sinc tables
           // above. Create a new sinc table on the stack:
           auto sincValues = InterpolatorTraits::subsampleSincFilter(
               lookupTablePointer, (float)pos, speedRatio);
-          *output++ = InterpolatorTraits::valueAtOffset(
-              lastInputSamples, indexBuffer, speedRatio, sincValues);
+          writeOutputSamples(output, numProduced++, speedRatio, sincValues);
         } else {
-          const auto &sincValues = cachedSincValueTables[{speedRatio, pos}];
-          *output++ = InterpolatorTraits::valueAtOffset(
-              lastInputSamples, indexBuffer, speedRatio, sincValues);
+          writeOutputSamples(output, numProduced++, speedRatio,
+                             cachedSincValues->second);
         }
 
         pos += speedRatio;
@@ -300,14 +371,13 @@ private:
     } else {
       while (numOutputSamplesToProduce > 0) {
         while (pos >= 1.0) {
-          pushInterpolationSample(input[numUsed++]);
+          pushInterpolationSamples(input, numUsed++);
           pos -= 1.0;
         }
 
         auto sincValues = InterpolatorTraits::subsampleSincFilter(
             lookupTablePointer, pos, speedRatio);
-        *output++ = InterpolatorTraits::valueAtOffset(
-            lastInputSamples, indexBuffer, speedRatio, sincValues);
+        writeOutputSamples(output, numProduced++, speedRatio, sincValues);
         pos += speedRatio;
         --numOutputSamplesToProduce;
       }
@@ -318,7 +388,9 @@ private:
   }
 
   //==============================================================================
-  float lastInputSamples[(size_t)InterpolatorTraits::BufferSize];
+  // The most recent input samples for each channel, in a ring buffer:
+  std::vector<std::array<float, InterpolatorTraits::BufferSize>>
+      lastInputSamples;
   double subSamplePos = 1.0;
   int indexBuffer = 0;
 
@@ -343,5 +415,179 @@ public:
   using WindowedSinc16 = WINDOWEDSINC(16, 512);
   using WindowedSinc8 = WINDOWEDSINC(8, 512);
 };
+/**
+   A type-erased interface to PolyphaseWindowedSincInterpolator, allowing
+   resamplers of different qualities to be stored and used interchangeably.
+*/
+class PolyphaseInterpolator {
+public:
+  virtual ~PolyphaseInterpolator() = default;
+
+  /** Returns the speed ratio (source sample rate / target sample rate) that
+      this interpolator's filter bank was built for. */
+  virtual double getSpeedRatio() const noexcept = 0;
+
+  virtual void reset() noexcept = 0;
+
+  /** Sets the number of channels passed to each call to process(), and
+      resets the state of the interpolator. */
+  virtual void setNumChannels(int numChannels) = 0;
+
+  virtual int process(const float *const *inputSamples,
+                      float *const *outputSamples,
+                      int numOutputSamplesToProduce) noexcept = 0;
+
+  /** Reset this interpolator and advance its position as if it had produced
+      numOutputSamples samples from silence, returning the number of input
+      samples that would have been consumed. */
+  virtual long long advance(long long numOutputSamples) noexcept = 0;
+};
+
+/**
+   A windowed-sinc interpolator for resampling between two sample rates whose
+   ratio reduces to a fraction of small integers (i.e.: 48kHz to 44.1kHz, or
+   160/147). The fractional position of every output sample is then one of
+   only upsampleFactor values, so the sinc coefficients for each of those
+   positions (or "phases") are computed once up front rather than per output
+   sample, and the position is tracked exactly with integers.
+
+   Each phase's coefficients are computed by the same code as
+   FastWindowedSincInterpolator with the same traits, so both produce the same
+   output for a given sub-sample position.
+*/
+template <class InterpolatorTraits>
+class PolyphaseWindowedSincInterpolator : public PolyphaseInterpolator {
+public:
+  using FilterBank =
+      std::vector<std::array<float, InterpolatorTraits::BufferSize>>;
+
+  PolyphaseWindowedSincInterpolator(long long upsampleFactor,
+                                    long long downsampleFactor)
+      : upsampleFactor(upsampleFactor), downsampleFactor(downsampleFactor),
+        speedRatio((double)downsampleFactor / (double)upsampleFactor),
+        filterBank(getFilterBank(upsampleFactor, downsampleFactor)) {
+    setNumChannels(1);
+  }
+
+  double getSpeedRatio() const noexcept override { return speedRatio; }
+
+  void reset() noexcept override {
+    indexBuffer = 0;
+    // Equivalent to FastWindowedSincInterpolator's initial subSamplePos of 1:
+    phase = upsampleFactor;
+    for (auto &channelInputSamples : lastInputSamples)
+      channelInputSamples.fill(0.0f);
+  }
+
+  void setNumChannels(int numChannels) override {
+    lastInputSamples.resize(numChannels);
+    reset();
+  }
+
+  int process(const float *const *input, float *const *output,
+              int numOutputSamplesToProduce) noexcept override {
+    const auto &filters = *filterBank;
+    const size_t numChannels = lastInputSamples.size();
+    int numUsed = 0;
+    int numProduced = 0;
+
+    while (numOutputSamplesToProduce > 0) {
+      while (phase >= upsampleFactor) {
+        for (size_t c = 0; c < numChannels; c++)
+          lastInputSamples[c][indexBuffer] = input[c][numUsed];
+        if (++indexBuffer == InterpolatorTraits::BufferSize)
+          indexBuffer = 0;
+        numUsed++;
+        phase -= upsampleFactor;
+      }
+
+      for (size_t c = 0; c < numChannels; c++) {
+        output[c][numProduced] = InterpolatorTraits::valueAtOffset(
+            lastInputSamples[c].data(), indexBuffer, speedRatio,
+            filters[phase]);
+      }
+      numProduced++;
+      phase += downsampleFactor;
+      --numOutputSamplesToProduce;
+    }
+
+    return numUsed;
+  }
+
+  long long advance(long long numOutputSamples) noexcept override {
+    reset();
+    if (numOutputSamples <= 0)
+      return 0;
+
+    // The position (in units of 1/upsampleFactor input samples) just before
+    // the last of these output samples would have been produced:
+    long long position =
+        upsampleFactor + (numOutputSamples - 1) * downsampleFactor;
+    phase = (position % upsampleFactor) + downsampleFactor;
+    return position / upsampleFactor;
+  }
+
+private:
+  /**
+   * Filter banks can be large (up to a few megabytes for the highest quality
+   * and least-reducible ratios) so share them between all interpolators
+   * that use the same ratio.
+   */
+  static std::shared_ptr<const FilterBank>
+  getFilterBank(long long upsampleFactor, long long downsampleFactor) {
+    static std::mutex mutex;
+    static std::map<std::pair<long long, long long>,
+                    std::weak_ptr<const FilterBank>>
+        cache;
+
+    std::scoped_lock lock(mutex);
+    auto &cached = cache[{upsampleFactor, downsampleFactor}];
+    if (auto filterBank = cached.lock())
+      return filterBank;
+
+    const float *lookupTable =
+        getSincTable<InterpolatorTraits::NumCrossings,
+                     InterpolatorTraits::DistanceBetweenCrossings>()
+            .data();
+    double speedRatio = (double)downsampleFactor / (double)upsampleFactor;
+
+    auto filterBank = std::make_shared<FilterBank>(upsampleFactor);
+    for (long long phase = 0; phase < upsampleFactor; phase++) {
+      (*filterBank)[phase] = InterpolatorTraits::subsampleSincFilter(
+          lookupTable, (float)((double)phase / (double)upsampleFactor),
+          speedRatio);
+    }
+
+    cached = filterBank;
+    return filterBank;
+  }
+
+  const long long upsampleFactor;
+  const long long downsampleFactor;
+  const double speedRatio;
+  const std::shared_ptr<const FilterBank> filterBank;
+
+  // The most recent input samples for each channel, in a ring buffer:
+  std::vector<std::array<float, InterpolatorTraits::BufferSize>>
+      lastInputSamples;
+  long long phase = 0;
+  int indexBuffer = 0;
+
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(
+      PolyphaseWindowedSincInterpolator)
+};
+
+class PolyphaseInterpolators {
+public:
+#define POLYPHASEWINDOWEDSINC(numCrossings, precision)                         \
+  PolyphaseWindowedSincInterpolator<                                           \
+      FastWindowedSincTraits<numCrossings, precision>>
+  using WindowedSinc256 = POLYPHASEWINDOWEDSINC(256, 512);
+  using WindowedSinc128 = POLYPHASEWINDOWEDSINC(128, 512);
+  using WindowedSinc64 = POLYPHASEWINDOWEDSINC(64, 512);
+  using WindowedSinc32 = POLYPHASEWINDOWEDSINC(32, 512);
+  using WindowedSinc16 = POLYPHASEWINDOWEDSINC(16, 512);
+  using WindowedSinc8 = POLYPHASEWINDOWEDSINC(8, 512);
+};
 
-}; // namespace juce
\ No newline at end of file
+}; // namespace juce
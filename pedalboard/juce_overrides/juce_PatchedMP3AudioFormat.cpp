@@ -2001,6 +2001,48 @@ struct PatchedMP3Stream {
     return true;
   }
 
+  // Parses every remaining frame in the stream (without synthesizing any
+  // audio) to record the stream position of every frame that seek() might
+  // need, then rewinds to the first frame. Returns the number of frames of
+  // audio that readNextBlock() would decode before running out of data.
+  int64 scanAllFrames() {
+    if (!seek(0))
+      return 0;
+
+    int64 numAudioFrames = 0;
+    int failedAttempts = 0;
+
+    while (!stream.isExhausted() && failedAttempts < 10) {
+      int dummy = 0;
+      auto result = decodeNextBlock(nullptr, nullptr, dummy);
+
+      if (result < 0)
+        break;
+
+      if (result == 0) {
+        numAudioFrames++;
+        failedAttempts = 0;
+      } else {
+        failedAttempts++;
+      }
+    }
+
+    seek(0);
+    return numAudioFrames;
+  }
+
+  const Array<int64> &getFrameStreamPositions() const noexcept {
+    return frameStreamPositions;
+  }
+
+  void setFrameStreamPositions(const Array<int64> &positions) {
+    frameStreamPositions = positions;
+  }
+
+  static constexpr int getFrameStreamPositionInterval() noexcept {
+    return storedStartPosInterval;
+  }
+
   MP3Frame frame;
   VBRTagData vbrTagData;
   BufferedInputStream stream;
@@ -3369,8 +3411,9 @@ public:
 
       const int numToCopy = jmin(decodedEnd - decodedStart, numSamples);
       float *const *const dst = reinterpret_cast<float **>(destSamples);
-      memcpy(dst[0] + startOffsetInDestBuffer, decoded0 + decodedStart,
-             (size_t)numToCopy * sizeof(float));
+      if (dst[0] != nullptr)
+        memcpy(dst[0] + startOffsetInDestBuffer, decoded0 + decodedStart,
+               (size_t)numToCopy * sizeof(float));
 
       if (numDestChannels > 1 && dst[1] != nullptr)
         memcpy(dst[1] + startOffsetInDestBuffer,
@@ -3394,10 +3437,90 @@ public:
     return stream.numFrames <= 0;
   }
 
+  bool hasFrameIndex() const override { return numIndexedFrames >= 0; }
+
+  bool buildFrameIndex() override {
+    if (hasFrameIndex())
+      return true;
+
+    const int64 numAudioFrames = stream.scanAllFrames();
+
+    // The scan leaves the stream rewound to its first frame, so force the
+    // next read to seek rather than continuing from the decoded buffer:
+    currentPosition = -1;
+    decodedStart = decodedEnd = 0;
+
+    applyFrameIndex(numAudioFrames);
+    return true;
+  }
+
+  MemoryBlock getFrameIndex() override {
+    MemoryBlock index;
+    if (!hasFrameIndex())
+      return index;
+
+    const auto &positions = stream.getFrameStreamPositions();
+    MemoryOutputStream out(index, false);
+    out.writeInt(frameIndexMagic);
+    out.writeInt(frameIndexVersion);
+    out.writeInt64(stream.stream.getTotalLength());
+    out.writeInt(samplesPerFrame);
+    out.writeInt(PatchedMP3Stream::getFrameStreamPositionInterval());
+    out.writeInt64(numIndexedFrames);
+    out.writeInt(positions.size());
+    for (auto position : positions)
+      out.writeInt64(position);
+    out.flush();
+    return index;
+  }
+
+  bool loadFrameIndex(const void *data, size_t numBytes) override {
+    MemoryInputStream in(data, numBytes, false);
+    const size_t headerSize = 4 + 4 + 8 + 4 + 4 + 8 + 4;
+    if (numBytes < headerSize)
+      return false;
+
+    if (in.readInt() != frameIndexMagic || in.readInt() != frameIndexVersion ||
+        in.readInt64() != stream.stream.getTotalLength() ||
+        in.readInt() != samplesPerFrame ||
+        in.readInt() != PatchedMP3Stream::getFrameStreamPositionInterval())
+      return false;
+
+    const int64 numAudioFrames = in.readInt64();
+    const int numPositions = in.readInt();
+    if (numAudioFrames < 0 || numPositions < 1 ||
+        numBytes != headerSize + (size_t)numPositions * 8)
+      return false;
+
+    // The first frame has already been found by the constructor, so we can
+    // cheaply check that this index actually belongs to this stream:
+    const auto &existingPositions = stream.getFrameStreamPositions();
+    Array<int64> positions;
+    positions.ensureStorageAllocated(numPositions);
+    for (int i = 0; i < numPositions; i++) {
+      const int64 position = in.readInt64();
+      if (position < 0 || position >= stream.stream.getTotalLength() ||
+          (i > 0 && position <= positions.getLast()) ||
+          (i < existingPositions.size() &&
+           position != existingPositions.getUnchecked(i)))
+        return false;
+      positions.add(position);
+    }
+
+    stream.setFrameStreamPositions(positions);
+    applyFrameIndex(numAudioFrames);
+    return true;
+  }
+
 private:
   PatchedMP3Stream stream;
   int64 currentPosition;
   int samplesPerFrame;
+  int64 numIndexedFrames = -1;
+
+  // "PMFI" (Pedalboard MP3 Frame Index), stored little-endian:
+  static constexpr int frameIndexMagic = 0x49464d50;
+  static constexpr int frameIndexVersion = 1;
   enum { decodedDataSize = 1152 };
   float decoded0[decodedDataSize], decoded1[decodedDataSize];
   int decodedStart, decodedEnd;
@@ -3477,6 +3600,17 @@ private:
     return numFrames * samplesPerFrame;
   }
 
+  void applyFrameIndex(int64 numAudioFrames) {
+    numIndexedFrames = numAudioFrames;
+
+    // If we have a VBR header, it already tells us the exact length;
+    // otherwise, our estimate can be replaced by the number of frames found:
+    if (stream.numFrames <= 0 && numAudioFrames > 0) {
+      stream.numFrames = (int)numAudioFrames;
+      lengthInSamples = numAudioFrames * samplesPerFrame;
+    }
+  }
+
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PatchedMP3Reader)
 };
 
@@ -77,6 +77,16 @@ public:
       : AudioFormatReader(sourceStream, formatName) {}
   virtual int64 getCurrentPosition() const = 0;
   virtual bool lengthIsApproximate() const { return false; };
+
+  // Readers for formats that can only seek by scanning (i.e.: MP3) may
+  // support building an index of frame positions in a single pass, after
+  // which lengthInSamples is exact and seeking no longer requires a scan.
+  // getFrameIndex() serializes this index so that it can be passed to
+  // loadFrameIndex() on a later reader of the same stream.
+  virtual bool hasFrameIndex() const { return false; }
+  virtual bool buildFrameIndex() { return false; }
+  virtual MemoryBlock getFrameIndex() { return {}; }
+  virtual bool loadFrameIndex(const void *, size_t) { return false; }
 };
 
 } // namespace juce
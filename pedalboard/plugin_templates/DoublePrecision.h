@@ -0,0 +1,93 @@
+/*
+ * pedalboard
+ * Copyright 2025 Spotify AB
+ *
+ * Licensed under the GNU Public License, Version 3.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    https://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "../JuceHeader.h"
+#include "../Plugin.h"
+
+namespace Pedalboard {
+
+/**
+ * A template class that wraps a plugin templated on its sample type (i.e.:
+ * Gain<float>), allowing it to process 64-bit audio without converting it to
+ * 32-bit first.
+ *
+ * 32-bit audio is processed by this object as usual. 64-bit audio is passed
+ * to a second, 64-bit instance of the same plugin, which is only created if
+ * 64-bit audio is processed and which has this plugin's parameters copied to
+ * it every time it is prepared. The wrapped plugin must provide a
+ * copyParametersTo method that accepts an instance of either sample type.
+ *
+ * The two instances have separate internal state (i.e.: delay lines and
+ * filter histories), which is never copied from one to the other; if the
+ * sample type changes between two calls to process() without a reset, any
+ * tail buffered by the other instance is lost. reset() clears both.
+ */
+template <template <typename> class PluginType>
+class DoublePrecision : public PluginType<float> {
+public:
+  virtual ~DoublePrecision(){};
+
+  virtual bool supportsDoublePrecision() override { return true; }
+
+  virtual void prepare(const juce::dsp::ProcessSpec &spec) override {
+    PluginType<float>::prepare(spec);
+    preparedSpec = spec;
+
+    if (doublePrecisionPlugin) {
+      this->copyParametersTo(*doublePrecisionPlugin);
+      doublePrecisionPlugin->prepare(spec);
+    }
+  }
+
+  virtual int process(
+      const juce::dsp::ProcessContextReplacing<float> &context) override {
+    return PluginType<float>::process(context);
+  }
+
+  virtual int process(
+      const juce::dsp::ProcessContextReplacing<double> &context) override {
+    if (!doublePrecisionPlugin) {
+      doublePrecisionPlugin = std::make_unique<PluginType<double>>();
+      this->copyParametersTo(*doublePrecisionPlugin);
+      doublePrecisionPlugin->prepare(preparedSpec);
+    }
+    return doublePrecisionPlugin->process(context);
+  }
+
+  virtual void reset() override {
+    PluginType<float>::reset();
+    if (doublePrecisionPlugin) {
+      doublePrecisionPlugin->reset();
+    }
+  }
+
+  virtual std::shared_ptr<Plugin> clone() override {
+    auto plugin = std::make_shared<DoublePrecision<PluginType>>();
+    this->copyParametersTo(*plugin);
+    return plugin;
+  }
+
+private:
+  juce::dsp::ProcessSpec preparedSpec = {0};
+  std::unique_ptr<PluginType<double>> doublePrecisionPlugin;
+};
+
+} // namespace Pedalboard
@@ -237,6 +237,11 @@ public:
 
   int getFixedBlockSize() const { return blockSize; }
 
+  void copyParametersTo(FixedBlockSize &other) const {
+    other.setFixedBlockSize(blockSize);
+    plugin.copyParametersTo(other.plugin);
+  }
+
 private:
   T plugin;
   unsigned int blockSize = DefaultBlockSize;
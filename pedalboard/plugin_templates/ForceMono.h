@@ -79,6 +79,16 @@ public:
 
   T &getNestedPlugin() { return plugin; }
 
+  void copyParametersTo(ForceMono &other) const {
+    plugin.copyParametersTo(other.plugin);
+  }
+
+  virtual std::shared_ptr<Plugin> clone() override {
+    auto copy = std::make_shared<ForceMono>();
+    copyParametersTo(*copy);
+    return copy;
+  }
+
 private:
   T plugin;
 };
@@ -86,6 +86,11 @@ public:
 
   int getSilenceLengthSamples() const { return silenceLengthSamples; }
 
+  void copyParametersTo(PrimeWithSilence &other) const {
+    other.setSilenceLengthSamples(silenceLengthSamples);
+    plugin.copyParametersTo(other.plugin);
+  }
+
 private:
   T plugin;
   int samplesOutput = 0;
@@ -50,6 +50,18 @@ public:
 
   virtual int getLatencyHint() override { return getDSP().getDelay(); }
 
+  void copyParametersTo(AddLatency &other) const {
+    other.getDSP().setMaximumDelayInSamples(
+        getDSP().getMaximumDelayInSamples());
+    other.getDSP().setDelay(getDSP().getDelay());
+  }
+
+  virtual std::shared_ptr<Plugin> clone() override {
+    auto plugin = std::make_shared<AddLatency>();
+    copyParametersTo(*plugin);
+    return plugin;
+  }
+
 private:
   int samplesProvided = 0;
 };
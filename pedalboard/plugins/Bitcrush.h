@@ -72,6 +72,12 @@ public:
     return block.getNumSamples();
   }
 
+  virtual std::shared_ptr<Plugin> clone() override {
+    auto plugin = std::make_shared<Bitcrush<SampleType>>();
+    plugin->setBitDepth(getBitDepth());
+    return plugin;
+  }
+
 private:
   SampleType bitDepth = 8.0f;
 
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "../JuceHeader.h"
+#include <atomic>
 #include <mutex>
 
 #include "../PluginContainer.h"
@@ -29,10 +30,13 @@ namespace Pedalboard {
  */
 class Chain : public PluginContainer {
 public:
-  Chain(std::vector<std::shared_ptr<Plugin>> plugins)
-      : PluginContainer(plugins) {}
+  Chain(std::vector<std::shared_ptr<Plugin>> plugins, bool pipelined = false)
+      : PluginContainer(plugins), pipelined(pipelined) {}
   virtual ~Chain(){};
 
+  virtual bool isPipelined() { return pipelined; }
+  void setPipelined(bool newValue) { pipelined = newValue; }
+
   virtual void prepare(const juce::dsp::ProcessSpec &spec) {
     for (auto plugin : plugins) {
       if (plugin) {
@@ -44,18 +48,21 @@ public:
 
   virtual int
   process(const juce::dsp::ProcessContextReplacing<float> &context) {
-    // assuming process context replacing
-    auto ioBlock = context.getOutputBlock();
+    return processBlock(context);
+  }
 
-    float **channels =
-        (float **)alloca(ioBlock.getNumChannels() * sizeof(float *));
-    for (int i = 0; i < ioBlock.getNumChannels(); i++) {
-      channels[i] = ioBlock.getChannelPointer(i);
+  virtual bool supportsDoublePrecision() {
+    for (auto plugin : plugins) {
+      if (plugin && !plugin->supportsDoublePrecision()) {
+        return false;
+      }
     }
+    return true;
+  }
 
-    juce::AudioBuffer<float> ioBuffer(channels, ioBlock.getNumChannels(),
-                                      ioBlock.getNumSamples());
-    return ::Pedalboard::process(ioBuffer, lastSpec, plugins, false);
+  virtual int
+  process(const juce::dsp::ProcessContextReplacing<double> &context) {
+    return processBlock(context);
   }
 
   virtual void reset() {
@@ -75,18 +82,60 @@ public:
     }
     return hint;
   }
+
+  virtual std::shared_ptr<Plugin> clone() override {
+    auto clonedPlugins = clonePlugins(plugins);
+    if (!clonedPlugins) {
+      return nullptr;
+    }
+    return std::make_shared<Chain>(*clonedPlugins, isPipelined());
+  }
+
+private:
+  template <typename SampleType>
+  int processBlock(
+      const juce::dsp::ProcessContextReplacing<SampleType> &context) {
+    // assuming process context replacing
+    auto ioBlock = context.getOutputBlock();
+
+    SampleType **channels = (SampleType **)alloca(ioBlock.getNumChannels() *
+                                                  sizeof(SampleType *));
+    for (int i = 0; i < ioBlock.getNumChannels(); i++) {
+      channels[i] = ioBlock.getChannelPointer(i);
+    }
+
+    juce::AudioBuffer<SampleType> ioBuffer(channels, ioBlock.getNumChannels(),
+                                           ioBlock.getNumSamples());
+    return ::Pedalboard::process(ioBuffer, lastSpec, plugins, false);
+  }
+
+  std::atomic<bool> pipelined;
 };
 
 inline void init_chain(py::module &m) {
   py::class_<Chain, PluginContainer, std::shared_ptr<Chain>>(
       m, "Chain",
       "Run zero or more plugins as a plugin. Useful when "
-      "used with the Mix plugin.")
-      .def(py::init([](std::vector<std::shared_ptr<Plugin>> plugins) {
-             return new Chain(plugins);
+      "used with the Mix plugin.\n\n"
+      "If ``pipelined`` is ``True`` and this object is called directly "
+      "(i.e.: ``my_chain(audio, sample_rate)``), each of its plugins will be "
+      "run on its own thread, with blocks of audio passed from one plugin "
+      "to the next as soon as they have been processed. This can speed up "
+      "rendering of long audio buffers through many plugins. The output is "
+      "identical to that produced when ``pipelined`` is ``False``. To run "
+      "several plugins on the same thread, group them together in another "
+      ":class:`Chain`. (*Introduced in v0.9.22.*)")
+      .def(py::init([](std::vector<std::shared_ptr<Plugin>> plugins,
+                       bool pipelined) {
+             return new Chain(plugins, pipelined);
            }),
-           py::arg("plugins"))
+           py::arg("plugins"), py::arg("pipelined") = false)
       .def(py::init([]() { return new Chain({}); }))
+      .def_property(
+          "pipelined", &Chain::isPipelined, &Chain::setPipelined,
+          "If ``True``, each of this object's plugins will be run on its own "
+          "thread when this object is called directly.\n\n"
+          "*Introduced in v0.9.22.*")
       .def("__repr__", [](Chain &plugin) {
         std::ostringstream ss;
         ss << "<pedalboard.Chain with " << plugin.getPlugins().size()
@@ -102,7 +151,11 @@ inline void init_chain(py::module &m) {
             ss << ", ";
           }
         }
-        ss << "] at " << &plugin;
+        ss << "]";
+        if (plugin.isPipelined()) {
+          ss << " pipelined=True";
+        }
+        ss << " at " << &plugin;
         ss << ">";
         return ss.str();
       });
@@ -37,23 +37,45 @@ public:
   virtual void prepare(const juce::dsp::ProcessSpec &spec) {}
 
   virtual int process(
-      const juce::dsp::ProcessContextReplacing<SampleType> &context) override {
+      const juce::dsp::ProcessContextReplacing<float> &context) override {
+    return processSamples(context);
+  }
+
+  // Clipping has no state, so can process 64-bit audio without needing a
+  // separate 64-bit instance:
+  virtual bool supportsDoublePrecision() override { return true; }
+
+  virtual int process(
+      const juce::dsp::ProcessContextReplacing<double> &context) override {
+    return processSamples(context);
+  }
+
+  virtual void reset() {}
+
+  virtual std::shared_ptr<Plugin> clone() override {
+    auto plugin = std::make_shared<Clipping<SampleType>>();
+    plugin->setThresholdDecibels(getThresholdDecibels());
+    return plugin;
+  }
+
+private:
+  template <typename ContextSampleType>
+  int processSamples(
+      const juce::dsp::ProcessContextReplacing<ContextSampleType> &context) {
     auto ioBlock = context.getOutputBlock();
 
     for (int c = 0; c < ioBlock.getNumChannels(); c++) {
-      SampleType *channelPointer = ioBlock.getChannelPointer(c);
+      ContextSampleType *channelPointer = ioBlock.getChannelPointer(c);
 
       juce::FloatVectorOperations::clip(
-          channelPointer, channelPointer, negativeThresholdGain,
-          positiveThresholdGain, ioBlock.getNumSamples());
+          channelPointer, channelPointer,
+          (ContextSampleType)negativeThresholdGain,
+          (ContextSampleType)positiveThresholdGain, ioBlock.getNumSamples());
     }
 
     return context.getOutputBlock().getNumSamples();
   }
 
-  virtual void reset() {}
-
-private:
   SampleType thresholdDecibels;
 
   SampleType negativeThresholdGain;
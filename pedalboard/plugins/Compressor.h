@@ -21,6 +21,7 @@
 namespace py = pybind11;
 
 #include "../JucePlugin.h"
+#include "../plugin_templates/DoublePrecision.h"
 
 namespace Pedalboard {
 template <typename SampleType>
@@ -33,10 +34,25 @@ class Compressor : public JucePlugin<juce::dsp::Compressor<SampleType>> {
   });
   DEFINE_DSP_SETTER_AND_GETTER(SampleType, Attack, {});
   DEFINE_DSP_SETTER_AND_GETTER(SampleType, Release, {});
+
+  template <typename OtherSampleType>
+  void copyParametersTo(Compressor<OtherSampleType> &other) const {
+    other.setThreshold(getThreshold());
+    other.setRatio(getRatio());
+    other.setAttack(getAttack());
+    other.setRelease(getRelease());
+  }
+
+  virtual std::shared_ptr<Plugin> clone() override {
+    auto plugin = std::make_shared<Compressor<SampleType>>();
+    copyParametersTo(*plugin);
+    return plugin;
+  }
 };
 
 inline void init_compressor(py::module &m) {
-  py::class_<Compressor<float>, Plugin, std::shared_ptr<Compressor<float>>>(
+  py::class_<DoublePrecision<Compressor>, Plugin,
+             std::shared_ptr<DoublePrecision<Compressor>>>(
       m, "Compressor",
       "A dynamic range compressor, used to reduce the volume of loud sounds "
       "and \"compress\" the loudness of the signal.\n\nFor a lossy compression "
@@ -44,7 +60,7 @@ inline void init_compressor(py::module &m) {
       "``pedalboard.MP3Compressor`` or ``pedalboard.GSMCompressor``.")
       .def(py::init([](float thresholddB, float ratio, float attackMs,
                        float releaseMs) {
-             auto plugin = std::make_unique<Compressor<float>>();
+             auto plugin = std::make_unique<DoublePrecision<Compressor>>();
              plugin->setThreshold(thresholddB);
              plugin->setRatio(ratio);
              plugin->setAttack(attackMs);
@@ -54,7 +70,7 @@ inline void init_compressor(py::module &m) {
            py::arg("threshold_db") = 0, py::arg("ratio") = 1,
            py::arg("attack_ms") = 1.0, py::arg("release_ms") = 100)
       .def("__repr__",
-           [](const Compressor<float> &plugin) {
+           [](const DoublePrecision<Compressor> &plugin) {
              std::ostringstream ss;
              ss << "<pedalboard.Compressor";
              ss << " threshold_db=" << plugin.getThreshold();
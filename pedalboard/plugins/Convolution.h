@@ -51,12 +51,13 @@ public:
     return impulseResponseFilename;
   }
 
-  void setImpulseResponse(juce::AudioBuffer<float> &&ir) {
-    impulseResponse = {std::move(ir)};
+  void
+  setImpulseResponse(std::shared_ptr<const juce::AudioBuffer<float>> ir) {
+    impulseResponse = ir;
   }
 
-  const std::optional<juce::AudioBuffer<float>> &getImpulseResponse() const {
-    return {impulseResponse};
+  std::shared_ptr<const juce::AudioBuffer<float>> getImpulseResponse() const {
+    return impulseResponse;
   }
 
   void setSampleRate(double sr) { sampleRate = {sr}; }
@@ -82,31 +83,58 @@ public:
     mixer.mixWetSamples(context.getOutputBlock());
   }
 
+  /**
+   * Configure another ConvolutionWithMix object to use the same impulse
+   * response and mix as this one. The impulse response is shared between
+   * both objects rather than being loaded again.
+   */
+  void copyParametersTo(ConvolutionWithMix &other) const {
+    other.convolution.loadImpulseResponse(convolution);
+    other.setMix(mix);
+    other.impulseResponseFilename = impulseResponseFilename;
+    other.impulseResponse = impulseResponse;
+    other.sampleRate = sampleRate;
+  }
+
 private:
   juce::dsp::BlockingConvolution convolution;
   juce::dsp::DryWetMixer<float> mixer;
   float mix = 1.0;
   std::optional<std::string> impulseResponseFilename;
-  std::optional<juce::AudioBuffer<float>> impulseResponse;
+  std::shared_ptr<const juce::AudioBuffer<float>> impulseResponse;
   std::optional<double> sampleRate;
 };
 
+class Convolution : public JucePlugin<ConvolutionWithMix> {
+public:
+  virtual ~Convolution(){};
+
+  virtual std::shared_ptr<Plugin> clone() override {
+    auto plugin = std::make_shared<Convolution>();
+    getDSP().copyParametersTo(plugin->getDSP());
+    return plugin;
+  }
+};
+
 inline void init_convolution(py::module &m) {
-  py::class_<JucePlugin<ConvolutionWithMix>, Plugin,
-             std::shared_ptr<JucePlugin<ConvolutionWithMix>>>(
+  py::class_<Convolution, Plugin, std::shared_ptr<Convolution>>(
       m, "Convolution",
       "An audio convolution, suitable for things like speaker simulation or "
       "reverb modeling.\n\n"
       "The convolution impulse response can be specified either by filename or "
       "as a 32-bit floating point NumPy array. If a NumPy array is provided, "
       "the ``sample_rate`` argument must also be provided to indicate the "
-      "sample rate of the impulse response.\n\n*Support for passing NumPy "
+      "sample rate of the impulse response.\n\n"
+      "Convolution plugins that use the same impulse response at the same "
+      "sample rate and buffer size share a single, read-only copy of its "
+      "frequency-domain representation, which is only computed once. "
+      "(*Introduced in v0.9.22.*)\n\n*Support for passing NumPy "
       "arrays as impulse responses introduced in v0.9.10.*")
       .def(py::init([](std::variant<std::string,
                                     py::array_t<float, py::array::c_style>>
                            impulseResponse,
                        float mix, std::optional<double> sampleRate) {
-             auto plugin = std::make_unique<JucePlugin<ConvolutionWithMix>>();
+             auto plugin = std::make_unique<Convolution>();
 
              if (auto *impulseResponseFilename =
                      std::get_if<std::string>(&impulseResponse)) {
@@ -137,14 +165,16 @@ inline void init_convolution(py::module &m) {
                      "sample_rate must be provided when passing a numpy array "
                      "as an impulse response.");
                }
+               // Share a single copy of the impulse response between the
+               // convolution engine and the impulse_response property:
+               auto buffer = std::make_shared<const juce::AudioBuffer<float>>(
+                   copyPyArrayIntoJuceBuffer(*inputArray));
                plugin->getDSP().getConvolution().loadImpulseResponse(
-                   std::move(copyPyArrayIntoJuceBuffer(*inputArray)),
-                   *sampleRate, juce::dsp::Convolution::Stereo::yes,
+                   buffer, *sampleRate, juce::dsp::Convolution::Stereo::yes,
                    juce::dsp::Convolution::Trim::no,
                    juce::dsp::Convolution::Normalise::yes);
 
-               plugin->getDSP().setImpulseResponse(
-                   copyPyArrayIntoJuceBuffer(*inputArray));
+               plugin->getDSP().setImpulseResponse(buffer);
                plugin->getDSP().setSampleRate(*sampleRate);
              }
              plugin->getDSP().setMix(mix);
@@ -153,7 +183,7 @@ inline void init_convolution(py::module &m) {
            py::arg("impulse_response_filename"), py::arg("mix") = 1.0,
            py::arg("sample_rate") = py::none())
       .def("__repr__",
-           [](JucePlugin<ConvolutionWithMix> &plugin) {
+           [](Convolution &plugin) {
              std::ostringstream ss;
              ss << "<pedalboard.Convolution";
              if (plugin.getDSP().getImpulseResponseFilename()) {
@@ -175,12 +205,12 @@ inline void init_convolution(py::module &m) {
            })
       .def_property_readonly(
           "impulse_response_filename",
-          [](JucePlugin<ConvolutionWithMix> &plugin) {
+          [](Convolution &plugin) {
             return plugin.getDSP().getImpulseResponseFilename();
           })
       .def_property_readonly(
           "impulse_response",
-          [](JucePlugin<ConvolutionWithMix> &plugin)
+          [](Convolution &plugin)
               -> std::optional<py::array_t<float, py::array::c_style>> {
             if (plugin.getDSP().getImpulseResponse()) {
               return {copyJuceBufferIntoPyArray(
@@ -192,10 +222,10 @@ inline void init_convolution(py::module &m) {
           })
       .def_property(
           "mix",
-          [](JucePlugin<ConvolutionWithMix> &plugin) {
+          [](Convolution &plugin) {
             return plugin.getDSP().getMix();
           },
-          [](JucePlugin<ConvolutionWithMix> &plugin, double newMix) {
+          [](Convolution &plugin, double newMix) {
             return plugin.getDSP().setMix(newMix);
           });
 }
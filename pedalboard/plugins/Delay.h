@@ -16,6 +16,7 @@
  */
 
 #include "../JucePlugin.h"
+#include "../plugin_templates/DoublePrecision.h"
 
 namespace Pedalboard {
 template <typename SampleType>
@@ -96,6 +97,19 @@ public:
     return context.getInputBlock().getNumSamples();
   }
 
+  template <typename OtherSampleType>
+  void copyParametersTo(Delay<OtherSampleType> &other) const {
+    other.setDelaySeconds(getDelaySeconds());
+    other.setFeedback(getFeedback());
+    other.setMix(getMix());
+  }
+
+  virtual std::shared_ptr<Plugin> clone() override {
+    auto plugin = std::make_shared<Delay<SampleType>>();
+    copyParametersTo(*plugin);
+    return plugin;
+  }
+
 private:
   SampleType delaySeconds = 1.0f;
   SampleType feedback = 0.0f;
@@ -104,12 +118,13 @@ private:
 };
 
 inline void init_delay(py::module &m) {
-  py::class_<Delay<float>, Plugin, std::shared_ptr<Delay<float>>>(
+  py::class_<DoublePrecision<Delay>, Plugin,
+             std::shared_ptr<DoublePrecision<Delay>>>(
       m, "Delay",
       "A digital delay plugin with controllable delay time, feedback "
       "percentage, and dry/wet mix.")
       .def(py::init([](float delaySeconds, float feedback, float mix) {
-             auto delay = std::make_unique<Delay<float>>();
+             auto delay = std::make_unique<DoublePrecision<Delay>>();
              delay->setDelaySeconds(delaySeconds);
              delay->setFeedback(feedback);
              delay->setMix(mix);
@@ -118,7 +133,7 @@ inline void init_delay(py::module &m) {
            py::arg("delay_seconds") = 0.5, py::arg("feedback") = 0.0,
            py::arg("mix") = 0.5)
       .def("__repr__",
-           [](const Delay<float> &plugin) {
+           [](const DoublePrecision<Delay> &plugin) {
              std::ostringstream ss;
              ss << "<pedalboard.Delay";
              ss << " delay_seconds=" << plugin.getDelaySeconds();
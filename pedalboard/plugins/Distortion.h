@@ -41,6 +41,12 @@ public:
         [](SampleType x) { return std::tanh(x); };
   }
 
+  virtual std::shared_ptr<Plugin> clone() override {
+    auto plugin = std::make_shared<Distortion<SampleType>>();
+    plugin->setDriveDecibels(getDriveDecibels());
+    return plugin;
+  }
+
 private:
   SampleType driveDecibels;
 
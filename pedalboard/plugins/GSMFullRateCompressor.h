@@ -122,6 +122,8 @@ public:
     decoder.reset();
   }
 
+  void copyParametersTo(GSMFullRateCompressorInternal &other) const {}
+
   static constexpr size_t GSM_FRAME_SIZE_SAMPLES = 160;
   static constexpr int GSM_SAMPLE_RATE = 8000;
 
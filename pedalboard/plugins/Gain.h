@@ -21,28 +21,41 @@
 namespace py = pybind11;
 
 #include "../JucePlugin.h"
+#include "../plugin_templates/DoublePrecision.h"
 
 namespace Pedalboard {
 template <typename SampleType>
 class Gain : public JucePlugin<juce::dsp::Gain<SampleType>> {
   DEFINE_DSP_SETTER_AND_GETTER(SampleType, GainDecibels, {});
+
+  template <typename OtherSampleType>
+  void copyParametersTo(Gain<OtherSampleType> &other) const {
+    other.setGainDecibels(getGainDecibels());
+  }
+
+  virtual std::shared_ptr<Plugin> clone() override {
+    auto plugin = std::make_shared<Gain<SampleType>>();
+    copyParametersTo(*plugin);
+    return plugin;
+  }
 };
 
 inline void init_gain(py::module &m) {
-  py::class_<Gain<float>, Plugin, std::shared_ptr<Gain<float>>>(
+  py::class_<DoublePrecision<Gain>, Plugin,
+             std::shared_ptr<DoublePrecision<Gain>>>(
       m, "Gain",
       "A gain plugin that increases or decreases the volume of a signal by "
       "amplifying or attenuating it by the provided value (in decibels). No "
       "distortion or other effects are applied.\n\nThink of this as a volume "
       "control.")
       .def(py::init([](float gaindB) {
-             auto plugin = std::make_unique<Gain<float>>();
+             auto plugin = std::make_unique<DoublePrecision<Gain>>();
              plugin->setGainDecibels(gaindB);
              return plugin;
            }),
            py::arg("gain_db") = 1.0)
       .def("__repr__",
-           [](const Gain<float> &plugin) {
+           [](const DoublePrecision<Gain> &plugin) {
              std::ostringstream ss;
              ss << "<pedalboard.Gain";
              ss << " gain_db=" << plugin.getGainDecibels();
@@ -21,6 +21,7 @@
 namespace py = pybind11;
 
 #include "../JucePlugin.h"
+#include "../plugin_templates/DoublePrecision.h"
 
 namespace Pedalboard {
 template <typename SampleType>
@@ -40,28 +41,39 @@ public:
         juce::dsp::IIR::Coefficients<SampleType>>>::prepare(spec);
   }
 
+  template <typename OtherSampleType>
+  void copyParametersTo(HighpassFilter<OtherSampleType> &other) const {
+    other.setCutoffFrequencyHz(getCutoffFrequencyHz());
+  }
+
+  virtual std::shared_ptr<Plugin> clone() override {
+    auto plugin = std::make_shared<HighpassFilter<SampleType>>();
+    copyParametersTo(*plugin);
+    return plugin;
+  }
+
 private:
   float cutoffFrequencyHz;
 };
 
 inline void init_highpass(py::module &m) {
-  py::class_<HighpassFilter<float>, Plugin,
-             std::shared_ptr<HighpassFilter<float>>>(
+  py::class_<DoublePrecision<HighpassFilter>, Plugin,
+             std::shared_ptr<DoublePrecision<HighpassFilter>>>(
       m, "HighpassFilter",
       "Apply a first-order high-pass filter with a roll-off of 6dB/octave. "
       "The cutoff frequency will be attenuated by -3dB (i.e.: "
       R"(:math:`\\frac{1}{\\sqrt{2}}` as loud, expressed as a gain factor))"
       " and lower frequencies will be attenuated by a further 6dB per octave.)")
       .def(py::init([](float cutoff_frequency_hz) {
-             auto plugin = std::make_unique<HighpassFilter<float>>();
+             auto plugin = std::make_unique<DoublePrecision<HighpassFilter>>();
              plugin->setCutoffFrequencyHz(cutoff_frequency_hz);
              return plugin;
            }),
            py::arg("cutoff_frequency_hz") = 50)
       .def("__repr__",
-           [](const HighpassFilter<float> &plugin) {
+           [](const DoublePrecision<HighpassFilter> &plugin) {
              std::ostringstream ss;
-             ss << "<pedalboard.Highpass";
+             ss << "<pedalboard.HighpassFilter";
              ss << " cutoff_frequency_hz=" << plugin.getCutoffFrequencyHz();
              ss << " at " << &plugin;
              ss << ">";
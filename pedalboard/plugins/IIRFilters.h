@@ -21,6 +21,7 @@
 namespace py = pybind11;
 
 #include "../JucePlugin.h"
+#include "../plugin_templates/DoublePrecision.h"
 
 namespace Pedalboard {
 
@@ -74,6 +75,15 @@ public:
   }
 
 protected:
+  template <typename OtherSampleType>
+  void copyParametersTo(IIRFilter<OtherSampleType> &other) const {
+    other.cutoffFrequencyHz = cutoffFrequencyHz;
+    other.Q = Q;
+    other.gainFactor = gainFactor;
+  }
+
+  template <typename OtherSampleType> friend class IIRFilter;
+
   float cutoffFrequencyHz;
   float Q;
   float gainFactor;
@@ -91,6 +101,12 @@ public:
 
     IIRFilter<SampleType>::prepare(spec);
   }
+
+  virtual std::shared_ptr<Plugin> clone() override {
+    auto plugin = std::make_shared<HighShelfFilter<SampleType>>();
+    this->copyParametersTo(*plugin);
+    return plugin;
+  }
 };
 
 template <typename SampleType>
@@ -105,6 +121,12 @@ public:
 
     IIRFilter<SampleType>::prepare(spec);
   }
+
+  virtual std::shared_ptr<Plugin> clone() override {
+    auto plugin = std::make_shared<LowShelfFilter<SampleType>>();
+    this->copyParametersTo(*plugin);
+    return plugin;
+  }
 };
 
 template <typename SampleType> class PeakFilter : public IIRFilter<SampleType> {
@@ -117,6 +139,12 @@ public:
             this->Q, this->gainFactor);
     IIRFilter<SampleType>::prepare(spec);
   }
+
+  virtual std::shared_ptr<Plugin> clone() override {
+    auto plugin = std::make_shared<PeakFilter<SampleType>>();
+    this->copyParametersTo(*plugin);
+    return plugin;
+  }
 };
 
 inline void init_iir_filters(py::module &m) {
@@ -133,14 +161,14 @@ inline void init_iir_filters(py::module &m) {
         return nullptr;
       }));
 
-  py::class_<HighShelfFilter<float>, IIRFilter<float>,
-             std::shared_ptr<HighShelfFilter<float>>>(
+  py::class_<DoublePrecision<HighShelfFilter>, IIRFilter<float>,
+             std::shared_ptr<DoublePrecision<HighShelfFilter>>>(
       m, "HighShelfFilter",
       "A high shelf filter plugin with variable Q and gain, as would be used "
       "in an equalizer. Frequencies above the cutoff frequency will be boosted "
       "(or cut) by the provided gain (in decibels).")
       .def(py::init([](float cutoffFrequencyHz, float gaindB, float Q) {
-             auto plugin = std::make_unique<HighShelfFilter<float>>();
+             auto plugin = std::make_unique<DoublePrecision<HighShelfFilter>>();
              plugin->setCutoffFrequencyHz(cutoffFrequencyHz);
              plugin->setGainDecibels(gaindB);
              plugin->setQ(Q);
@@ -149,7 +177,7 @@ inline void init_iir_filters(py::module &m) {
            py::arg("cutoff_frequency_hz") = 440, py::arg("gain_db") = 0.0,
            py::arg("q") = (juce::MathConstants<float>::sqrt2 / 2.0))
       .def("__repr__",
-           [](const HighShelfFilter<float> &plugin) {
+           [](const DoublePrecision<HighShelfFilter> &plugin) {
              std::ostringstream ss;
              ss << "<pedalboard.HighShelfFilter";
              ss << " cutoff_frequency_hz=" << plugin.getCutoffFrequencyHz();
@@ -167,14 +195,14 @@ inline void init_iir_filters(py::module &m) {
       .def_property("q", &HighShelfFilter<float>::getQ,
                     &HighShelfFilter<float>::setQ);
 
-  py::class_<LowShelfFilter<float>, IIRFilter<float>,
-             std::shared_ptr<LowShelfFilter<float>>>(
+  py::class_<DoublePrecision<LowShelfFilter>, IIRFilter<float>,
+             std::shared_ptr<DoublePrecision<LowShelfFilter>>>(
       m, "LowShelfFilter",
       "A low shelf filter with variable Q and gain, as would be used in an "
       "equalizer. Frequencies below the cutoff frequency will be boosted (or "
       "cut) by the provided gain value.")
       .def(py::init([](float cutoffFrequencyHz, float gaindB, float Q) {
-             auto plugin = std::make_unique<LowShelfFilter<float>>();
+             auto plugin = std::make_unique<DoublePrecision<LowShelfFilter>>();
              plugin->setCutoffFrequencyHz(cutoffFrequencyHz);
              plugin->setGainDecibels(gaindB);
              plugin->setQ(Q);
@@ -183,7 +211,7 @@ inline void init_iir_filters(py::module &m) {
            py::arg("cutoff_frequency_hz") = 440, py::arg("gain_db") = 0.0,
            py::arg("q") = (juce::MathConstants<float>::sqrt2 / 2.0))
       .def("__repr__",
-           [](const LowShelfFilter<float> &plugin) {
+           [](const DoublePrecision<LowShelfFilter> &plugin) {
              std::ostringstream ss;
              ss << "<pedalboard.LowShelfFilter";
              ss << " cutoff_frequency_hz=" << plugin.getCutoffFrequencyHz();
@@ -201,14 +229,14 @@ inline void init_iir_filters(py::module &m) {
       .def_property("q", &LowShelfFilter<float>::getQ,
                     &LowShelfFilter<float>::setQ);
 
-  py::class_<PeakFilter<float>, IIRFilter<float>,
-             std::shared_ptr<PeakFilter<float>>>(
+  py::class_<DoublePrecision<PeakFilter>, IIRFilter<float>,
+             std::shared_ptr<DoublePrecision<PeakFilter>>>(
       m, "PeakFilter",
       "A peak (or notch) filter with variable Q and gain, as would be used in "
       "an equalizer. Frequencies around the cutoff frequency will be boosted "
       "(or cut) by the provided gain value.")
       .def(py::init([](float cutoffFrequencyHz, float gaindB, float Q) {
-             auto plugin = std::make_unique<PeakFilter<float>>();
+             auto plugin = std::make_unique<DoublePrecision<PeakFilter>>();
              plugin->setCutoffFrequencyHz(cutoffFrequencyHz);
              plugin->setGainDecibels(gaindB);
              plugin->setQ(Q);
@@ -217,7 +245,7 @@ inline void init_iir_filters(py::module &m) {
            py::arg("cutoff_frequency_hz") = 440, py::arg("gain_db") = 0.0,
            py::arg("q") = (juce::MathConstants<float>::sqrt2 / 2.0))
       .def("__repr__",
-           [](const PeakFilter<float> &plugin) {
+           [](const DoublePrecision<PeakFilter> &plugin) {
              std::ostringstream ss;
              ss << "<pedalboard.PeakFilter";
              ss << " cutoff_frequency_hz=" << plugin.getCutoffFrequencyHz();
@@ -21,6 +21,7 @@
 namespace py = pybind11;
 
 #include "../JucePlugin.h"
+#include "../plugin_templates/DoublePrecision.h"
 
 namespace Pedalboard {
 template <typename SampleType>
@@ -40,27 +41,38 @@ public:
         juce::dsp::IIR::Coefficients<SampleType>>>::prepare(spec);
   }
 
+  template <typename OtherSampleType>
+  void copyParametersTo(LowpassFilter<OtherSampleType> &other) const {
+    other.setCutoffFrequencyHz(getCutoffFrequencyHz());
+  }
+
+  virtual std::shared_ptr<Plugin> clone() override {
+    auto plugin = std::make_shared<LowpassFilter<SampleType>>();
+    copyParametersTo(*plugin);
+    return plugin;
+  }
+
 private:
   float cutoffFrequencyHz;
 };
 
 inline void init_lowpass(py::module &m) {
-  py::class_<LowpassFilter<float>, Plugin,
-             std::shared_ptr<LowpassFilter<float>>>(
+  py::class_<DoublePrecision<LowpassFilter>, Plugin,
+             std::shared_ptr<DoublePrecision<LowpassFilter>>>(
       m, "LowpassFilter",
       "Apply a first-order low-pass filter with a roll-off of 6dB/octave. "
       "The cutoff frequency will be attenuated by -3dB (i.e.: 0.707x as "
       "loud).")
       .def(py::init([](float cutoff_frequency_hz) {
-             auto plugin = std::make_unique<LowpassFilter<float>>();
+             auto plugin = std::make_unique<DoublePrecision<LowpassFilter>>();
              plugin->setCutoffFrequencyHz(cutoff_frequency_hz);
              return plugin;
            }),
            py::arg("cutoff_frequency_hz") = 50)
       .def("__repr__",
-           [](const LowpassFilter<float> &plugin) {
+           [](const DoublePrecision<LowpassFilter> &plugin) {
              std::ostringstream ss;
-             ss << "<pedalboard.Lowpass";
+             ss << "<pedalboard.LowpassFilter";
              ss << " cutoff_frequency_hz=" << plugin.getCutoffFrequencyHz();
              ss << " at " << &plugin;
              ss << ">";
@@ -166,6 +166,12 @@ public:
 
   float getVBRQuality() const { return vbrLevel; }
 
+  virtual std::shared_ptr<Plugin> clone() override {
+    auto plugin = std::make_shared<MP3Compressor>();
+    plugin->setVBRQuality(vbrLevel);
+    return plugin;
+  }
+
   virtual void prepare(const juce::dsp::ProcessSpec &spec) override {
     bool specChanged = lastSpec.sampleRate != spec.sampleRate ||
                        lastSpec.maximumBlockSize < spec.maximumBlockSize ||
@@ -18,9 +18,12 @@
 #pragma once
 
 #include "../JuceHeader.h"
+#include <atomic>
 #include <mutex>
 
 #include "../PluginContainer.h"
+#include "../Profiler.h"
+#include "../ThreadPool.h"
 
 namespace Pedalboard {
 /**
@@ -29,11 +32,21 @@ namespace Pedalboard {
  */
 class Mix : public PluginContainer {
 public:
-  Mix(std::vector<std::shared_ptr<Plugin>> plugins)
+  Mix(std::vector<std::shared_ptr<Plugin>> plugins, bool parallel = false)
       : PluginContainer(plugins), pluginBuffers(plugins.size()),
-        samplesAvailablePerPlugin(plugins.size()) {}
+        samplesAvailablePerPlugin(plugins.size()), parallel(parallel) {
+    // Created once here, as creating a std::function for every block of
+    // audio may allocate memory:
+    processBranchTask = [this](size_t i, size_t) {
+      Profiler::ScopedContext scopedProfilerContext(currentProfilerContext);
+      processBranch(i, *currentContext);
+    };
+  }
   virtual ~Mix(){};
 
+  bool isParallel() const { return parallel; }
+  void setParallel(bool newValue) { parallel = newValue; }
+
   virtual void prepare(const juce::dsp::ProcessSpec &spec) {
     for (auto plugin : plugins) {
       if (plugin) {
@@ -53,48 +66,16 @@ public:
   process(const juce::dsp::ProcessContextReplacing<float> &context) {
     auto ioBlock = context.getOutputBlock();
 
-    for (int i = 0; i < plugins.size(); i++) {
-      std::shared_ptr<Plugin> plugin = plugins[i];
-      juce::AudioBuffer<float> &buffer = pluginBuffers[i];
-
-      int startInBuffer = samplesAvailablePerPlugin[i];
-      int endInBuffer = startInBuffer + ioBlock.getNumSamples();
-      // If we don't have enough space, reallocate. (Reluctantly. This is the
-      // "audio thread!")
-      if (endInBuffer > buffer.getNumSamples()) {
-        buffer.setSize(buffer.getNumChannels(), endInBuffer);
-      }
-
-      // Copy the audio input into each of these buffers:
-      context.getInputBlock().copyTo(buffer, 0, samplesAvailablePerPlugin[i]);
-
-      float **channelPointers =
-          (float **)alloca(ioBlock.getNumChannels() * sizeof(float *));
-      for (int c = 0; c < buffer.getNumChannels(); c++) {
-        channelPointers[c] = buffer.getWritePointer(c, startInBuffer);
-      }
-
-      auto subBlock = juce::dsp::AudioBlock<float>(
-          channelPointers, buffer.getNumChannels(), ioBlock.getNumSamples());
-
-      juce::dsp::ProcessContextReplacing<float> subContext(subBlock);
-
-      int samplesRendered = subBlock.getNumSamples();
-
-      if (plugin) {
-        samplesRendered = plugin->process(subContext);
-      }
-      samplesAvailablePerPlugin[i] += samplesRendered;
-
-      if (samplesRendered < subBlock.getNumSamples()) {
-        // Left-align the results in the buffer, as we'll need all
-        // of the plugins' outputs to be aligned:
-        for (int c = 0; c < pluginBuffers[i].getNumChannels(); c++) {
-          std::memmove(channelPointers[c],
-                       channelPointers[c] +
-                           (subBlock.getNumSamples() - samplesRendered),
-                       sizeof(float) * samplesRendered);
-        }
+    ThreadPool *pool = getThreadPool();
+    if (pool) {
+      // Each branch has its own buffer and its own plugins, so branches can
+      // be rendered concurrently; parallelFor returns once all are done.
+      currentContext = &context;
+      currentProfilerContext = Profiler::getCurrentContext();
+      pool->parallelFor(plugins.size(), processBranchTask);
+    } else {
+      for (int i = 0; i < plugins.size(); i++) {
+        processBranch(i, context);
       }
     }
 
@@ -149,7 +130,7 @@ public:
       }
     }
 
-    for (auto buffer : pluginBuffers)
+    for (auto &buffer : pluginBuffers)
       buffer.clear();
   }
 
@@ -163,21 +144,121 @@ public:
     return maxHint;
   }
 
+  virtual std::shared_ptr<Plugin> clone() override {
+    auto clonedPlugins = clonePlugins(plugins);
+    if (!clonedPlugins) {
+      return nullptr;
+    }
+    return std::make_shared<Mix>(*clonedPlugins, isParallel());
+  }
+
 protected:
+  /**
+   * Render the input audio through the i-th plugin, appending its output to
+   * the end of the i-th buffer. Only touches state belonging to that plugin,
+   * so may be called for different plugins on different threads at once.
+   */
+  void processBranch(int i,
+                     const juce::dsp::ProcessContextReplacing<float> &context) {
+    auto ioBlock = context.getOutputBlock();
+    std::shared_ptr<Plugin> plugin = plugins[i];
+    juce::AudioBuffer<float> &buffer = pluginBuffers[i];
+
+    int startInBuffer = samplesAvailablePerPlugin[i];
+    int endInBuffer = startInBuffer + ioBlock.getNumSamples();
+    // If we don't have enough space, reallocate. (Reluctantly. This is the
+    // "audio thread!")
+    if (endInBuffer > buffer.getNumSamples()) {
+      buffer.setSize(buffer.getNumChannels(), endInBuffer,
+                     /* keepExistingContent= */ true);
+    }
+
+    // Copy the audio input into each of these buffers:
+    context.getInputBlock().copyTo(buffer, 0, samplesAvailablePerPlugin[i]);
+
+    float **channelPointers =
+        (float **)alloca(ioBlock.getNumChannels() * sizeof(float *));
+    for (int c = 0; c < buffer.getNumChannels(); c++) {
+      channelPointers[c] = buffer.getWritePointer(c, startInBuffer);
+    }
+
+    auto subBlock = juce::dsp::AudioBlock<float>(
+        channelPointers, buffer.getNumChannels(), ioBlock.getNumSamples());
+
+    juce::dsp::ProcessContextReplacing<float> subContext(subBlock);
+
+    int samplesRendered = subBlock.getNumSamples();
+
+    if (plugin) {
+      samplesRendered = profiledProcess(plugin, subContext);
+    }
+    samplesAvailablePerPlugin[i] += samplesRendered;
+
+    if (samplesRendered < subBlock.getNumSamples()) {
+      // Left-align the results in the buffer, as we'll need all
+      // of the plugins' outputs to be aligned:
+      for (int c = 0; c < pluginBuffers[i].getNumChannels(); c++) {
+        std::memmove(channelPointers[c],
+                     channelPointers[c] +
+                         (subBlock.getNumSamples() - samplesRendered),
+                     sizeof(float) * samplesRendered);
+      }
+    }
+  }
+
+  /**
+   * Return the thread pool used to render branches in parallel, creating it
+   * if necessary, or nullptr if branches should be rendered sequentially.
+   */
+  ThreadPool *getThreadPool() {
+    if (!parallel || plugins.size() < 2) {
+      return nullptr;
+    }
+
+    size_t numThreads =
+        std::min(plugins.size(), ThreadPool::getDefaultNumThreads());
+    if (numThreads < 2) {
+      return nullptr;
+    }
+
+    if (!threadPool || threadPool->getNumWorkers() != numThreads) {
+      threadPool = std::make_unique<ThreadPool>(numThreads);
+    }
+    return threadPool.get();
+  }
+
   std::vector<juce::AudioBuffer<float>> pluginBuffers;
   std::vector<int> samplesAvailablePerPlugin;
+
+  std::atomic<bool> parallel;
+  std::unique_ptr<ThreadPool> threadPool;
+  ThreadPool::Task processBranchTask;
+
+  // The arguments to processBranchTask for the block being processed:
+  const juce::dsp::ProcessContextReplacing<float> *currentContext = nullptr;
+  Profiler::Context currentProfilerContext = {};
 };
 
 inline void init_mix(py::module &m) {
   py::class_<Mix, PluginContainer, std::shared_ptr<Mix>>(
       m, "Mix",
       "A utility plugin that allows running other plugins in parallel. All "
-      "plugins provided will be mixed equally.")
-      .def(py::init([](std::vector<std::shared_ptr<Plugin>> plugins) {
-             return new Mix(plugins);
-           }),
-           py::arg("plugins"))
+      "plugins provided will be mixed equally.\n\n"
+      "If ``parallel`` is ``True``, each of the provided plugins will be run "
+      "on its own thread (up to one thread per CPU core), which can speed up "
+      "processing when each plugin does a lot of work (i.e.: reverbs, "
+      "convolutions, pitch shifting, or long chains of plugins). For "
+      "lightweight plugins or small buffer sizes, the overhead of "
+      "coordinating threads may outweigh the benefit. (*Introduced in "
+      "v0.9.22.*)")
+      .def(py::init([](std::vector<std::shared_ptr<Plugin>> plugins,
+                       bool parallel) { return new Mix(plugins, parallel); }),
+           py::arg("plugins"), py::arg("parallel") = false)
       .def(py::init([]() { return new Mix({}); }))
+      .def_property(
+          "parallel", &Mix::isParallel, &Mix::setParallel,
+          "If ``True``, each of this plugin's branches will be processed on "
+          "a separate thread.\n\n*Introduced in v0.9.22.*")
       .def("__repr__", [](Mix &plugin) {
         std::ostringstream ss;
         ss << "<pedalboard.Mix with " << plugin.getPlugins().size()
@@ -193,7 +274,11 @@ inline void init_mix(py::module &m) {
             ss << ", ";
           }
         }
-        ss << "] at " << &plugin;
+        ss << "]";
+        if (plugin.isParallel()) {
+          ss << " parallel=True";
+        }
+        ss << " at " << &plugin;
         ss << ">";
         return ss.str();
       });
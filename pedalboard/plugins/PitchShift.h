@@ -56,6 +56,12 @@ public:
     PrimeWithSilence<RubberbandPlugin>::prepare(spec);
     getNestedPlugin().getStretcher().setPitchScale(getScaleFactor());
   }
+
+  virtual std::shared_ptr<Plugin> clone() override {
+    auto plugin = std::make_shared<PitchShift>();
+    plugin->setSemitones(_semitones);
+    return plugin;
+  }
 };
 
 inline void init_pitch_shift(py::module &m) {
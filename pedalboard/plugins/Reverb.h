@@ -74,6 +74,17 @@ public:
     parameters.freezeMode = value;
     this->getDSP().setParameters(parameters);
   }
+
+  virtual std::shared_ptr<Plugin> clone() override {
+    auto plugin = std::make_shared<Reverb>();
+    plugin->setRoomSize(getRoomSize());
+    plugin->setDamping(getDamping());
+    plugin->setWetLevel(getWetLevel());
+    plugin->setDryLevel(getDryLevel());
+    plugin->setWidth(getWidth());
+    plugin->setFreezeMode(getFreezeMode());
+    return plugin;
+  }
 };
 
 inline void init_reverb(py::module &m) {
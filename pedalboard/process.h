@@ -22,17 +22,22 @@
 #include <pybind11/pybind11.h>
 
 #include "BufferUtils.h"
+#include "Pipeline.h"
 #include "Plugin.h"
 #include "PluginContainer.h"
+#include "Profiler.h"
+#include "ScratchArena.h"
+#include "ThreadPool.h"
 
 namespace py = pybind11;
 
 namespace Pedalboard {
 
-inline int process(juce::AudioBuffer<float> &ioBuffer,
-                   juce::dsp::ProcessSpec spec,
-                   const std::vector<std::shared_ptr<Plugin>> &plugins,
-                   bool isProbablyLastProcessCall) {
+template <typename SampleType>
+int process(juce::AudioBuffer<SampleType> &ioBuffer,
+            juce::dsp::ProcessSpec spec,
+            const std::vector<std::shared_ptr<Plugin>> &plugins,
+            bool isProbablyLastProcessCall) {
   int totalOutputLatencySamples = 0;
   int expectedOutputLatency = 0;
 
@@ -73,12 +78,12 @@ inline int process(juce::AudioBuffer<float> &ioBuffer,
                    static_cast<unsigned int>(intendedOutputBufferSize));
       blockSize = blockEnd - blockStart;
 
-      auto ioBlock = juce::dsp::AudioBlock<float>(
+      auto ioBlock = juce::dsp::AudioBlock<SampleType>(
           ioBuffer.getArrayOfWritePointers(), ioBuffer.getNumChannels(),
           blockStart, blockSize);
-      juce::dsp::ProcessContextReplacing<float> context(ioBlock);
+      juce::dsp::ProcessContextReplacing<SampleType> context(ioBlock);
 
-      int outputSamples = plugin->process(context);
+      int outputSamples = profiledProcess(plugin, context);
       if (outputSamples < 0) {
         throw std::runtime_error(
             "A plugin returned a negative number of output samples! "
@@ -112,14 +117,14 @@ inline int process(juce::AudioBuffer<float> &ioBuffer,
           // Only move the samples received before this latest block was
           // rendered, as audio is right-aligned within blocks by convention.
           int samplesToMove = pluginSamplesReceived - outputSamples;
-          float *outputStart =
+          SampleType *outputStart =
               ioBuffer.getWritePointer(c) + totalOutputLatencySamples;
-          float *expectedOutputEnd =
+          SampleType *expectedOutputEnd =
               ioBuffer.getWritePointer(c) + blockEnd - outputSamples;
-          float *expectedOutputStart = expectedOutputEnd - samplesToMove;
+          SampleType *expectedOutputStart = expectedOutputEnd - samplesToMove;
 
           std::memmove((char *)expectedOutputStart, (char *)outputStart,
-                       sizeof(float) * samplesToMove);
+                       sizeof(SampleType) * samplesToMove);
         }
       }
 
@@ -154,15 +159,79 @@ inline int process(juce::AudioBuffer<float> &ioBuffer,
   return intendedOutputBufferSize - totalOutputLatencySamples;
 }
 
+/**
+ * Lock all of the provided plugins (and any plugins nested within them),
+ * throwing an exception if the same plugin instance appears more than once.
+ * The plugins remain locked until the returned vector is destroyed.
+ *
+ * This method does not interact with Python, and should be called with the
+ * GIL released.
+ */
+inline std::vector<std::unique_ptr<std::scoped_lock<std::mutex>>>
+lockPlugins(const std::vector<std::shared_ptr<Plugin>> &plugins) {
+  // We'd pass multiple arguments to scoped_lock here, but we don't know how
+  // many plugins have been passed at compile time - so instead, we do our own
+  // deadlock-avoiding multiple-lock algorithm here. By locking each plugin
+  // only in order of its pointers, we're guaranteed to avoid deadlocks with
+  // other threads that may be running this same code on the same plugins.
+  std::vector<std::shared_ptr<Plugin>> allPlugins;
+  for (auto plugin : plugins) {
+    if (!plugin)
+      continue;
+    allPlugins.push_back(plugin);
+    if (auto pluginContainer = dynamic_cast<PluginContainer *>(plugin.get())) {
+      auto children = pluginContainer->getAllPlugins();
+      allPlugins.insert(allPlugins.end(), children.begin(), children.end());
+    }
+  }
+
+  std::sort(allPlugins.begin(), allPlugins.end(),
+            [](const std::shared_ptr<Plugin> lhs,
+               const std::shared_ptr<Plugin> rhs) {
+              return lhs.get() < rhs.get();
+            });
+
+  bool containsDuplicates =
+      std::adjacent_find(allPlugins.begin(), allPlugins.end()) !=
+      allPlugins.end();
+
+  if (containsDuplicates) {
+    throw std::runtime_error(
+        "The same plugin instance is being used multiple times in the same "
+        "chain of plugins, which would cause undefined results. Please "
+        "ensure that no duplicate plugins are present before calling.");
+  }
+
+  std::vector<std::unique_ptr<std::scoped_lock<std::mutex>>> pluginLocks;
+  for (auto plugin : allPlugins) {
+    pluginLocks.push_back(
+        std::make_unique<std::scoped_lock<std::mutex>>(plugin->mutex));
+  }
+  return pluginLocks;
+}
+
 /**
  * Process a given audio buffer through a list of
- * Pedalboard plugins at a given sample rate.
- * Only supports float processing, not double, at the moment.
+ * Pedalboard plugins at a given sample rate, as either 32-bit or 64-bit
+ * floating point audio. (Only call this with 64-bit audio if all of the
+ * plugins support it; see supportsDoublePrecision.)
+ *
+ * If an output array is provided (which must have the same shape as the
+ * input array, and may be the input array itself), the processed audio is
+ * written into it and a view of it is returned. If the input's channels are
+ * not interleaved, processing happens directly in the output array's memory,
+ * avoiding all intermediate copies unless the plugins add latency.
+ *
+ * If a profiler is provided, the time spent in each plugin will be recorded.
  */
-py::array_t<float>
-processFloat32(const py::array_t<float, py::array::c_style> inputArray,
-               double sampleRate, std::vector<std::shared_ptr<Plugin>> plugins,
-               unsigned int bufferSize, bool reset) {
+template <typename SampleType>
+py::array_t<SampleType>
+processArray(const py::array_t<SampleType, py::array::c_style> inputArray,
+             double sampleRate, std::vector<std::shared_ptr<Plugin>> plugins,
+             unsigned int bufferSize, bool reset,
+             std::optional<py::array_t<SampleType, py::array::c_style>>
+                 outputArray = {},
+             std::shared_ptr<Profiler> profiler = nullptr) {
 
   ChannelLayout inputChannelLayout;
   if (!plugins.empty()) {
@@ -171,30 +240,44 @@ processFloat32(const py::array_t<float, py::array::c_style> inputArray,
     inputChannelLayout = detectChannelLayout(inputArray);
   }
 
-  juce::AudioBuffer<float> ioBuffer =
-      copyPyArrayIntoJuceBuffer(inputArray, {inputChannelLayout});
+  bool processInOutputArray =
+      outputArray && inputChannelLayout == ChannelLayout::NotInterleaved;
+  if (processInOutputArray && outputArray->data() != inputArray.data()) {
+    std::memmove(outputArray->mutable_data(), inputArray.data(),
+                 sizeof(SampleType) * inputArray.size());
+  }
+
+  juce::AudioBuffer<SampleType> ioBuffer =
+      processInOutputArray
+          ? juce::AudioBuffer<SampleType>(convertPyArrayIntoJuceBuffer(
+                *outputArray, {inputChannelLayout}))
+          : copyPyArrayIntoJuceBuffer(inputArray, {inputChannelLayout});
 
   if (ioBuffer.getNumChannels() == 0) {
+    if (outputArray) {
+      return *outputArray;
+    }
+
     unsigned int numChannels = 0;
     unsigned int numSamples = ioBuffer.getNumSamples();
     // We have no channels to process; just return an empty output array with
     // the same shape. Passing zero channels into JUCE breaks some assumptions
     // all over the place.
-    py::array_t<float> outputArray;
+    py::array_t<SampleType> outputArray;
     if (inputArray.request().ndim == 2) {
       switch (inputChannelLayout) {
       case ChannelLayout::Interleaved:
-        outputArray = py::array_t<float>({numSamples, numChannels});
+        outputArray = py::array_t<SampleType>({numSamples, numChannels});
         break;
       case ChannelLayout::NotInterleaved:
-        outputArray = py::array_t<float>({numChannels, numSamples});
+        outputArray = py::array_t<SampleType>({numChannels, numSamples});
         break;
       default:
         throw std::runtime_error(
             "Internal error: got unexpected channel layout.");
       }
     } else {
-      outputArray = py::array_t<float>(0);
+      outputArray = py::array_t<SampleType>(0);
     }
     return outputArray;
   }
@@ -206,45 +289,7 @@ processFloat32(const py::array_t<float, py::array::c_style> inputArray,
 
     bufferSize = std::min(bufferSize, (unsigned int)ioBuffer.getNumSamples());
 
-    // We'd pass multiple arguments to scoped_lock here, but we don't know how
-    // many plugins have been passed at compile time - so instead, we do our own
-    // deadlock-avoiding multiple-lock algorithm here. By locking each plugin
-    // only in order of its pointers, we're guaranteed to avoid deadlocks with
-    // other threads that may be running this same code on the same plugins.
-    std::vector<std::shared_ptr<Plugin>> allPlugins;
-    for (auto plugin : plugins) {
-      if (!plugin)
-        continue;
-      allPlugins.push_back(plugin);
-      if (auto pluginContainer =
-              dynamic_cast<PluginContainer *>(plugin.get())) {
-        auto children = pluginContainer->getAllPlugins();
-        allPlugins.insert(allPlugins.end(), children.begin(), children.end());
-      }
-    }
-
-    std::sort(allPlugins.begin(), allPlugins.end(),
-              [](const std::shared_ptr<Plugin> lhs,
-                 const std::shared_ptr<Plugin> rhs) {
-                return lhs.get() < rhs.get();
-              });
-
-    bool containsDuplicates =
-        std::adjacent_find(allPlugins.begin(), allPlugins.end()) !=
-        allPlugins.end();
-
-    if (containsDuplicates) {
-      throw std::runtime_error(
-          "The same plugin instance is being used multiple times in the same "
-          "chain of plugins, which would cause undefined results. Please "
-          "ensure that no duplicate plugins are present before calling.");
-    }
-
-    std::vector<std::unique_ptr<std::scoped_lock<std::mutex>>> pluginLocks;
-    for (auto plugin : allPlugins) {
-      pluginLocks.push_back(
-          std::make_unique<std::scoped_lock<std::mutex>>(plugin->mutex));
-    }
+    auto pluginLocks = lockPlugins(plugins);
 
     if (reset) {
       for (auto plugin : plugins) {
@@ -266,33 +311,361 @@ processFloat32(const py::array_t<float, py::array::c_style> inputArray,
     }
 
     // Actually run the process method of all plugins.
-    int samplesReturned = process(ioBuffer, spec, plugins, reset);
+    Profiler::ScopedActivation activeProfiler(profiler.get());
+    AllocationCounter::ScopedCounting countAllocations;
+    int samplesReturned;
+
+    // Pipelined processing only supports 32-bit audio; 64-bit audio is
+    // always processed on the current thread.
+    if constexpr (std::is_same_v<SampleType, float>) {
+      auto *container = plugins.size() == 1
+                            ? dynamic_cast<PluginContainer *>(plugins[0].get())
+                            : nullptr;
+      if (container && container->isPipelined()) {
+        samplesReturned = processPipelined(ioBuffer, spec,
+                                           container->getPlugins(), reset);
+      } else {
+        samplesReturned = process(ioBuffer, spec, plugins, reset);
+      }
+    } else {
+      samplesReturned = process(ioBuffer, spec, plugins, reset);
+    }
     totalOutputLatencySamples = ioBuffer.getNumSamples() - samplesReturned;
   }
 
+  if (outputArray) {
+    return copyJuceBufferIntoExistingPyArray(ioBuffer, inputChannelLayout,
+                                             totalOutputLatencySamples,
+                                             *outputArray);
+  }
+
   return copyJuceBufferIntoPyArray(ioBuffer, inputChannelLayout,
                                    totalOutputLatencySamples,
                                    inputArray.request().ndim);
 }
 
-py::array_t<float> process(py::array inputArray, double sampleRate,
-                           const std::vector<std::shared_ptr<Plugin>> plugins,
-                           unsigned int bufferSize, bool reset) {
-  py::array_t<float, py::array::c_style> float32InputArray;
+/**
+ * Convert a 32-bit or 64-bit floating point NumPy array into a C-contiguous
+ * 32-bit float array, copying only if necessary.
+ */
+inline py::array_t<float, py::array::c_style>
+asFloat32Array(py::array inputArray) {
+  switch (inputArray.dtype().char_()) {
+  case 'f':
+    return inputArray;
+  case 'd':
+    return inputArray.attr("astype")("float32");
+  default:
+    throw py::type_error("Pedalboard only supports 32-bit and 64-bit floating "
+                         "point audio for processing.");
+  }
+}
+
+/**
+ * Convert a 32-bit or 64-bit floating point NumPy array into a C-contiguous
+ * 64-bit float array, copying only if necessary.
+ */
+inline py::array_t<double, py::array::c_style>
+asFloat64Array(py::array inputArray) {
   switch (inputArray.dtype().char_()) {
   case 'f':
-    float32InputArray = inputArray;
-    break;
+    return inputArray.attr("astype")("float64");
   case 'd':
-    float32InputArray = inputArray.attr("astype")("float32");
-    break;
+    return inputArray;
   default:
     throw py::type_error("Pedalboard only supports 32-bit and 64-bit floating "
                          "point audio for processing.");
   }
+}
+
+/**
+ * Check that the provided NumPy array can be used as the output of a call to
+ * process() with the provided input array, and convert it to an array of
+ * SampleType without copying.
+ */
+template <typename SampleType>
+py::array_t<SampleType, py::array::c_style>
+asOutputArray(py::array outputArray, py::array inputArray) {
+  if (outputArray.dtype().char_() != py::format_descriptor<SampleType>::c) {
+    throw py::type_error(
+        std::string("Pedalboard can only write processed audio into a ") +
+        (std::is_same_v<SampleType, double> ? "64-bit" : "32-bit") +
+        " floating point array here, but the provided output array has "
+        "dtype " +
+        py::str(outputArray.dtype()).cast<std::string>() +
+        ". (Output arrays must be 64-bit if and only if double_precision "
+        "is True.)");
+  }
+
+  if (!(outputArray.flags() & py::array::c_style)) {
+    throw std::domain_error(
+        "The provided output array must be C-contiguous. (Try passing "
+        "numpy.ascontiguousarray(...) instead.)");
+  }
+
+  if (!outputArray.writeable()) {
+    throw std::domain_error("The provided output array is not writeable.");
+  }
+
+  bool shapesMatch = outputArray.ndim() == inputArray.ndim();
+  for (py::ssize_t i = 0; shapesMatch && i < inputArray.ndim(); i++) {
+    shapesMatch = outputArray.shape(i) == inputArray.shape(i);
+  }
+
+  if (!shapesMatch) {
+    throw std::domain_error(
+        "The provided output array must have the same shape as the input "
+        "array (" +
+        py::str(inputArray.attr("shape")).cast<std::string>() +
+        "), but has shape " +
+        py::str(outputArray.attr("shape")).cast<std::string>() + ".");
+  }
 
-  return processFloat32(float32InputArray, sampleRate, plugins, bufferSize,
-                        reset);
+  return py::reinterpret_borrow<py::array_t<SampleType, py::array::c_style>>(
+      outputArray);
+}
+
+/**
+ * Returns true iff all of the provided plugins can process 64-bit audio
+ * without converting it.
+ */
+inline bool
+supportsDoublePrecision(const std::vector<std::shared_ptr<Plugin>> &plugins) {
+  for (auto plugin : plugins) {
+    if (plugin && !plugin->supportsDoublePrecision())
+      return false;
+  }
+  return true;
+}
+
+/**
+ * Process a NumPy array of 32-bit or 64-bit floating point audio through a
+ * list of plugins.
+ *
+ * The sample type used for processing depends only on doublePrecision, never
+ * on the input's dtype or on which plugins are provided: by default, audio is
+ * processed (and returned) as 32-bit floats, and 64-bit input is converted.
+ * If doublePrecision is true, audio is processed and returned as 64-bit
+ * floats, and all of the provided plugins must support 64-bit processing.
+ * The same rule applies to outputArray, which must have the same dtype as
+ * the returned array.
+ */
+py::array process(py::array inputArray, double sampleRate,
+                  const std::vector<std::shared_ptr<Plugin>> plugins,
+                  unsigned int bufferSize, bool reset,
+                  std::optional<py::array> outputArray = {},
+                  bool inplace = false,
+                  std::shared_ptr<Profiler> profiler = nullptr,
+                  bool doublePrecision = false) {
+  if (doublePrecision && !supportsDoublePrecision(plugins)) {
+    throw std::domain_error(
+        "double_precision=True was passed, but not all of the provided "
+        "plugins support 64-bit processing. (See "
+        "Plugin.supports_double_precision.)");
+  }
+
+  if (inplace) {
+    if (outputArray && !outputArray->is(inputArray)) {
+      throw std::domain_error(
+          "Only one of `out` or `inplace` may be provided at once.");
+    }
+    char expectedType = doublePrecision ? 'd' : 'f';
+    if (inputArray.dtype().char_() != expectedType) {
+      throw py::type_error(
+          std::string("In-place processing is only supported for ") +
+          (doublePrecision ? "64-bit" : "32-bit") +
+          " floating point audio here, but the provided array has dtype " +
+          py::str(inputArray.dtype()).cast<std::string>() +
+          ". (Arrays must be 64-bit if and only if double_precision is "
+          "True.)");
+    }
+    outputArray = inputArray;
+  }
+
+  if (doublePrecision) {
+    std::optional<py::array_t<double, py::array::c_style>> output;
+    if (outputArray) {
+      output = asOutputArray<double>(*outputArray, inputArray);
+    }
+    return processArray<double>(asFloat64Array(inputArray), sampleRate,
+                                plugins, bufferSize, reset, output, profiler);
+  }
+
+  std::optional<py::array_t<float, py::array::c_style>> output;
+  if (outputArray) {
+    output = asOutputArray<float>(*outputArray, inputArray);
+  }
+  return processArray<float>(asFloat32Array(inputArray), sampleRate, plugins,
+                             bufferSize, reset, output, profiler);
+}
+
+/**
+ * Process a batch of independent audio buffers through the same list of
+ * Pedalboard plugins, spreading the work across multiple native threads.
+ *
+ * Each buffer is processed as if it were passed to process() with
+ * reset=True. To allow buffers to be rendered concurrently, each worker
+ * thread renders into its own clone of the provided plugins. If any plugin
+ * cannot be cloned, all buffers are rendered on a single thread instead.
+ *
+ * If inputs is a three-dimensional NumPy array, the outputs are returned
+ * stacked into a single three-dimensional array; otherwise, a list of arrays
+ * is returned.
+ */
+inline py::object
+processBatch(py::object inputs, double sampleRate,
+             const std::vector<std::shared_ptr<Plugin>> &plugins,
+             unsigned int bufferSize, int numThreads) {
+  bool returnStackedArray = false;
+  if (py::isinstance<py::array>(inputs)) {
+    if (inputs.cast<py::array>().ndim() != 3) {
+      throw std::domain_error(
+          "Expected a list of audio buffers or a three-dimensional array of "
+          "shape (batch_size, num_channels, num_samples) or (batch_size, "
+          "num_samples, num_channels), but got an array with " +
+          std::to_string(inputs.cast<py::array>().ndim()) + " dimensions.");
+    }
+    returnStackedArray = true;
+  }
+
+  if (bufferSize == 0) {
+    throw std::domain_error("buffer_size must be greater than 0.");
+  }
+
+  std::vector<juce::AudioBuffer<float>> buffers;
+  std::vector<ChannelLayout> channelLayouts;
+  std::vector<int> inputDimensions;
+
+  for (py::handle item : inputs) {
+    py::array itemArray = py::array::ensure(item);
+    if (!itemArray) {
+      throw py::type_error("Expected each item in the batch to be a NumPy "
+                           "array, but got: " +
+                           py::repr(item).cast<std::string>());
+    }
+
+    py::array_t<float, py::array::c_style> float32Array =
+        asFloat32Array(itemArray);
+
+    ChannelLayout channelLayout;
+    if (!plugins.empty() && plugins[0]) {
+      channelLayout = plugins[0]->parseAndCacheChannelLayout(float32Array);
+    } else {
+      channelLayout = detectChannelLayout(float32Array);
+    }
+
+    buffers.push_back(copyPyArrayIntoJuceBuffer(float32Array, {channelLayout}));
+    channelLayouts.push_back(channelLayout);
+    inputDimensions.push_back(float32Array.request().ndim);
+  }
+
+  std::vector<int> outputLatencies(buffers.size(), 0);
+
+  {
+    py::gil_scoped_release release;
+
+    auto pluginLocks = lockPlugins(plugins);
+
+    size_t numWorkers =
+        numThreads > 0 ? numThreads : ThreadPool::getDefaultNumThreads();
+    numWorkers = std::max<size_t>(1, std::min(numWorkers, buffers.size()));
+
+    // The first worker uses the provided plugins directly; all others get
+    // their own independent copies, which are never visible to Python.
+    std::vector<std::vector<std::shared_ptr<Plugin>>> pluginsPerWorker = {
+        plugins};
+    while (pluginsPerWorker.size() < numWorkers) {
+      auto clonedPlugins = clonePlugins(plugins);
+      if (!clonedPlugins)
+        break;
+      pluginsPerWorker.push_back(*clonedPlugins);
+    }
+
+    ThreadPool threadPool(pluginsPerWorker.size());
+    threadPool.parallelFor(
+        buffers.size(), [&](size_t itemIndex, size_t workerIndex) {
+          juce::AudioBuffer<float> &ioBuffer = buffers[itemIndex];
+          if (ioBuffer.getNumChannels() == 0 || ioBuffer.getNumSamples() == 0)
+            return;
+
+          const auto &workerPlugins = pluginsPerWorker[workerIndex];
+
+          juce::dsp::ProcessSpec spec;
+          spec.sampleRate = sampleRate;
+          spec.maximumBlockSize = static_cast<juce::uint32>(
+              std::min(bufferSize, (unsigned int)ioBuffer.getNumSamples()));
+          spec.numChannels =
+              static_cast<juce::uint32>(ioBuffer.getNumChannels());
+
+          for (auto plugin : workerPlugins) {
+            if (!plugin)
+              continue;
+            plugin->reset();
+          }
+
+          for (auto plugin : workerPlugins) {
+            if (!plugin)
+              continue;
+            plugin->prepare(spec);
+          }
+
+          int samplesReturned = process(ioBuffer, spec, workerPlugins, true);
+          outputLatencies[itemIndex] =
+              ioBuffer.getNumSamples() - samplesReturned;
+        });
+  }
+
+  if (returnStackedArray) {
+    // All items in a three-dimensional input array have the same shape,
+    // so (as we reset before each item) all outputs should too:
+    unsigned int numChannels = 0, numSamples = 0;
+    for (size_t i = 0; i < buffers.size(); i++) {
+      unsigned int outputChannels = buffers[i].getNumChannels();
+      unsigned int outputSamples =
+          std::max(buffers[i].getNumSamples() - outputLatencies[i], 0);
+      if (i > 0 &&
+          (outputChannels != numChannels || outputSamples != numSamples)) {
+        throw std::runtime_error(
+            "Internal error: batch outputs did not all have the same shape.");
+      }
+      numChannels = outputChannels;
+      numSamples = outputSamples;
+    }
+
+    ChannelLayout channelLayout =
+        channelLayouts.empty() ? ChannelLayout::NotInterleaved
+                               : channelLayouts[0];
+    py::array_t<float> outputArray;
+    switch (channelLayout) {
+    case ChannelLayout::Interleaved:
+      outputArray = py::array_t<float>(
+          {(unsigned int)buffers.size(), numSamples, numChannels});
+      break;
+    case ChannelLayout::NotInterleaved:
+      outputArray = py::array_t<float>(
+          {(unsigned int)buffers.size(), numChannels, numSamples});
+      break;
+    default:
+      throw std::runtime_error(
+          "Internal error: got unexpected channel layout.");
+    }
+
+    float *outputPointer = static_cast<float *>(outputArray.request().ptr);
+    for (size_t i = 0; i < buffers.size(); i++) {
+      copyJuceBufferIntoPointer(buffers[i], channelLayout, outputLatencies[i],
+                                outputPointer +
+                                    (i * (size_t)numChannels * numSamples));
+    }
+    return outputArray;
+  }
+
+  py::list outputs;
+  for (size_t i = 0; i < buffers.size(); i++) {
+    outputs.append(copyJuceBufferIntoPyArray(buffers[i], channelLayouts[i],
+                                             outputLatencies[i],
+                                             inputDimensions[i]));
+  }
+  return outputs;
 }
 
 } // namespace Pedalboard
\ No newline at end of file
@@ -31,6 +31,8 @@ namespace py = pybind11;
 #include "JucePlugin.h"
 #include "Plugin.h"
 #include "PluginContainer.h"
+#include "Profiler.h"
+#include "ScratchArena.h"
 #include "TimeStretch.h"
 #include "process.h"
 
@@ -65,6 +67,8 @@ namespace py = pybind11;
 
 #include "io/AudioFileInit.h"
 #include "io/AudioStream.h"
+#include "io/LoadMany.h"
+#include "io/Probe.h"
 #include "io/ReadableAudioFile.h"
 #include "io/ResampledReadableAudioFile.h"
 #include "io/StreamResampler.h"
@@ -89,13 +93,17 @@ PYBIND11_MODULE(pedalboard_native, m, py::mod_gil_not_used()) {
       "process",
       [](const py::array inputArray, double sampleRate,
          const std::vector<std::shared_ptr<Plugin>> plugins,
-         unsigned int bufferSize, bool reset) {
-        return process(inputArray, sampleRate, plugins, bufferSize, reset);
+         unsigned int bufferSize, bool reset, std::optional<py::array> out,
+         bool inplace, bool doublePrecision) {
+        return process(inputArray, sampleRate, plugins, bufferSize, reset, out,
+                       inplace, nullptr, doublePrecision);
       },
       R"(
 Run a 32-bit or 64-bit floating point audio buffer through a
 list of Pedalboard plugins. If the provided buffer uses a 64-bit datatype,
-it will be converted to 32-bit for processing.
+it will be converted to 32-bit for processing, unless ``double_precision``
+is ``True``. In that case, all of the provided plugins must support 64-bit
+processing, and a 64-bit buffer will always be returned.
 
 The provided ``buffer_size`` argument will be used to control the size of
 each chunk of audio provided into the plugins. Higher buffer sizes may speed up
@@ -106,10 +114,58 @@ processing begins, clearing any state from previous calls to ``process``.
 If calling ``process`` multiple times while processing the same audio file
 or buffer, set ``reset`` to ``False``.
 
+If ``out`` is provided, the output will be written into it (and a view of it
+returned) instead of allocating a new array. If ``inplace`` is ``True``, the
+input buffer will be overwritten with the output. Either way, the array
+written to must be 64-bit if and only if ``double_precision`` is ``True``.
+
 :meta private:
 )",
       py::arg("input_array"), py::arg("sample_rate"), py::arg("plugins"),
-      py::arg("buffer_size") = DEFAULT_BUFFER_SIZE, py::arg("reset") = true);
+      py::arg("buffer_size") = DEFAULT_BUFFER_SIZE, py::arg("reset") = true,
+      py::arg("out") = py::none(), py::arg("inplace") = false,
+      py::arg("double_precision") = false);
+
+  m.def(
+      "process_batch",
+      [](py::object inputArrays, double sampleRate,
+         const std::vector<std::shared_ptr<Plugin>> plugins,
+         unsigned int bufferSize, int numThreads) {
+        return processBatch(inputArrays, sampleRate, plugins, bufferSize,
+                            numThreads);
+      },
+      R"(
+Run many independent 32-bit or 64-bit floating point audio buffers through
+a list of Pedalboard plugins, using multiple threads.
+
+Each buffer is processed as if ``process`` had been called on it with
+``reset`` set to ``True``. ``input_arrays`` may be either a list of arrays
+(which may differ in length) or a three-dimensional array, in which case the
+output will also be a three-dimensional array.
+
+:meta private:
+)",
+      py::arg("input_arrays"), py::arg("sample_rate"), py::arg("plugins"),
+      py::arg("buffer_size") = DEFAULT_BUFFER_SIZE,
+      py::arg("num_threads") = 0);
+
+  auto processPlugin = [](std::shared_ptr<Plugin> self,
+                          const py::array inputArray, double sampleRate,
+                          unsigned int bufferSize, bool reset,
+                          std::optional<py::array> out, bool inplace,
+                          bool profile, bool doublePrecision) {
+    std::shared_ptr<Profiler> profiler =
+        profile ? std::make_shared<Profiler>(sampleRate) : nullptr;
+
+    py::array output = process(inputArray, sampleRate, {self}, bufferSize,
+                               reset, out, inplace, profiler, doublePrecision);
+
+    if (profiler) {
+      profiler->resolveNames();
+      std::atomic_store(&self->lastProfile, profiler);
+    }
+    return output;
+  };
 
   plugin
       .def(py::init([]() {
@@ -133,12 +189,44 @@ or buffer, set ``reset`` to ``False``.
           "tails, delay lines, LFO state, etc). The values of plugin "
           "parameters will remain unchanged. ")
       .def(
-          "process",
-          [](std::shared_ptr<Plugin> self, const py::array inputArray,
-             double sampleRate, unsigned int bufferSize, bool reset) {
-            return process(inputArray, sampleRate, {self}, bufferSize, reset);
+          "clone",
+          [](std::shared_ptr<Plugin> self) {
+            std::shared_ptr<Plugin> clone;
+            {
+              py::gil_scoped_release release;
+              std::lock_guard<std::mutex> lock(self->mutex);
+              clone = self->clone();
+            }
+
+            if (!clone) {
+              throw std::runtime_error(
+                  py::repr(py::cast(self)).cast<std::string>() +
+                  " cannot be cloned.");
+            }
+            return clone;
           },
           R"(
+Create a new, independent copy of this plugin (and of any plugins it
+contains) with the same parameter values, but without any of this plugin's
+internal state (e.g.: reverb tails, delay lines, etc). The copy can be used
+to process audio on another thread at the same time as this plugin.
+
+Cloning is much cheaper than constructing a new plugin from scratch, as
+any large, immutable data loaded by this plugin is shared with the copy
+rather than being loaded again. For example, a cloned :class:`Convolution`
+shares its impulse response with the original, and a cloned VST3 or Audio
+Unit plugin is not scanned or tested again.
+
+VST3 and Audio Unit plugins can only be cloned from the main thread, and
+only if they clear their internal state when reset (as most plugins do). A
+``RuntimeError`` will be raised if this plugin cannot be cloned.
+
+*Introduced in v0.9.22.*
+)")
+      .def(
+          "process",
+          processPlugin,
+          R"(
 Run a 32-bit or 64-bit floating point audio buffer through this plugin.
 (If calling this multiple times with multiple plugins, consider creating a
 :class:`pedalboard.Pedalboard` object instead.)
@@ -150,7 +238,14 @@ audio, pass another audio buffer into ``process`` with ``reset`` set to
 ``True``.
 
 If the provided buffer uses a 64-bit datatype, it will be converted to 32-bit
-for processing.
+for processing, and a 32-bit buffer will be returned. To process audio at
+64-bit precision instead, pass ``double_precision=True``; a 64-bit buffer
+will then always be returned (converting 32-bit input if necessary), and a
+``ValueError`` will be raised if this plugin does not support 64-bit
+processing (see :py:attr:`supports_double_precision`). Plugins keep separate
+internal state for 32-bit and 64-bit processing, so when calling ``process``
+repeatedly with ``reset=False``, pass the same ``double_precision`` value
+each time to avoid losing tails. (*Introduced in v0.9.22.*)
 
 The provided ``buffer_size`` argument will be used to control the size of
 each chunk of audio provided to the plugin. Higher buffer sizes may speed up
@@ -167,23 +262,95 @@ If the number of samples and the number of channels are the same, each
 :py:class:`Plugin` object will use the last-detected channel layout until
 :py:meth:`reset` is explicitly called (as of v0.9.9).
 
+To avoid allocating a new output array, pass a C-contiguous floating point
+array with the same shape as ``input_array`` as ``out``, or pass
+``inplace=True`` to overwrite ``input_array`` itself. (This array must be
+64-bit if ``double_precision`` is ``True``, and 32-bit otherwise.) The
+returned array will then be a view of that array. If ``input_array`` is
+shaped ``(num_channels, num_samples)`` (or is one-dimensional) and the plugins
+add no latency, audio will be processed directly in that array's memory
+without any intermediate copies. If fewer samples are returned than were
+provided, only the first samples of the output array will be
+overwritten. (*Introduced in v0.9.22.*)
+
+If ``profile`` is ``True``, the time spent processing audio in this plugin
+(and in each plugin it contains) will be recorded and made available via
+:py:attr:`last_profile`. (*Introduced in v0.9.22.*)
+
 .. note::
     The :py:meth:`process` method can also be used via :py:meth:`__call__`;
     i.e.: just calling this object like a function (``my_plugin(...)``) will
     automatically invoke :py:meth:`process` with the same arguments.
 )",
           py::arg("input_array"), py::arg("sample_rate"),
-          py::arg("buffer_size") = DEFAULT_BUFFER_SIZE, py::arg("reset") = true)
+          py::arg("buffer_size") = DEFAULT_BUFFER_SIZE, py::arg("reset") = true,
+          py::arg("out") = py::none(), py::arg("inplace") = false,
+          py::arg("profile") = false, py::arg("double_precision") = false)
       .def(
           "__call__",
-          [](std::shared_ptr<Plugin> self, const py::array inputArray,
-             double sampleRate, unsigned int bufferSize, bool reset) {
-            return process(inputArray, sampleRate, {self}, bufferSize, reset);
-          },
+          processPlugin,
           "Run an audio buffer through this plugin. Alias for "
           ":py:meth:`process`.",
           py::arg("input_array"), py::arg("sample_rate"),
-          py::arg("buffer_size") = DEFAULT_BUFFER_SIZE, py::arg("reset") = true)
+          py::arg("buffer_size") = DEFAULT_BUFFER_SIZE, py::arg("reset") = true,
+          py::arg("out") = py::none(), py::arg("inplace") = false,
+          py::arg("profile") = false, py::arg("double_precision") = false)
+      .def(
+          "process_batch",
+          [](std::shared_ptr<Plugin> self, py::object inputArrays,
+             double sampleRate, unsigned int bufferSize, int numThreads) {
+            return processBatch(inputArrays, sampleRate, {self}, bufferSize,
+                                numThreads);
+          },
+          R"(
+Run many independent audio buffers through this plugin, spreading the work
+across multiple threads without holding the Global Interpreter Lock.
+
+``input_arrays`` may be a list of audio buffers (which may each have a
+different length and number of channels) or a single three-dimensional array
+of shape ``(batch_size, num_channels, num_samples)`` or
+``(batch_size, num_samples, num_channels)``. A list of arrays will be
+returned in the former case, and a single three-dimensional array in the
+latter.
+
+Each buffer is processed independently, as if it were passed to
+:py:meth:`process` with ``reset`` set to ``True``; no state is carried over
+from one buffer to the next. To allow buffers to be rendered at the same
+time, each thread uses its own copy of this plugin (and of any plugins it
+contains), created with :py:meth:`clone`. If any of those plugins cannot be
+cloned, all buffers will be processed on a single thread.
+
+``num_threads`` controls the maximum number of threads used; if set to 0
+(the default), one thread per CPU core will be used.
+
+*Introduced in v0.9.22.*
+)",
+          py::arg("input_arrays"), py::arg("sample_rate"),
+          py::arg("buffer_size") = DEFAULT_BUFFER_SIZE,
+          py::arg("num_threads") = 0)
+      .def_property_readonly(
+          "last_profile",
+          [](std::shared_ptr<Plugin> self) {
+            return std::atomic_load(&self->lastProfile);
+          },
+          "A :class:`pedalboard.Profile` object containing timing "
+          "information recorded during the most recent call to "
+          ":py:meth:`process` with ``profile=True``, or ``None`` if this "
+          "plugin has never been profiled.\n\n*Introduced in v0.9.22.*")
+      .def_property_readonly(
+          "supports_double_precision",
+          [](std::shared_ptr<Plugin> self) {
+            return self->supportsDoublePrecision();
+          },
+          "True iff this plugin can process 64-bit floating point audio "
+          "without first converting it to 32-bit, when passed "
+          "``double_precision=True``. This is true for "
+          ":class:`Clipping`, :class:`Compressor`, :class:`Delay`, "
+          ":class:`Gain`, :class:`HighpassFilter`, :class:`HighShelfFilter`, "
+          ":class:`LowpassFilter`, :class:`LowShelfFilter`, "
+          ":class:`PeakFilter`, and any :class:`Chain` or "
+          ":class:`Pedalboard` that only contains those plugins.\n\n"
+          "*Introduced in v0.9.22.*")
       .def_property_readonly(
           "is_effect",
           [](std::shared_ptr<Plugin> self) {
@@ -231,6 +398,7 @@ If the number of samples and the number of channels are the same, each
 
   // Classes that don't perform any audio effects, but that add other utilities:
   py::module utils = m.def_submodule("utils");
+  init_profiler(utils);
   init_mix(utils);
   init_chain(utils);
   init_time_stretch(utils);
@@ -242,6 +410,19 @@ If the number of samples and the number of channels are the same, each
   init_resample_with_latency(internal);
   init_fixed_size_block_test_plugin(internal);
   init_force_mono_test_plugin(internal);
+  internal.def("get_allocation_count", &AllocationCounter::getCount,
+               "Return the number of heap allocations that Pedalboard has "
+               "made while processing audio. Used to test that steady-state "
+               "processing is allocation-free. Always returns 0 unless "
+               "allocations_are_counted() is True.");
+  internal.def("allocations_are_counted", &AllocationCounter::isEnabled,
+               "Return True if this build of Pedalboard counts heap "
+               "allocations (i.e.: was built with COUNT_ALLOCATIONS=1).");
+  internal.def("get_convolution_spectrum_cache_size",
+               &juce::dsp::BlockingConvolution::getSpectrumCacheSize,
+               "Return the number of distinct impulse response spectra "
+               "currently shared between all Convolution plugins. Used to "
+               "test that Convolution plugins reuse each other's spectra.");
 
   // I/O helpers and utilities:
   py::module io = m.def_submodule("io");
@@ -260,4 +441,6 @@ If the number of samples and the number of channels are the same, each
 
   init_stream_resampler(io);
   init_audio_stream(io);
+  init_load_many(io);
+  init_probe(io);
 };
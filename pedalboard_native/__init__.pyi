@@ -67,6 +67,7 @@ __all__ = [
     "VST3Plugin",
     "io",
     "process",
+    "process_batch",
     "utils",
 ]
 
@@ -81,6 +82,10 @@ class Plugin:
         sample_rate: float,
         buffer_size: int = 8192,
         reset: bool = True,
+        out: typing.Optional[NDArray[float32]] = None,
+        inplace: bool = False,
+        profile: bool = False,
+        double_precision: bool = False,
     ) -> NDArray[float32]:
         """
         Run an audio buffer through this plugin. Alias for :py:meth:`process`.
@@ -92,6 +97,10 @@ class Plugin:
         sample_rate: float,
         buffer_size: int = 8192,
         reset: bool = True,
+        out: typing.Optional[NDArray[float32]] = None,
+        inplace: bool = False,
+        profile: bool = False,
+        double_precision: bool = False,
     ) -> NDArray[float32]:
         """
         Run a 32-bit or 64-bit floating point audio buffer through this plugin.
@@ -105,7 +114,14 @@ class Plugin:
         ``True``.
 
         If the provided buffer uses a 64-bit datatype, it will be converted to 32-bit
-        for processing.
+        for processing, and a 32-bit buffer will be returned. To process audio at
+        64-bit precision instead, pass ``double_precision=True``; a 64-bit buffer
+        will then always be returned (converting 32-bit input if necessary), and a
+        ``ValueError`` will be raised if this plugin does not support 64-bit
+        processing (see :py:attr:`supports_double_precision`). Plugins keep separate
+        internal state for 32-bit and 64-bit processing, so when calling ``process``
+        repeatedly with ``reset=False``, pass the same ``double_precision`` value
+        each time to avoid losing tails. (*Introduced in v0.9.22.*)
 
         The provided ``buffer_size`` argument will be used to control the size of
         each chunk of audio provided to the plugin. Higher buffer sizes may speed up
@@ -122,17 +138,112 @@ class Plugin:
         :py:class:`Plugin` object will use the last-detected channel layout until
         :py:meth:`reset` is explicitly called (as of v0.9.9).
 
+        To avoid allocating a new output array, pass a C-contiguous floating point
+        array with the same shape as ``input_array`` as ``out``, or pass
+        ``inplace=True`` to overwrite ``input_array`` itself. (This array must be
+        64-bit if ``double_precision`` is ``True``, and 32-bit otherwise.) The
+        returned array will then be a view of that array. If ``input_array`` is
+        shaped ``(num_channels, num_samples)`` (or is one-dimensional) and the plugins
+        add no latency, audio will be processed directly in that array's memory
+        without any intermediate copies. If fewer samples are returned than were
+        provided, only the first samples of the output array will be
+        overwritten. (*Introduced in v0.9.22.*)
+
+        If ``profile`` is ``True``, the time spent processing audio in this plugin
+        (and in each plugin it contains) will be recorded and made available via
+        :py:attr:`last_profile`. (*Introduced in v0.9.22.*)
+
         .. note::
             The :py:meth:`process` method can also be used via :py:meth:`__call__`;
             i.e.: just calling this object like a function (``my_plugin(...)``) will
             automatically invoke :py:meth:`process` with the same arguments.
         """
 
+    @typing.overload
+    def process_batch(
+        self,
+        input_arrays: typing.List[NDArray[float32]],
+        sample_rate: float,
+        buffer_size: int = 8192,
+        num_threads: int = 0,
+    ) -> typing.List[NDArray[float32]]: ...
+    @typing.overload
+    def process_batch(
+        self,
+        input_arrays: NDArray[float32],
+        sample_rate: float,
+        buffer_size: int = 8192,
+        num_threads: int = 0,
+    ) -> NDArray[float32]:
+        """
+        Run many independent audio buffers through this plugin, spreading the work
+        across multiple threads without holding the Global Interpreter Lock.
+
+        ``input_arrays`` may be a list of audio buffers (which may each have a
+        different length and number of channels) or a single three-dimensional array
+        of shape ``(batch_size, num_channels, num_samples)`` or
+        ``(batch_size, num_samples, num_channels)``. A list of arrays will be
+        returned in the former case, and a single three-dimensional array in the
+        latter.
+
+        Each buffer is processed independently, as if it were passed to
+        :py:meth:`process` with ``reset`` set to ``True``; no state is carried over
+        from one buffer to the next. To allow buffers to be rendered at the same
+        time, each thread uses its own copy of this plugin (and of any plugins it
+        contains), created with :py:meth:`clone`. If any of those plugins cannot be
+        cloned, all buffers will be processed on a single thread.
+
+        ``num_threads`` controls the maximum number of threads used; if set to 0
+        (the default), one thread per CPU core will be used.
+
+        *Introduced in v0.9.22.*
+        """
+
     def reset(self) -> None:
         """
         Clear any internal state stored by this plugin (e.g.: reverb tails, delay lines, LFO state, etc). The values of plugin parameters will remain unchanged.
         """
 
+    def clone(self) -> Plugin:
+        """
+        Create a new, independent copy of this plugin (and of any plugins it
+        contains) with the same parameter values, but without any of this plugin's
+        internal state (e.g.: reverb tails, delay lines, etc). The copy can be used
+        to process audio on another thread at the same time as this plugin.
+
+        Cloning is much cheaper than constructing a new plugin from scratch, as
+        any large, immutable data loaded by this plugin is shared with the copy
+        rather than being loaded again. For example, a cloned :class:`Convolution`
+        shares its impulse response with the original, and a cloned VST3 or Audio
+        Unit plugin is not scanned or tested again.
+
+        VST3 and Audio Unit plugins can only be cloned from the main thread, and
+        only if they clear their internal state when reset (as most plugins do). A
+        ``RuntimeError`` will be raised if this plugin cannot be cloned.
+
+        *Introduced in v0.9.22.*
+        """
+
+    @property
+    def last_profile(self) -> typing.Optional[pedalboard_native.utils.Profile]:
+        """
+        A :class:`pedalboard.Profile` object containing timing information recorded during the most recent call to :py:meth:`process` with ``profile=True``, or ``None`` if this plugin has never been profiled.
+
+        *Introduced in v0.9.22.*
+
+
+        """
+
+    @property
+    def supports_double_precision(self) -> bool:
+        """
+        True iff this plugin can process 64-bit floating point audio without first converting it to 32-bit, when passed ``double_precision=True``. This is true for :class:`Clipping`, :class:`Compressor`, :class:`Delay`, :class:`Gain`, :class:`HighpassFilter`, :class:`HighShelfFilter`, :class:`LowpassFilter`, :class:`LowShelfFilter`, :class:`PeakFilter`, and any :class:`Chain` or :class:`Pedalboard` that only contains those plugins.
+
+        *Introduced in v0.9.22.*
+
+
+        """
+
     @property
     def is_effect(self) -> bool:
         """
@@ -313,6 +424,8 @@ class Convolution(Plugin):
 
     The convolution impulse response can be specified either by filename or as a 32-bit floating point NumPy array. If a NumPy array is provided, the ``sample_rate`` argument must also be provided to indicate the sample rate of the impulse response.
 
+    Convolution plugins that use the same impulse response at the same sample rate and buffer size share a single, read-only copy of its frequency-domain representation, which is only computed once. (*Introduced in v0.9.22.*)
+
     *Support for passing NumPy arrays as impulse responses introduced in v0.9.10.*
     """
 
@@ -1575,6 +1688,14 @@ class Resample(Plugin):
 
         To provide a good balance between speed and accuracy, :py:class:`WindowedSinc32` is the
         default from Pedalboard v0.9.15 onwards. (Previously, :py:class:`WindowedSinc` was the default.)
+
+        When resampling between two integer sample rates where
+        ``target_sample_rate / gcd(source_sample_rate, target_sample_rate)`` is at most 1024
+        (i.e.: the ratio of the target to the source sample rate reduces to a fraction with a
+        numerator of at most 1024, such as 48kHz to 44.1kHz, 44.1kHz to 16kHz, or any integer
+        downsampling factor), the numbered :py:class:`WindowedSinc` algorithms precompute their filter
+        coefficients once rather than for every output sample, which is significantly faster
+        and produces output of the same quality. *(Introduced in v0.9.22.)*
         """
 
         ZeroOrderHold = 0  # fmt: skip
@@ -2333,11 +2454,16 @@ def process(
     plugins: typing.List[Plugin],
     buffer_size: int = 8192,
     reset: bool = True,
+    out: typing.Optional[NDArray[float32]] = None,
+    inplace: bool = False,
+    double_precision: bool = False,
 ) -> NDArray[float32]:
     """
     Run a 32-bit or 64-bit floating point audio buffer through a
     list of Pedalboard plugins. If the provided buffer uses a 64-bit datatype,
-    it will be converted to 32-bit for processing.
+    it will be converted to 32-bit for processing, unless ``double_precision``
+    is ``True``. In that case, all of the provided plugins must support 64-bit
+    processing, and a 64-bit buffer will always be returned.
 
     The provided ``buffer_size`` argument will be used to control the size of
     each chunk of audio provided into the plugins. Higher buffer sizes may speed up
@@ -2348,6 +2474,39 @@ def process(
     If calling ``process`` multiple times while processing the same audio file
     or buffer, set ``reset`` to ``False``.
 
+    If ``out`` is provided, the output will be written into it (and a view of it
+    returned) instead of allocating a new array. If ``inplace`` is ``True``, the
+    input buffer will be overwritten with the output. Either way, the array
+    written to must be 64-bit if and only if ``double_precision`` is ``True``.
+
+    :meta private:
+    """
+
+@typing.overload
+def process_batch(
+    input_arrays: typing.List[ndarray],
+    sample_rate: float,
+    plugins: typing.List[Plugin],
+    buffer_size: int = 8192,
+    num_threads: int = 0,
+) -> typing.List[NDArray[float32]]: ...
+@typing.overload
+def process_batch(
+    input_arrays: ndarray,
+    sample_rate: float,
+    plugins: typing.List[Plugin],
+    buffer_size: int = 8192,
+    num_threads: int = 0,
+) -> NDArray[float32]:
+    """
+    Run many independent 32-bit or 64-bit floating point audio buffers through
+    a list of Pedalboard plugins, using multiple threads.
+
+    Each buffer is processed as if ``process`` had been called on it with
+    ``reset`` set to ``True``. ``input_arrays`` may be either a list of arrays
+    (which may differ in length) or a three-dimensional array, in which case the
+    output will also be a three-dimensional array.
+
     :meta private:
     """
 
@@ -33,6 +33,9 @@ __all__ = [
     "ForceMonoTestPlugin",
     "PrimeWithSilenceTestPlugin",
     "ResampleWithLatency",
+    "allocations_are_counted",
+    "get_allocation_count",
+    "get_convolution_spectrum_cache_size",
 ]
 
 class AddLatency(pedalboard_native.Plugin):
@@ -81,3 +84,18 @@ class ResampleWithLatency(pedalboard_native.Plugin):
     def target_sample_rate(self, arg1: float) -> None:
         pass
     pass
+
+def allocations_are_counted() -> bool:
+    """
+    Return True if this build of Pedalboard counts heap allocations (i.e.: was built with COUNT_ALLOCATIONS=1).
+    """
+
+def get_allocation_count() -> int:
+    """
+    Return the number of heap allocations that Pedalboard has made while processing audio. Used to test that steady-state processing is allocation-free. Always returns 0 unless allocations_are_counted() is True.
+    """
+
+def get_convolution_spectrum_cache_size() -> int:
+    """
+    Return the number of distinct impulse response spectra currently shared between all Convolution plugins. Used to test that Convolution plugins reuse each other's spectra.
+    """
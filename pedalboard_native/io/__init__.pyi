@@ -24,6 +24,8 @@ __all__ = [
     "WriteableAudioFile",
     "get_supported_read_formats",
     "get_supported_write_formats",
+    "load_many",
+    "probe",
 ]
 
 class AudioFile:
@@ -114,6 +116,26 @@ class AudioFile:
                    o.write(i.read(1024))
 
 
+    Decoding the next few chunks of a file on a background thread while
+    processing the current one::
+
+       with AudioFile("input.mp3", prefetch=4) as i:
+           with AudioFile("output.mp3", "w", i.samplerate, i.num_channels) as o:
+               while i.tell() < i.frames:
+                   o.write(board(i.read(i.samplerate), i.samplerate, reset=False))
+
+
+    Encoding previously-processed chunks on a background thread while
+    processing the next one::
+
+       with AudioFile("input.wav") as i:
+           with AudioFile(
+               "output.mp3", "w", i.samplerate, i.num_channels, queue_size=4
+           ) as o:
+               while i.tell() < i.frames:
+                   o.write(board(i.read(i.samplerate), i.samplerate, reset=False))
+
+
     .. note::
         Calling the :class:`AudioFile` constructor does not actually return an
         :class:`AudioFile`. If opening an audio file in read ("r") mode, a
@@ -124,20 +146,25 @@ class AudioFile:
 
     @classmethod
     @typing.overload
-    def __new__(cls, filename: str) -> ReadableAudioFile:
+    def __new__(cls, filename: str, *, prefetch: int = 0) -> ReadableAudioFile:
         """Open an audio file for reading (mode 'r' is implied)."""
         ...
 
     @classmethod
     @typing.overload
-    def __new__(cls, filename: str, mode: Literal["r"]) -> ReadableAudioFile:
+    def __new__(
+        cls, filename: str, mode: Literal["r"], prefetch: int = 0
+    ) -> ReadableAudioFile:
         """Open an audio file for reading with an explicit mode 'r'."""
         ...
 
     @classmethod
     @typing.overload
     def __new__(
-        cls, file_like: typing.Union[typing.BinaryIO, memoryview], mode: Literal["r"] = "r"
+        cls,
+        file_like: typing.Union[typing.BinaryIO, memoryview],
+        mode: Literal["r"] = "r",
+        buffer_size: int = 0,
     ) -> ReadableAudioFile: ...
 
     @classmethod
@@ -150,6 +177,7 @@ class AudioFile:
         num_channels: int = 1,
         bit_depth: int = 16,
         quality: typing.Optional[typing.Union[str, float]] = None,
+        queue_size: int = 0,
     ) -> WriteableAudioFile: ...
 
     @classmethod
@@ -461,30 +489,96 @@ class ReadableAudioFile(AudioFile):
         """
 
     @typing.overload
-    def __init__(self, filename: str) -> None: ...
+    def __init__(self, filename: str, prefetch: int = 0) -> None: ...
     @typing.overload
-    def __init__(self, file_like: typing.Union[typing.BinaryIO, memoryview]) -> None: ...
+    def __init__(
+        self, file_like: typing.Union[typing.BinaryIO, memoryview], buffer_size: int = 0
+    ) -> None: ...
 
     # These don't exist, but Pyright assumes they do:
     @typing.overload
-    def __init__(self, filename: str, mode: Literal["r"]) -> None: ...
+    def __init__(self, filename: str, mode: Literal["r"], prefetch: int = 0) -> None: ...
     @typing.overload
-    def __init__(self, file_like: typing.Union[typing.BinaryIO, memoryview], mode: Literal["r"]) -> None: ...
+    def __init__(
+        self,
+        file_like: typing.Union[typing.BinaryIO, memoryview],
+        mode: Literal["r"],
+        buffer_size: int = 0,
+    ) -> None: ...
 
     @classmethod
     @typing.overload
-    def __new__(cls, filename: str) -> ReadableAudioFile: ...
+    def __new__(cls, filename: str, prefetch: int = 0) -> ReadableAudioFile: ...
     @classmethod
     @typing.overload
-    def __new__(cls, file_like: typing.Union[typing.BinaryIO, memoryview]) -> ReadableAudioFile: ...
+    def __new__(
+        cls, file_like: typing.Union[typing.BinaryIO, memoryview], buffer_size: int = 0
+    ) -> ReadableAudioFile: ...
     def __repr__(self) -> str: ...
+    def build_frame_index(self) -> bytes:
+        """
+        Scan this file once from start to finish to find the position of every frame
+        of compressed audio, returning a serialized copy of the resulting index as
+        :class:`bytes`.
+
+        Once an index has been built (or loaded with :meth:`load_frame_index`),
+        :py:attr:`frames` is exact, :py:attr:`exact_duration_known` is
+        :py:const:`True`, and :meth:`seek` can jump straight to any position without
+        first scanning through the file. This is useful when reading many short
+        excerpts from random positions in long MP3 files.
+
+        Scanning a file only parses frame headers and does not decode any audio, so
+        it's much faster than reading the file. The returned index can be stored
+        (e.g.: in a sidecar file) and passed to :meth:`load_frame_index` when the
+        same file is opened again to avoid scanning it a second time::
+
+           from pathlib import Path
+
+           index_path = Path("podcast.mp3.index")
+           with AudioFile("podcast.mp3") as f:
+              if index_path.exists():
+                 f.load_frame_index(index_path.read_bytes())
+              else:
+                 index_path.write_bytes(f.build_frame_index())
+
+              f.seek(f.frames // 2)
+              excerpt = f.read(f.samplerate * 10)
+
+        Calling this method again on a file that is already indexed does not scan the
+        file again. The read position of the file is not changed.
+
+        .. note::
+            Frame indices are only supported for MP3 files, as every other
+            supported format already provides exact lengths and fast seeking.
+            Calling this method on a file in another format raises a
+            :class:`ValueError`.
+
+        *Introduced in v0.9.22.*
+        """
     def close(self) -> None:
         """
         Close this file, rendering this object unusable.
         """
 
+    def load_frame_index(self, index: bytes) -> None:
+        """
+        Load a frame index previously returned by :meth:`build_frame_index`
+        for this file, giving this file an exact length and fast seeking without
+        scanning the file. See :meth:`build_frame_index` for more details.
+
+        A :class:`ValueError` is raised if the provided index is corrupt or was built
+        from a different file. (Indices are validated against the file's size and the
+        position of its first frame, so an index built from a different version of the
+        same file may not always be detected.)
+
+        *Introduced in v0.9.22.*
+        """
     def read(
-        self, num_frames: typing.Union[float, int] = 0
+        self,
+        num_frames: typing.Union[float, int] = 0,
+        num_threads: int = 1,
+        channels: typing.Optional[typing.List[int]] = None,
+        downmix: typing.Optional[Literal["mono"]] = None,
     ) -> NDArray[float32]:
         """
         Read the given number of frames (samples in each channel) from this audio file at its current position.
@@ -507,10 +601,61 @@ class ReadableAudioFile(AudioFile):
         For most (but not all) audio files, the minimum possible sample value will be ``-1.0f`` and the
         maximum sample value will be ``+1.0f``.
 
+        If ``num_threads`` is greater than 1, large reads from WAV, AIFF, and FLAC files on disk will be
+        split into up to ``num_threads`` contiguous ranges, each of which will be decoded on its own
+        thread by its own reader. The returned audio is identical to that returned when
+        ``num_threads`` is 1. Reads from other formats, from file-like objects, or of fewer than 65,536
+        frames per thread are decoded on the calling thread as usual::
+
+            with AudioFile("three_hour_recording.flac") as f:
+                audio = f.read(f.frames, num_threads=8)
+
+        To read only some of this file's channels, pass a list of channel indices as ``channels``;
+        the returned array will contain one row per requested channel, in the order requested.
+        Channels that are not requested are not copied or converted. To mix all of the channels
+        (or just those in ``channels``) down to a single channel by averaging them, pass
+        ``downmix="mono"``; the returned array will have shape ``(1, <length>)``::
+
+            with AudioFile("surround.wav") as f:
+                front = f.read(f.frames, channels=[0, 1])
+                f.seek(0)
+                mono = f.read(f.frames, downmix="mono")
+
         .. note::
             For convenience, the ``num_frames`` argument may be a floating-point number. However, if the
             provided number of frames contains a fractional part (i.e.: ``1.01`` instead of ``1.00``) then
             an exception will be thrown, as a fractional number of samples cannot be returned.
+
+        *The num_threads, channels, and downmix arguments were introduced in v0.9.22.*
+        """
+
+    def read_into(
+        self,
+        out: NDArray[typing.Union[np.int8, np.int16, np.int32, np.float32]],
+        offset: int = 0,
+        num_threads: int = 1,
+    ) -> int:
+        """
+        Read audio from this file at its current position directly into ``out``, an
+        existing C-contiguous :class:`numpy.array` of shape ``(num_channels, frames)``,
+        and return the number of frames read.
+
+        Audio is written into ``out[:, offset:]``, reading as many frames as fit (or
+        as remain in the file). Any frames past the end of the file are set to zero.
+        Unlike :meth:`read`, no new array is allocated, which makes :meth:`read_into`
+        well suited to filling preallocated (i.e.: ring or pinned) buffers in a loop::
+
+           buffer = np.zeros((f.num_channels, 16000), dtype=np.float32)
+           while f.tell() < f.frames:
+              frames_read = f.read_into(buffer)
+              process(buffer[:, :frames_read])
+
+        If ``out`` is a ``float32`` array, it will be filled with the same data returned
+        by :meth:`read`. If ``out`` is an integer array (``int8``, ``int16``, or
+        ``int32``) wide enough to hold this file's samples, it will be filled with the
+        raw data returned by :meth:`read_raw`.
+
+        *Introduced in v0.9.22.*
         """
 
     def read_raw(
@@ -541,6 +686,33 @@ class ReadableAudioFile(AudioFile):
             an exception will be thrown, as a fractional number of samples cannot be returned.
         """
 
+    def read_windows(
+        self, offsets: typing.Sequence[int], length: int
+    ) -> NDArray[np.float32]:
+        """
+        Read many windows of ``length`` frames from this file at once, each starting
+        at one of the provided ``offsets`` (in frames), and return them as a single
+        32-bit floating-point :class:`numpy.array` of shape
+        ``(len(offsets), num_channels, length)``.
+
+        This produces the same audio as calling :meth:`seek` and :meth:`read` for each
+        offset in turn, but does so in one native call without holding the GIL.
+        Windows are decoded in order of their offsets to avoid seeking backwards, and
+        audio shared by overlapping windows is only decoded once. This makes
+        :meth:`read_windows` well suited to sampling random crops from a file::
+
+           with AudioFile("podcast.mp3") as f:
+              offsets = np.random.randint(0, f.frames - 16000, size=32)
+              crops = f.read_windows(offsets, 16000)
+              assert crops.shape == (32, f.num_channels, 16000)
+
+        Windows that extend past the end of the file are padded with zeros. Offsets
+        must be between ``0`` and :py:attr:`frames` (inclusive). The read position of
+        this file (as returned by :meth:`tell`) is not changed.
+
+        *Introduced in v0.9.22.*
+        """
+
     def resampled_to(
         self,
         target_sample_rate: float,
@@ -686,6 +858,23 @@ class ReadableAudioFile(AudioFile):
         The number of channels in this file.
 
 
+        """
+
+    @property
+    def prefetch(self) -> int:
+        """
+        The maximum number of chunks of audio that will be decoded ahead of the
+        current position on a background thread, or ``0`` if audio is only decoded
+        when :meth:`read` is called.
+
+        Each chunk is as long as the :meth:`read` call that started prefetching, or
+        8,192 frames, whichever is longer. Prefetching starts on the first call to
+        :meth:`read`, and restarts on the next call to :meth:`read` after each call to
+        :meth:`seek`.
+
+        *Introduced in v0.9.22.*
+
+
         """
 
     @property
@@ -788,6 +977,43 @@ class ResampledReadableAudioFile(AudioFile):
             an exception will be thrown, as a fractional number of samples cannot be returned.
         """
 
+    def read_into(self, out: NDArray[np.float32], offset: int = 0) -> int:
+        """
+        Read audio (at the target sample rate) from this file at its current position
+        directly into ``out``, an existing C-contiguous ``float32``
+        :class:`numpy.array` of shape ``(num_channels, frames)``, and return the
+        number of frames read.
+
+        Audio is written into ``out[:, offset:]``, reading as many frames as fit (or
+        as remain in the file). Any frames past the end of the file are set to zero.
+        Unlike :meth:`read`, no new array is returned, which makes :meth:`read_into`
+        well suited to filling preallocated buffers in a loop.
+
+        *Introduced in v0.9.22.*
+        """
+
+    def read_windows(
+        self, offsets: typing.Sequence[int], length: int
+    ) -> NDArray[np.float32]:
+        """
+        Read many windows of ``length`` frames (at the target sample rate) from this
+        file at once, each starting at one of the provided ``offsets``, and return
+        them as a single 32-bit floating-point :class:`numpy.array` of shape
+        ``(len(offsets), num_channels, length)``.
+
+        This is equivalent to calling :meth:`seek` and :meth:`read` for each offset in
+        turn, but runs in one native call without holding the GIL. Windows are read
+        in order of their offsets, audio shared by overlapping windows is only
+        resampled once, and short gaps between windows are read through rather than
+        seeked over (as each seek requires resetting the resampler).
+
+        Windows that extend past the end of the file are padded with zeros. Offsets
+        must be between ``0`` and :py:attr:`frames` (inclusive). The read position of
+        this file (as returned by :meth:`tell`) is not changed.
+
+        *Introduced in v0.9.22.*
+        """
+
     def seek(self, position: int) -> None:
         """
         Seek this file to the provided location in frames at the target sample rate. Future reads will start from this position.
@@ -930,10 +1156,16 @@ class StreamResampler:
 
     def __repr__(self) -> str: ...
     def process(
-        self, input: typing.Optional[NDArray[float32]] = None
+        self,
+        input: typing.Optional[NDArray[float32]] = None,
+        out: typing.Optional[NDArray[float32]] = None,
     ) -> NDArray[float32]:
         """
         Resample a 32-bit floating-point audio buffer. The returned buffer may be smaller than the provided buffer depending on the quality method used. Call :meth:`process()` without any arguments to flush the internal buffers and return all remaining audio.
+
+        If ``out`` is provided, the resampled audio will be written into it (and a view of the portion that was written returned) instead of allocating a new array. ``out`` must be a C-contiguous ``float32`` array with the same channel layout as the input and room for at least as many samples as will be returned; if it is too small, an exception is raised and no audio is consumed.
+
+        *The ``out`` argument was introduced in v0.9.22.*
         """
 
     def reset(self) -> None:
@@ -1038,6 +1270,7 @@ class WriteableAudioFile(AudioFile):
         num_channels: int = 1,
         bit_depth: int = 16,
         quality: typing.Optional[typing.Union[str, float]] = None,
+        queue_size: int = 0,
     ) -> None: ...
     @typing.overload
     def __init__(
@@ -1058,6 +1291,7 @@ class WriteableAudioFile(AudioFile):
         num_channels: int = 1,
         bit_depth: int = 16,
         quality: typing.Optional[typing.Union[str, float]] = None,
+        queue_size: int = 0,
     ) -> WriteableAudioFile: ...
     @classmethod
     @typing.overload
@@ -1082,6 +1316,7 @@ class WriteableAudioFile(AudioFile):
         num_channels: int = 1,
         bit_depth: int = 16,
         quality: typing.Optional[typing.Union[str, float]] = None,
+        queue_size: int = 0,
     ) -> None: ...
 
     # This overload does not actually exist; just makes Pyright happy as
@@ -1102,11 +1337,15 @@ class WriteableAudioFile(AudioFile):
     def close(self) -> None:
         """
         Close this file, flushing its contents to disk and rendering this object unusable for further writing.
+
+        If :py:attr:`queue_size` is greater than zero, this method first waits for all queued audio to be encoded, and raises any error that occurred while encoding it (after closing the file).
         """
 
     def flush(self) -> None:
         """
         Attempt to flush this audio file's contents to disk. Not all formats support flushing, so this may throw a RuntimeError. (If this happens, closing the file will reliably force a flush to occur.)
+
+        If :py:attr:`queue_size` is greater than zero, this method first waits for all queued audio to be encoded, and raises any error that occurred while encoding it.
         """
 
     def tell(self) -> int:
@@ -1188,6 +1427,22 @@ class WriteableAudioFile(AudioFile):
 
         """
 
+    @property
+    def queue_size(self) -> int:
+        """
+        The maximum number of chunks of audio that may be waiting to be encoded on a
+        background thread, or ``0`` if audio is encoded during each call to
+        :meth:`write`.
+
+        If greater than zero, :meth:`write` copies the provided audio into a queue and
+        returns immediately (unless the queue is full), allowing the caller to
+        prepare the next chunk of audio while the previous one is being encoded.
+        Errors that occur while encoding are raised by the next call to
+        :meth:`write`, :meth:`flush`, or :meth:`close`.
+
+        *Introduced in v0.9.22.*
+        """
+
     @property
     def samplerate(self) -> typing.Union[float, int]:
         """
@@ -1202,3 +1457,80 @@ def get_supported_read_formats() -> typing.List[str]:
 
 def get_supported_write_formats() -> typing.List[str]:
     pass
+
+def load_many(
+    paths: typing.List[str],
+    sample_rate: float,
+    num_channels: int,
+    duration: typing.Optional[float] = None,
+    num_threads: int = 0,
+    quality: pedalboard_native.Resample.Quality = pedalboard_native.Resample.Quality.WindowedSinc32,
+) -> typing.Tuple[NDArray[float32], NDArray[np.int64], typing.List[typing.Optional[str]]]:
+    """
+    Load many audio files at once, decoding, resampling, and stacking them on a
+    pool of native threads without holding the GIL.
+
+    Returns a tuple of ``(audio, lengths, errors)``:
+
+     - ``audio`` is a ``float32`` :class:`numpy.array` of shape
+       ``(len(paths), num_channels, num_frames)``, where ``num_frames`` is
+       ``duration * sample_rate`` if ``duration`` is provided, or the length of
+       the longest file otherwise. Files shorter than ``num_frames`` are padded
+       with silence, and files longer than ``duration`` are cropped.
+     - ``lengths`` is an ``int64`` :class:`numpy.array` containing the number of
+       frames of audio (before padding) loaded from each file.
+     - ``errors`` is a list containing ``None`` for each file that was loaded
+       successfully, or an error message for each file that could not be loaded.
+       Files that could not be loaded are left as silence in ``audio`` with a
+       length of ``0``; no exception is raised.
+
+    Each file is resampled to ``sample_rate`` (if necessary) with the given
+    ``quality``, exactly as :meth:`ReadableAudioFile.resampled_to` would.
+    Mono files are copied to every output channel, and files are downmixed to mono
+    (by averaging their channels) if ``num_channels`` is 1; other files with a
+    different number of channels than ``num_channels`` produce an error.
+
+    If ``num_threads`` is 0 (the default), one thread per CPU core will be used::
+
+        audio, lengths, errors = load_many(
+            ["clip_1.wav", "clip_2.mp3", "clip_3.flac"],
+            sample_rate=16000,
+            num_channels=1,
+            duration=2.5,
+        )
+        assert audio.shape == (3, 1, 40000)
+
+    *Introduced in v0.9.22.*
+    """
+
+def probe(
+    paths: typing.List[str], num_threads: int = 0
+) -> typing.Dict[str, typing.Union[NDArray[typing.Any], typing.List[typing.Optional[str]]]]:
+    """
+    Read the sample rate, channel count, and length of many audio files at once
+    from their headers, without decoding any audio, on a pool of native threads
+    without holding the GIL. This is much faster than opening each file with
+    :class:`AudioFile` when indexing large collections of audio files.
+
+    Returns a dictionary of columns, each with one entry per path:
+
+     - ``"samplerate"``: a ``float64`` :class:`numpy.array` of sample rates.
+     - ``"num_channels"``: an ``int64`` :class:`numpy.array` of channel counts.
+     - ``"frames"``: an ``int64`` :class:`numpy.array` of lengths, in frames.
+     - ``"exact_duration_known"``: a ``bool`` :class:`numpy.array` that is
+       :py:const:`False` for files whose length is an estimate based on the
+       file's size and bitrate. (See :py:attr:`ReadableAudioFile.exact_duration_known`.)
+     - ``"format"``: a list of the names of each file's format (i.e.:
+       ``"WAV file"`` or ``"MP3 file"``).
+     - ``"errors"``: a list containing ``None`` for each file that was probed
+       successfully, or an error message for each file that could not be read.
+       Files that could not be read have values of ``0`` (or :py:const:`False` or
+       ``None``) in every other column; no exception is raised.
+
+    If ``num_threads`` is 0 (the default), one thread per CPU core will be used::
+
+        info = probe(["clip_1.wav", "clip_2.mp3", "clip_3.flac"])
+        durations = info["frames"] / info["samplerate"]
+
+    *Introduced in v0.9.22.*
+    """
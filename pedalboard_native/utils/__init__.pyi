@@ -30,28 +30,162 @@ import pedalboard_native
 
 _Shape = typing.Tuple[int, ...]
 
-__all__ = ["Chain", "Mix", "time_stretch"]
+__all__ = ["Chain", "Mix", "Profile", "ProfileEntry", "time_stretch"]
 
 class Chain(pedalboard_native.PluginContainer, pedalboard_native.Plugin):
     """
     Run zero or more plugins as a plugin. Useful when used with the Mix plugin.
+
+    If ``pipelined`` is ``True`` and this object is called directly (i.e.: ``my_chain(audio, sample_rate)``), each of its plugins will be run on its own thread, with blocks of audio passed from one plugin to the next as soon as they have been processed. This can speed up rendering of long audio buffers through many plugins. The output is identical to that produced when ``pipelined`` is ``False``. To run several plugins on the same thread, group them together in another :class:`Chain`. (*Introduced in v0.9.22.*)
     """
 
     @typing.overload
-    def __init__(self, plugins: typing.List[pedalboard_native.Plugin]) -> None: ...
+    def __init__(
+        self, plugins: typing.List[pedalboard_native.Plugin], pipelined: bool = False
+    ) -> None: ...
     @typing.overload
+    def __init__(self) -> None: ...
     def __repr__(self) -> str: ...
+    @property
+    def pipelined(self) -> bool:
+        """
+        If ``True``, each of this object's plugins will be run on its own thread when this object is called directly.
+
+        *Introduced in v0.9.22.*
+
+
+        """
+
+    @pipelined.setter
+    def pipelined(self, arg1: bool) -> None:
+        pass
     pass
 
 class Mix(pedalboard_native.PluginContainer, pedalboard_native.Plugin):
     """
     A utility plugin that allows running other plugins in parallel. All plugins provided will be mixed equally.
+
+    If ``parallel`` is ``True``, each of the provided plugins will be run on its own thread (up to one thread per CPU core), which can speed up processing when each plugin does a lot of work (i.e.: reverbs, convolutions, pitch shifting, or long chains of plugins). For lightweight plugins or small buffer sizes, the overhead of coordinating threads may outweigh the benefit. (*Introduced in v0.9.22.*)
     """
 
     @typing.overload
-    def __init__(self, plugins: typing.List[pedalboard_native.Plugin]) -> None: ...
+    def __init__(
+        self, plugins: typing.List[pedalboard_native.Plugin], parallel: bool = False
+    ) -> None: ...
     @typing.overload
+    def __init__(self) -> None: ...
+    def __repr__(self) -> str: ...
+    @property
+    def parallel(self) -> bool:
+        """
+        If ``True``, each of this plugin's branches will be processed on a separate thread.
+
+        *Introduced in v0.9.22.*
+
+
+        """
+
+    @parallel.setter
+    def parallel(self, arg1: bool) -> None:
+        pass
+    pass
+
+class Profile:
+    """
+    Per-plugin timing information recorded while processing audio. Returned by the ``last_profile`` property of a :py:class:`pedalboard.Plugin` after calling :py:meth:`pedalboard.Plugin.process` with ``profile=True``.
+
+    Containers (like :class:`pedalboard.Pedalboard`, :class:`pedalboard.Chain` and :class:`pedalboard.Mix`) appear in ``entries`` before the plugins they contain.
+
+    *Introduced in v0.9.22.*
+    """
+
+    def __init__(self) -> None: ...
     def __repr__(self) -> str: ...
+    def to_chrome_trace(self) -> str:
+        """
+        Return a JSON string in the Chrome Trace Event format, containing one event for every block of audio processed by every plugin. Save this string to a ``.json`` file and open it in ``chrome://tracing`` or https://ui.perfetto.dev to visualize it.
+        """
+
+    @property
+    def entries(self) -> typing.List[ProfileEntry]:
+        """
+        A list of :class:`pedalboard.ProfileEntry` objects, one for each plugin that processed audio.
+        """
+
+    @property
+    def sample_rate(self) -> float:
+        """
+        The sample rate of the audio that was processed.
+        """
+
+    @property
+    def wall_time(self) -> float:
+        """
+        The total time (in seconds) spent processing audio.
+        """
+    pass
+
+class ProfileEntry:
+    """
+    Timing information about a single plugin, as recorded by a call to :py:meth:`pedalboard.Plugin.process` with ``profile=True``.
+
+    *Introduced in v0.9.22.*
+    """
+
+    def __repr__(self) -> str: ...
+    @property
+    def depth(self) -> int:
+        """
+        How deeply nested this plugin is within containers like :class:`pedalboard.Chain` or :class:`pedalboard.Mix`. The plugin that was called directly has a depth of 0.
+        """
+
+    @property
+    def name(self) -> str:
+        """
+        The class name of the plugin that was profiled.
+        """
+
+    @property
+    def num_calls(self) -> int:
+        """
+        The number of blocks of audio passed to this plugin.
+        """
+
+    @property
+    def parent(self) -> typing.Optional[ProfileEntry]:
+        """
+        The entry for the container plugin that called this plugin, or ``None`` if this plugin was called directly.
+        """
+
+    @property
+    def plugin(self) -> typing.Optional[pedalboard_native.Plugin]:
+        """
+        The plugin that was profiled, or ``None`` if it no longer exists.
+        """
+
+    @property
+    def realtime_factor(self) -> float:
+        """
+        How many times faster than real-time this plugin processed audio. (A value of 10 means that one second of audio took 0.1 seconds to process.)
+        """
+
+    @property
+    def samples_processed(self) -> int:
+        """
+        The total number of samples (per channel) passed to this plugin.
+        """
+
+    @property
+    def self_time(self) -> float:
+        """
+        The total time (in seconds) spent processing audio in this plugin, not including the time spent in any plugins it contains.
+        """
+
+    @property
+    def wall_time(self) -> float:
+        """
+        The total time (in seconds) spent processing audio in this plugin, including the time spent in any plugins it contains.
+        """
     pass
 
 def time_stretch(
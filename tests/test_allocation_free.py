@@ -0,0 +1,77 @@
+#! /usr/bin/env python
+#
+# Copyright 2025 Spotify AB
+#
+# Licensed under the GNU Public License, Version 3.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.gnu.org/licenses/gpl-3.0.html
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import numpy as np
+import pytest
+
+from pedalboard import Chain, Delay, Gain, Mix, Pedalboard, Reverb
+from pedalboard_native._internal import (  # type: ignore
+    AddLatency,
+    allocations_are_counted,
+    get_allocation_count,
+)
+
+SAMPLE_RATE = 44100
+CHUNK_SIZE = 512
+
+# Heap allocations are only counted in builds made with COUNT_ALLOCATIONS=1:
+pytestmark = pytest.mark.skipif(
+    not allocations_are_counted(),
+    reason="Pedalboard was not built with COUNT_ALLOCATIONS=1.",
+)
+
+
+def make_board(parallel: bool) -> Pedalboard:
+    return Pedalboard(
+        [
+            Gain(-6),
+            Mix(
+                [
+                    Chain([Delay(delay_seconds=0.01), Gain(-3)]),
+                    Chain([AddLatency(100), Reverb()]),
+                    AddLatency(300),
+                ],
+                parallel=parallel,
+            ),
+            Chain([Reverb(), Gain(3)]),
+        ]
+    )
+
+
+@pytest.mark.parametrize("parallel", [False, True])
+def test_streaming_processing_does_not_allocate(parallel: bool):
+    board = make_board(parallel)
+    audio = np.random.default_rng(0).random((2, CHUNK_SIZE * 20)).astype(np.float32) - 0.5
+    chunks = [audio[:, i : i + CHUNK_SIZE].copy() for i in range(0, audio.shape[1], CHUNK_SIZE)]
+
+    # Warm up, giving any plugins that need to allocate a chance to do so:
+    for chunk in chunks[:4]:
+        board(chunk, SAMPLE_RATE, reset=False, inplace=True)
+
+    allocations_before = get_allocation_count()
+    for chunk in chunks[4:]:
+        board(chunk, SAMPLE_RATE, reset=False, inplace=True)
+    assert get_allocation_count() == allocations_before
+
+
+def test_allocation_count_detects_heap_allocations():
+    # Processing the last chunk of a stream with a latent plugin requires
+    # growing the output buffer to fit the plugin's tail:
+    audio = np.zeros((2, CHUNK_SIZE), dtype=np.float32)
+    allocations_before = get_allocation_count()
+    Pedalboard([AddLatency(1000)])(audio, SAMPLE_RATE)
+    assert get_allocation_count() > allocations_before
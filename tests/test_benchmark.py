@@ -15,6 +15,8 @@
 # limitations under the License.
 
 
+import subprocess
+import sys
 import time
 
 import numpy as np
@@ -72,3 +74,158 @@ def test_pysox_performance_difference():
     # This test ensures we're at least 100x faster to account for
     # variations across test run environments.
     assert average_pysox_time / average_pedalboard_time > 100
+
+
+@pytest.mark.skip
+@pytest.mark.parametrize("num_channels", [1, 2, 4, 6, 8])
+def test_channel_layout_conversion_throughput(num_channels: int):
+    # Invert is about as cheap as a plugin can be, so the time taken here is
+    # dominated by converting between NumPy's layout and JUCE's planar buffers.
+    sr = 48000
+    num_samples = sr * 60
+    plugin = pedalboard.Invert()
+
+    planar = np.random.rand(num_channels, num_samples).astype(np.float32)
+    interleaved = np.ascontiguousarray(planar.T)
+
+    for name, audio in [("planar", planar), ("interleaved", interleaved)]:
+        measurements = []
+        for _ in range(0, 10):
+            with timer() as time_taken:
+                plugin(audio, sr, buffer_size=num_samples)
+            measurements.append(float(time_taken))
+        # Each call reads and writes the entire buffer once:
+        gigabytes = (2 * audio.nbytes) / 1e9
+        print(
+            f"{num_channels} channel(s), {name}: "
+            f"{gigabytes / np.median(measurements):.2f} GB/s"
+        )
+
+
+@pytest.mark.skip
+@pytest.mark.parametrize("num_branches", [2, 4, 8])
+def test_parallel_mix_scaling(num_branches: int):
+    sr = 48000
+    noise = np.random.rand(2, sr * 10).astype(np.float32)
+
+    def make_branch():
+        return pedalboard.Chain(
+            [
+                pedalboard.Reverb(),
+                pedalboard.Chorus(),
+                pedalboard.LadderFilter(),
+                pedalboard.Reverb(),
+            ]
+        )
+
+    timings = {}
+    for parallel in (False, True):
+        mix = pedalboard.Mix([make_branch() for _ in range(num_branches)], parallel=parallel)
+        measurements = []
+        for _ in range(0, 5):
+            with timer() as time_taken:
+                mix(noise, sr)
+            measurements.append(float(time_taken))
+        timings[parallel] = np.median(measurements)
+
+    print(
+        f"{num_branches} branches: {timings[False]:.3f}s sequential, "
+        f"{timings[True]:.3f}s parallel ({timings[False] / timings[True]:.2f}x faster)"
+    )
+    assert timings[True] < timings[False]
+
+
+@pytest.mark.skip
+@pytest.mark.parametrize("num_stages", [2, 4, 6])
+def test_pipelined_chain_scaling(num_stages: int):
+    sr = 48000
+    noise = np.random.rand(2, sr * 60).astype(np.float32)
+
+    def make_stage():
+        return pedalboard.Chain([pedalboard.Reverb(), pedalboard.Chorus(), pedalboard.Phaser()])
+
+    timings = {}
+    for pipelined in (False, True):
+        board = pedalboard.Pedalboard(
+            [make_stage() for _ in range(num_stages)], pipelined=pipelined
+        )
+        measurements = []
+        for _ in range(0, 3):
+            with timer() as time_taken:
+                board(noise, sr)
+            measurements.append(float(time_taken))
+        timings[pipelined] = np.median(measurements)
+
+    print(
+        f"{num_stages} stages: {timings[False]:.3f}s serial, "
+        f"{timings[True]:.3f}s pipelined ({timings[False] / timings[True]:.2f}x faster)"
+    )
+    assert timings[True] < timings[False]
+
+
+@pytest.mark.skip
+@pytest.mark.parametrize("sample_rate,target_sample_rate", [(44100, 16000), (48000, 44100)])
+@pytest.mark.parametrize("chunk_size", [1024, 65536, 1_000_000])
+def test_resampled_read_throughput(
+    tmp_path, sample_rate: int, target_sample_rate: int, chunk_size: int
+):
+    filename = str(tmp_path / "noise.wav")
+    duration = 60
+    noise = np.random.rand(2, sample_rate * duration).astype(np.float32)
+    with pedalboard.io.AudioFile(filename, "w", sample_rate, num_channels=2) as f:
+        f.write(noise)
+
+    measurements = []
+    for _ in range(0, 5):
+        with pedalboard.io.AudioFile(filename).resampled_to(target_sample_rate) as f:
+            with timer() as time_taken:
+                while f.tell() < f.frames:
+                    f.read(chunk_size)
+        measurements.append(float(time_taken))
+
+    print(
+        f"{sample_rate} Hz -> {target_sample_rate} Hz, {chunk_size}-frame reads: "
+        f"{duration / np.median(measurements):.1f}x realtime"
+    )
+
+
+TIME_TO_FIRST_SAMPLE_SCRIPT = """
+import sys
+import time
+
+import numpy as np
+
+from pedalboard import Resample
+
+quality = Resample.Quality.__members__[sys.argv[1]]
+audio = np.zeros((2, 1024), dtype=np.float32)
+
+start = time.perf_counter()
+Resample(16000, quality=quality).process(audio, 44100)
+first = time.perf_counter() - start
+
+start = time.perf_counter()
+Resample(16000, quality=quality).process(audio, 44100)
+second = time.perf_counter() - start
+
+print(first, second)
+"""
+
+
+@pytest.mark.skip
+@pytest.mark.parametrize("quality", pedalboard.Resample.Quality.__members__.keys())
+def test_resampler_time_to_first_sample(quality: str):
+    # Each quality's lookup tables are computed on first use, so measure from a
+    # fresh process (as a cold-started worker would be) each time:
+    measurements = []
+    for _ in range(0, 5):
+        output = subprocess.check_output(
+            [sys.executable, "-c", TIME_TO_FIRST_SAMPLE_SCRIPT, quality], text=True
+        )
+        measurements.append([float(value) for value in output.split()])
+    first, second = np.median(measurements, axis=0)
+
+    print(
+        f"{quality}: first resample took {first * 1000:.2f}ms, "
+        f"subsequent resamples take {second * 1000:.2f}ms"
+    )
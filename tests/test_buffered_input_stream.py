@@ -0,0 +1,133 @@
+#! /usr/bin/env python
+#
+# Copyright 2025 Spotify AB
+#
+# Licensed under the GNU Public License, Version 3.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.gnu.org/licenses/gpl-3.0.html
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import io
+
+import numpy as np
+import pytest
+
+from pedalboard.io import AudioFile, ReadableAudioFile
+
+SAMPLE_RATE = 44100
+NUM_FRAMES = 100_000
+
+
+class CountingStream(io.BytesIO):
+    """A file-like object that counts calls to read() and can't be read as a buffer."""
+
+    def __init__(self, data: bytes):
+        super().__init__(data)
+        self.read_calls = 0
+
+    def read(self, *args, **kwargs):
+        self.read_calls += 1
+        return super().read(*args, **kwargs)
+
+    # Avoid triggering the fast path for objects that support the buffer protocol:
+    def getbuffer(self):  # type: ignore
+        return None
+
+
+def encode_test_file(extension: str, num_channels: int = 2) -> bytes:
+    rng = np.random.default_rng(42)
+    audio = (rng.random((num_channels, NUM_FRAMES)).astype(np.float32) - 0.5) * 0.5
+    return AudioFile.encode(audio, SAMPLE_RATE, extension, num_channels, bit_depth=16)
+
+
+@pytest.mark.parametrize("extension", ["wav", "flac", "mp3"])
+@pytest.mark.parametrize("buffer_size", [1, 4096, 256 * 1024])
+def test_buffered_reads_match_unbuffered(extension: str, buffer_size: int):
+    data = encode_test_file(extension)
+    with AudioFile(CountingStream(data)) as f:
+        expected = f.read(f.frames)
+
+    with AudioFile(CountingStream(data), buffer_size=buffer_size) as f:
+        actual = np.concatenate([f.read(1000) for _ in range(0, f.frames, 1000)], axis=1)
+    np.testing.assert_array_equal(actual, expected)
+
+
+@pytest.mark.parametrize("extension", ["wav", "flac", "mp3"])
+def test_buffered_seeks_match_unbuffered(extension: str):
+    data = encode_test_file(extension)
+    offsets = [50_000, 0, 1234, 99_000, 1000, 75_000]
+
+    with AudioFile(CountingStream(data)) as f:
+        expected = []
+        for offset in offsets:
+            f.seek(offset)
+            expected.append(f.read(500))
+            assert f.tell() == offset + expected[-1].shape[1]
+
+    with AudioFile(CountingStream(data), buffer_size=8192) as f:
+        for offset, expected_chunk in zip(offsets, expected):
+            f.seek(offset)
+            np.testing.assert_array_equal(f.read(500), expected_chunk)
+            assert f.tell() == offset + expected_chunk.shape[1]
+
+
+def test_buffering_reduces_python_calls():
+    data = encode_test_file("flac")
+
+    unbuffered = CountingStream(data)
+    with AudioFile(unbuffered) as f:
+        while f.tell() < f.frames:
+            f.read(256)
+
+    buffered = CountingStream(data)
+    with ReadableAudioFile(buffered, buffer_size=len(data)) as f:
+        while f.tell() < f.frames:
+            f.read(256)
+
+    assert buffered.read_calls < unbuffered.read_calls
+    # Most of the file should be read in one call (with a few more calls to
+    # detect the end of the stream):
+    assert buffered.read_calls < 10
+
+
+def test_buffered_exceptions_propagate_on_read():
+    data = encode_test_file("wav")
+    stream = CountingStream(data)
+    stream_read = stream.read
+    should_throw = [False]
+
+    def eventually_throw_exception(*args, **kwargs):
+        if should_throw[0]:
+            raise ValueError("Some kinda error!")
+        return stream_read(*args, **kwargs)
+
+    stream.read = eventually_throw_exception  # type: ignore
+
+    with AudioFile(stream, buffer_size=4096) as f:
+        assert f.read(1).nbytes > 0
+        should_throw[0] = True
+        with pytest.raises(ValueError, match="Some kinda error!"):
+            for _ in range(f.frames - 1):
+                f.read(1)
+
+
+def test_buffer_size_is_ignored_for_buffers():
+    data = encode_test_file("wav")
+    with AudioFile(io.BytesIO(data)) as f:
+        expected = f.read(f.frames)
+    with AudioFile(memoryview(data), buffer_size=4096) as f:
+        np.testing.assert_array_equal(f.read(f.frames), expected)
+
+
+def test_negative_buffer_size_raises():
+    data = encode_test_file("wav")
+    with pytest.raises(ValueError, match="buffer_size"):
+        AudioFile(CountingStream(data), buffer_size=-1)
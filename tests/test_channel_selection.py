@@ -0,0 +1,112 @@
+#! /usr/bin/env python
+#
+# Copyright 2025 Spotify AB
+#
+# Licensed under the GNU Public License, Version 3.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.gnu.org/licenses/gpl-3.0.html
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import os
+
+import numpy as np
+import pytest
+
+from pedalboard.io import AudioFile
+
+SAMPLE_RATE = 44100
+NUM_FRAMES = 100_000
+
+
+def write_test_file(tmp_path, extension: str, num_channels: int) -> str:
+    rng = np.random.default_rng(42)
+    audio = (rng.random((num_channels, NUM_FRAMES)).astype(np.float32) - 0.5) * 0.5
+    filename = os.path.join(str(tmp_path), f"test.{extension}")
+    with AudioFile(filename, "w", SAMPLE_RATE, num_channels) as f:
+        f.write(audio)
+    return filename
+
+
+@pytest.mark.parametrize("extension", ["wav", "flac"])
+@pytest.mark.parametrize("channels", [[0], [5], [1, 0], [0, 2, 4], [3, 3], list(range(6))])
+def test_read_channels(tmp_path, extension: str, channels):
+    filename = write_test_file(tmp_path, extension, num_channels=6)
+    with AudioFile(filename) as f:
+        expected = f.read(f.frames)[channels]
+
+    with AudioFile(filename) as f:
+        actual = np.concatenate(
+            [f.read(10_000, channels=channels) for _ in range(0, f.frames, 10_000)], axis=1
+        )
+        assert f.tell() == f.frames
+    np.testing.assert_array_equal(actual, expected)
+
+
+@pytest.mark.parametrize("extension", ["wav", "flac", "mp3"])
+@pytest.mark.parametrize("num_channels", [1, 2])
+def test_read_channels_of_mono_and_stereo(tmp_path, extension: str, num_channels: int):
+    filename = write_test_file(tmp_path, extension, num_channels)
+    with AudioFile(filename) as f:
+        expected = f.read(f.frames)
+
+    with AudioFile(filename) as f:
+        np.testing.assert_array_equal(f.read(f.frames, channels=[num_channels - 1]), expected[-1:])
+
+
+@pytest.mark.parametrize("extension", ["wav", "flac"])
+@pytest.mark.parametrize("num_channels", [1, 2, 6])
+@pytest.mark.parametrize("num_threads", [1, 4])
+def test_downmix_to_mono(tmp_path, extension: str, num_channels: int, num_threads: int):
+    filename = write_test_file(tmp_path, extension, num_channels)
+    with AudioFile(filename) as f:
+        expected = np.mean(f.read(f.frames), axis=0, keepdims=True)
+
+    with AudioFile(filename) as f:
+        actual = f.read(f.frames, num_threads=num_threads, downmix="mono")
+        assert actual.shape == (1, f.frames)
+    np.testing.assert_allclose(actual, expected, atol=1e-6)
+
+
+def test_downmix_selected_channels(tmp_path):
+    filename = write_test_file(tmp_path, "wav", num_channels=6)
+    with AudioFile(filename) as f:
+        expected = np.mean(f.read(f.frames)[[0, 1, 1]], axis=0, keepdims=True)
+
+    with AudioFile(filename) as f:
+        actual = f.read(f.frames, channels=[0, 1, 1], downmix="mono")
+    np.testing.assert_allclose(actual, expected, atol=1e-6)
+
+
+def test_channel_selection_with_prefetch(tmp_path):
+    filename = write_test_file(tmp_path, "flac", num_channels=2)
+    with AudioFile(filename) as f:
+        expected = f.read(f.frames)
+
+    with AudioFile(filename, prefetch=2) as f:
+        right = f.read(50_000, channels=[1])
+        mono = f.read(f.frames, downmix="mono")
+    np.testing.assert_array_equal(right, expected[1:, :50_000])
+    expected_mono = np.mean(expected[:, 50_000:], axis=0, keepdims=True)
+    np.testing.assert_allclose(mono, expected_mono, atol=1e-6)
+
+
+def test_invalid_channels_and_downmix(tmp_path):
+    filename = write_test_file(tmp_path, "wav", num_channels=2)
+    with AudioFile(filename) as f:
+        with pytest.raises(ValueError, match="channel 2"):
+            f.read(100, channels=[0, 2])
+        with pytest.raises(ValueError, match="channel -1"):
+            f.read(100, channels=[-1])
+        with pytest.raises(ValueError, match="at least one"):
+            f.read(100, channels=[])
+        with pytest.raises(ValueError, match="downmix"):
+            f.read(100, downmix="stereo")
+        assert f.tell() == 0
@@ -0,0 +1,180 @@
+#! /usr/bin/env python
+#
+# Copyright 2025 Spotify AB
+#
+# Licensed under the GNU Public License, Version 3.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.gnu.org/licenses/gpl-3.0.html
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import os
+import re
+from concurrent.futures import ThreadPoolExecutor
+
+import numpy as np
+import pytest
+
+from pedalboard import (
+    Bitcrush,
+    Chain,
+    Chorus,
+    Clipping,
+    Compressor,
+    Convolution,
+    Delay,
+    Distortion,
+    Gain,
+    GSMFullRateCompressor,
+    HighpassFilter,
+    HighShelfFilter,
+    Invert,
+    LadderFilter,
+    Limiter,
+    LowpassFilter,
+    Mix,
+    MP3Compressor,
+    NoiseGate,
+    Pedalboard,
+    Phaser,
+    PitchShift,
+    Resample,
+    Reverb,
+)
+from pedalboard_native._internal import AddLatency  # type: ignore
+
+SAMPLE_RATE = 44100
+IMPULSE_RESPONSE_PATH = os.path.join(os.path.dirname(__file__), "impulse_response.wav")
+
+PLUGIN_FACTORIES = [
+    lambda: AddLatency(100),
+    lambda: Bitcrush(bit_depth=6),
+    lambda: Chorus(rate_hz=2, depth=0.5),
+    lambda: Clipping(-6),
+    lambda: Compressor(threshold_db=-20, ratio=4),
+    lambda: Convolution(IMPULSE_RESPONSE_PATH, mix=0.5),
+    lambda: Delay(delay_seconds=0.01, feedback=0.5, mix=0.5),
+    lambda: Distortion(drive_db=12),
+    lambda: Gain(-6),
+    lambda: GSMFullRateCompressor(),
+    lambda: HighpassFilter(1000),
+    lambda: HighShelfFilter(4000, gain_db=6),
+    lambda: Invert(),
+    lambda: LadderFilter(cutoff_hz=800),
+    lambda: Limiter(threshold_db=-6),
+    lambda: LowpassFilter(1000),
+    lambda: MP3Compressor(vbr_quality=4),
+    lambda: NoiseGate(threshold_db=-30),
+    lambda: Phaser(rate_hz=2),
+    lambda: PitchShift(semitones=-3),
+    lambda: Resample(target_sample_rate=16000, quality=Resample.Quality.Linear),
+    lambda: Reverb(room_size=0.6),
+]
+
+
+def make_audio(num_channels: int = 2, num_samples: int = SAMPLE_RATE):
+    rng = np.random.default_rng(0)
+    return (rng.random((num_channels, num_samples)).astype(np.float32) - 0.5) * 0.5
+
+
+def repr_without_address(plugin) -> str:
+    return re.sub(r" at 0x[0-9a-fA-F]+", "", repr(plugin))
+
+
+@pytest.mark.parametrize("plugin_factory", PLUGIN_FACTORIES)
+def test_clone_has_same_parameters_and_output(plugin_factory):
+    plugin = plugin_factory()
+    audio = make_audio()
+    expected = plugin(audio, SAMPLE_RATE)
+
+    clone = plugin.clone()
+    assert type(clone) is type(plugin)
+    assert clone is not plugin
+    assert repr_without_address(clone) == repr_without_address(plugin)
+    np.testing.assert_allclose(clone(audio, SAMPLE_RATE), expected, atol=1e-6)
+
+
+@pytest.mark.parametrize("plugin_factory", PLUGIN_FACTORIES)
+def test_clone_does_not_share_state(plugin_factory):
+    plugin = plugin_factory()
+    audio = make_audio()
+    expected = plugin(audio, SAMPLE_RATE)
+
+    clone = plugin.clone()
+    # Leave the original plugin with some audio in its internal buffers:
+    plugin(make_audio() * 2, SAMPLE_RATE, reset=False)
+    np.testing.assert_allclose(clone(audio, SAMPLE_RATE, reset=False), expected, atol=1e-6)
+
+
+def test_clone_does_not_track_later_parameter_changes():
+    plugin = Gain(-6)
+    clone = plugin.clone()
+    plugin.gain_db = 6
+    assert clone.gain_db == -6
+
+
+def test_convolution_clone_shares_impulse_response():
+    impulse_response = make_audio(1, 1024)
+    plugin = Convolution(impulse_response, sample_rate=SAMPLE_RATE, mix=0.75)
+    clone = plugin.clone()
+
+    assert clone.mix == plugin.mix
+    assert clone.impulse_response_filename is None
+    np.testing.assert_array_equal(clone.impulse_response, plugin.impulse_response)
+
+    audio = make_audio()
+    np.testing.assert_allclose(clone(audio, SAMPLE_RATE), plugin(audio, SAMPLE_RATE), atol=1e-6)
+
+
+def test_convolution_clone_keeps_filename():
+    plugin = Convolution(IMPULSE_RESPONSE_PATH)
+    assert plugin.clone().impulse_response_filename == IMPULSE_RESPONSE_PATH
+
+
+@pytest.mark.parametrize("pipelined", [False, True])
+def test_pedalboard_clone(pipelined: bool):
+    board = Pedalboard(
+        [Gain(-3), Mix([Delay(delay_seconds=0.01), PitchShift(2)]), Reverb()],
+        pipelined=pipelined,
+    )
+    clone = board.clone()
+
+    assert isinstance(clone, Pedalboard)
+    assert clone.pipelined == pipelined
+    assert len(clone) == len(board)
+    for original, cloned in zip(board, clone):
+        assert type(original) is type(cloned)
+        assert original is not cloned
+    assert len(clone[1]) == len(board[1])
+    assert clone[1][0] is not board[1][0]
+
+    audio = make_audio()
+    np.testing.assert_allclose(clone(audio, SAMPLE_RATE), board(audio, SAMPLE_RATE), atol=1e-6)
+
+
+def test_chain_clone_is_a_chain():
+    chain = Chain([Gain(-3), Clipping(-6)])
+    clone = chain.clone()
+    assert type(clone) is Chain
+    assert [type(p) for p in clone] == [type(p) for p in chain]
+
+
+@pytest.mark.parametrize("num_workers", [2, 4])
+def test_clones_can_process_concurrently(num_workers: int):
+    board = Pedalboard([Convolution(IMPULSE_RESPONSE_PATH), PitchShift(-2), Reverb()])
+    audio = make_audio()
+    expected = board(audio, SAMPLE_RATE)
+
+    clones = [board.clone() for _ in range(num_workers)]
+    with ThreadPoolExecutor(num_workers) as executor:
+        outputs = list(executor.map(lambda clone: clone(audio, SAMPLE_RATE), clones))
+
+    for output in outputs:
+        np.testing.assert_allclose(output, expected, atol=1e-6)
@@ -0,0 +1,102 @@
+#! /usr/bin/env python
+#
+# Copyright 2025 Spotify AB
+#
+# Licensed under the GNU Public License, Version 3.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.gnu.org/licenses/gpl-3.0.html
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import gc
+
+import numpy as np
+import pytest
+
+from pedalboard import Convolution
+from pedalboard_native._internal import get_convolution_spectrum_cache_size  # type: ignore
+
+SAMPLE_RATE = 44100
+
+
+def make_impulse_response(seed: int, num_channels: int = 1, num_samples: int = 22050):
+    rng = np.random.default_rng(seed)
+    decay = np.exp(-np.linspace(0, 8, num_samples))
+    return (rng.random((num_channels, num_samples)) - 0.5).astype(np.float32) * decay
+
+
+def make_audio(num_samples: int = SAMPLE_RATE):
+    rng = np.random.default_rng(0)
+    return (rng.random((2, num_samples)).astype(np.float32) - 0.5) * 0.5
+
+
+@pytest.mark.parametrize("num_channels", [1, 2])
+def test_convolution_instances_share_spectra(num_channels: int):
+    impulse_response = make_impulse_response(1234, num_channels)
+    audio = make_audio()
+    baseline = get_convolution_spectrum_cache_size()
+
+    first = Convolution(impulse_response, sample_rate=SAMPLE_RATE)
+    expected = first(audio, SAMPLE_RATE)
+    size_with_one_instance = get_convolution_spectrum_cache_size()
+    assert size_with_one_instance > baseline
+
+    others = [Convolution(impulse_response, sample_rate=SAMPLE_RATE) for _ in range(3)]
+    others += [first.clone() for _ in range(3)]
+    for other in others:
+        np.testing.assert_allclose(other(audio, SAMPLE_RATE), expected, atol=1e-6)
+
+    assert get_convolution_spectrum_cache_size() == size_with_one_instance
+
+    del first, others
+    gc.collect()
+    assert get_convolution_spectrum_cache_size() == baseline
+
+
+def test_different_impulse_responses_do_not_share_spectra():
+    audio = make_audio()
+    baseline = get_convolution_spectrum_cache_size()
+
+    first = Convolution(make_impulse_response(1), sample_rate=SAMPLE_RATE)
+    second = Convolution(make_impulse_response(2), sample_rate=SAMPLE_RATE)
+    first_output = first(audio, SAMPLE_RATE)
+    second_output = second(audio, SAMPLE_RATE)
+
+    assert get_convolution_spectrum_cache_size() == baseline + 2
+    assert not np.allclose(first_output, second_output)
+
+
+def test_different_block_sizes_do_not_share_spectra():
+    impulse_response = make_impulse_response(5678)
+    audio = make_audio()
+    baseline = get_convolution_spectrum_cache_size()
+
+    first = Convolution(impulse_response, sample_rate=SAMPLE_RATE)
+    second = Convolution(impulse_response, sample_rate=SAMPLE_RATE)
+    first_output = first(audio, SAMPLE_RATE, buffer_size=512)
+    second_output = second(audio, SAMPLE_RATE, buffer_size=4096)
+
+    assert get_convolution_spectrum_cache_size() == baseline + 2
+    np.testing.assert_allclose(first_output, second_output, atol=1e-5)
+
+
+def test_spectra_are_shared_across_prepare_calls():
+    impulse_response = make_impulse_response(91011)
+    audio = make_audio()
+
+    plugin = Convolution(impulse_response, sample_rate=SAMPLE_RATE)
+    expected = plugin(audio, SAMPLE_RATE, buffer_size=1024)
+    size_after_first_call = get_convolution_spectrum_cache_size()
+
+    # A second instance prepared with the same settings should reuse the
+    # spectra computed when the first instance was prepared:
+    other = Convolution(impulse_response, sample_rate=SAMPLE_RATE)
+    np.testing.assert_allclose(other(audio, SAMPLE_RATE, buffer_size=1024), expected, atol=1e-6)
+    assert get_convolution_spectrum_cache_size() == size_after_first_call
@@ -0,0 +1,184 @@
+#! /usr/bin/env python
+#
+# Copyright 2025 Spotify AB
+#
+# Licensed under the GNU Public License, Version 3.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.gnu.org/licenses/gpl-3.0.html
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import numpy as np
+import pytest
+
+from pedalboard import (
+    Chain,
+    Clipping,
+    Compressor,
+    Delay,
+    Gain,
+    HighpassFilter,
+    HighShelfFilter,
+    LowpassFilter,
+    LowShelfFilter,
+    PeakFilter,
+    Pedalboard,
+    Reverb,
+    process,
+)
+
+SAMPLE_RATE = 44100
+
+DOUBLE_PRECISION_PLUGINS = [
+    lambda: Clipping(-12),
+    lambda: Compressor(threshold_db=-20, ratio=4),
+    lambda: Delay(delay_seconds=0.01, feedback=0.5, mix=0.5),
+    lambda: Gain(-6),
+    lambda: HighpassFilter(1000),
+    lambda: HighShelfFilter(4000, gain_db=6),
+    lambda: LowpassFilter(1000),
+    lambda: LowShelfFilter(200, gain_db=-6),
+    lambda: PeakFilter(1000, gain_db=3, q=2),
+]
+
+
+def make_audio(shape):
+    return (np.random.default_rng(0).random(shape) - 0.5) * 0.5
+
+
+@pytest.mark.parametrize("plugin_factory", DOUBLE_PRECISION_PLUGINS)
+@pytest.mark.parametrize("shape", [(4410,), (2, 4410), (4410, 2)])
+def test_double_precision_processing_matches_single_precision(plugin_factory, shape):
+    plugin = plugin_factory()
+    assert plugin.supports_double_precision
+
+    audio = make_audio(shape)
+    output = plugin(audio, SAMPLE_RATE, double_precision=True)
+    assert output.dtype == np.float64
+    assert output.shape == audio.shape
+
+    expected = plugin(audio, SAMPLE_RATE)
+    assert expected.dtype == np.float32
+    np.testing.assert_allclose(output, expected, atol=1e-4)
+
+
+@pytest.mark.parametrize("plugin_factory", DOUBLE_PRECISION_PLUGINS)
+def test_double_precision_plugin_repr(plugin_factory):
+    plugin = plugin_factory()
+    assert repr(plugin).startswith(f"<pedalboard.{plugin.__class__.__name__} ")
+
+    # Processing 64-bit audio shouldn't change the plugin's repr:
+    before = repr(plugin)
+    plugin(make_audio((2, 441)), SAMPLE_RATE, double_precision=True)
+    assert repr(plugin) == before
+
+
+def test_double_precision_processing_does_not_lose_precision():
+    audio = make_audio((2, 4410))
+    # A float64 value that can't be represented exactly as a float32:
+    audio[0, 0] = 0.1
+    output = Gain(0)(audio, SAMPLE_RATE, double_precision=True)
+    np.testing.assert_array_equal(output, audio)
+
+
+def test_double_precision_picks_up_parameter_changes():
+    plugin = Gain(0)
+    audio = make_audio((2, 4410))
+    np.testing.assert_array_equal(plugin(audio, SAMPLE_RATE, double_precision=True), audio)
+
+    plugin.gain_db = -6
+    np.testing.assert_allclose(
+        plugin(audio, SAMPLE_RATE, double_precision=True), audio * (10 ** (-6 / 20)), rtol=1e-9
+    )
+
+
+@pytest.mark.parametrize("pipelined", [False, True])
+def test_double_precision_pedalboard(pipelined: bool):
+    board = Pedalboard(
+        [Gain(-3), Chain([HighpassFilter(100), Compressor()]), Delay(0.01)],
+        pipelined=pipelined,
+    )
+    assert board.supports_double_precision
+
+    audio = make_audio((2, 44100))
+    output = board(audio, SAMPLE_RATE, double_precision=True)
+    assert output.dtype == np.float64
+    np.testing.assert_allclose(output, board(audio, SAMPLE_RATE), atol=1e-4)
+
+
+def test_output_dtype_does_not_depend_on_plugins():
+    audio = make_audio((2, 4410))
+    # Without double_precision, 64-bit input always produces 32-bit output:
+    assert process(audio, SAMPLE_RATE, [Gain(-3), Delay()]).dtype == np.float32
+    assert process(audio, SAMPLE_RATE, [Gain(-3), Reverb()]).dtype == np.float32
+    assert process(audio, SAMPLE_RATE, []).dtype == np.float32
+
+    # ...and with it, 32-bit input always produces 64-bit output:
+    float32_audio = audio.astype(np.float32)
+    for plugins in ([Gain(-3)], []):
+        output = process(float32_audio, SAMPLE_RATE, plugins, double_precision=True)
+        assert output.dtype == np.float64
+
+
+def test_unsupported_plugins_raise_with_double_precision():
+    board = Pedalboard([Gain(-3), Reverb()])
+    assert not Reverb().supports_double_precision
+    assert not board.supports_double_precision
+
+    audio = make_audio((2, 4410))
+    with pytest.raises(ValueError):
+        board(audio, SAMPLE_RATE, double_precision=True)
+    with pytest.raises(ValueError):
+        process(audio, SAMPLE_RATE, [Gain(-3), Reverb()], double_precision=True)
+
+
+def test_output_array_matches_double_precision_flag():
+    audio = make_audio((2, 4410))
+    expected = audio * (10 ** (-6 / 20))
+
+    out = np.empty(audio.shape, dtype=np.float32)
+    result = Gain(-6)(audio, SAMPLE_RATE, out=out)
+    assert result.dtype == np.float32
+    np.testing.assert_allclose(out, expected, atol=1e-6)
+
+    out = np.empty(audio.shape, dtype=np.float64)
+    result = Gain(-6)(audio, SAMPLE_RATE, out=out, double_precision=True)
+    assert result.dtype == np.float64
+    assert np.shares_memory(result, out)
+    np.testing.assert_allclose(out, expected, rtol=1e-9)
+
+    with pytest.raises(TypeError):
+        out = np.empty(audio.shape, dtype=np.float32)
+        Gain(-6)(audio, SAMPLE_RATE, out=out, double_precision=True)
+
+
+def test_inplace_processing_with_double_precision():
+    audio = make_audio((2, 4410))
+    expected = audio * (10 ** (-6 / 20))
+    result = Gain(-6)(audio, SAMPLE_RATE, inplace=True, double_precision=True)
+    assert result.dtype == np.float64
+    assert np.shares_memory(result, audio)
+    np.testing.assert_allclose(audio, expected, rtol=1e-9)
+
+    with pytest.raises(TypeError):
+        Gain(-6)(audio.astype(np.float32), SAMPLE_RATE, inplace=True, double_precision=True)
+
+
+def test_double_precision_streaming_keeps_state():
+    audio = make_audio((2, 44100))
+    plugin = Delay(delay_seconds=0.01, feedback=0.5, mix=0.5)
+    expected = plugin(audio, SAMPLE_RATE, double_precision=True)
+
+    plugin.reset()
+    chunks = [
+        plugin(chunk, SAMPLE_RATE, reset=False, double_precision=True)
+        for chunk in np.split(audio, 10, axis=1)
+    ]
+    np.testing.assert_allclose(np.concatenate(chunks, axis=1), expected, rtol=1e-9)
@@ -1213,6 +1213,32 @@ def test_external_effect_plugin_concurrency(plugin_filename: str, num_plugins: i
         np.testing.assert_allclose(a, b, atol=0.05)
 
 
+@pytest.mark.parametrize("plugin_filename", AVAILABLE_EFFECT_PLUGINS_IN_TEST_ENVIRONMENT)
+def test_external_effect_plugin_clone(plugin_filename: str):
+    plugin = load_test_plugin(plugin_filename, disable_caching=True)
+
+    if plugin._reload_type != pedalboard.ExternalPluginReloadType.ClearsAudioOnReset:
+        with pytest.raises(RuntimeError, match="cannot be cloned"):
+            plugin.clone()
+        return
+
+    clone = plugin.clone()
+    assert type(clone) is type(plugin)
+    assert clone is not plugin
+    assert clone._reload_type == plugin._reload_type
+    for name in plugin.parameters.keys():
+        assert getattr(clone, name) == getattr(plugin, name)
+
+    sr = 44100
+    noise = np.random.rand(2, sr)
+    np.testing.assert_allclose(clone(noise, sr), plugin(noise, sr), atol=0.05)
+
+    # Cloning must not be possible from any thread other than the main thread:
+    with ThreadPoolExecutor(1) as executor:
+        with pytest.raises(RuntimeError, match="cannot be cloned"):
+            executor.submit(plugin.clone).result()
+
+
 @pytest.mark.parametrize("plugin_filename", AVAILABLE_INSTRUMENT_PLUGINS_IN_TEST_ENVIRONMENT)
 @pytest.mark.parametrize("num_plugins", [2, 4])
 @pytest.mark.parametrize(
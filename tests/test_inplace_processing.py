@@ -0,0 +1,124 @@
+#! /usr/bin/env python
+#
+# Copyright 2025 Spotify AB
+#
+# Licensed under the GNU Public License, Version 3.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.gnu.org/licenses/gpl-3.0.html
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import numpy as np
+import pytest
+
+from pedalboard import Distortion, Gain, Pedalboard, process
+from pedalboard_native._internal import AddLatency  # type: ignore
+
+SAMPLE_RATE = 44100
+
+
+def make_audio(shape):
+    return (np.random.default_rng(0).random(shape).astype(np.float32) - 0.5) * 0.5
+
+
+@pytest.mark.parametrize("shape", [(44100,), (2, 44100), (44100, 2), (6, 1000), (1000, 6)])
+@pytest.mark.parametrize("latency", [0, 1000])
+def test_inplace_processing_matches_regular_processing(shape, latency: int):
+    board = Pedalboard([Gain(-6), Distortion(), AddLatency(latency)])
+    audio = make_audio(shape)
+    expected = board(audio, SAMPLE_RATE)
+
+    result = board(audio, SAMPLE_RATE, inplace=True)
+    assert result.shape == expected.shape
+    assert np.shares_memory(result, audio)
+    np.testing.assert_allclose(audio, expected, atol=1e-6)
+
+
+@pytest.mark.parametrize("shape", [(44100,), (2, 44100), (44100, 2)])
+@pytest.mark.parametrize("latency", [0, 1000])
+def test_processing_into_output_array(shape, latency: int):
+    board = Pedalboard([Gain(-6), Distortion(), AddLatency(latency)])
+    audio = make_audio(shape)
+    original = audio.copy()
+    out = np.zeros_like(audio)
+
+    result = board(audio, SAMPLE_RATE, out=out)
+
+    assert np.shares_memory(result, out)
+    np.testing.assert_allclose(out, board(audio, SAMPLE_RATE), atol=1e-6)
+    # The input should not have been modified:
+    np.testing.assert_array_equal(audio, original)
+
+
+def test_process_function_accepts_output_array():
+    plugins = [Gain(-6)]
+    audio = make_audio((2, 1000))
+    out = np.empty_like(audio)
+    process(audio, SAMPLE_RATE, plugins, out=out)
+    np.testing.assert_allclose(out, audio * (10 ** (-6 / 20)), rtol=1e-5)
+
+
+def test_output_array_with_float64_input():
+    audio = make_audio((2, 1000)).astype(np.float64)
+    out = np.empty(audio.shape, dtype=np.float32)
+    Gain(0)(audio, SAMPLE_RATE, out=out)
+    np.testing.assert_allclose(out, audio, atol=1e-6)
+
+
+def test_partial_output_with_latency_and_no_reset():
+    # Without reset, a plugin with latency returns fewer samples than provided;
+    # the returned view should only contain the samples that were produced.
+    plugin = AddLatency(1000)
+    audio = make_audio((2, 4000))
+    expected = plugin(audio.copy(), SAMPLE_RATE, reset=False)
+    plugin.reset()
+
+    result = plugin(audio, SAMPLE_RATE, reset=False, inplace=True)
+    assert result.shape == expected.shape == (2, 3000)
+    assert np.shares_memory(result, audio)
+    np.testing.assert_allclose(result, expected)
+
+
+def test_inplace_requires_float32():
+    with pytest.raises(TypeError):
+        Gain(-6)(make_audio((2, 1000)).astype(np.float64), SAMPLE_RATE, inplace=True)
+
+
+def test_output_array_must_be_float32():
+    audio = make_audio((2, 1000))
+    with pytest.raises(TypeError):
+        Gain(-6)(audio, SAMPLE_RATE, out=np.empty(audio.shape, dtype=np.float64))
+
+
+def test_output_array_must_match_input_shape():
+    audio = make_audio((2, 1000))
+    with pytest.raises(ValueError):
+        Gain(-6)(audio, SAMPLE_RATE, out=np.empty((2, 999), dtype=np.float32))
+
+
+def test_output_array_must_be_contiguous():
+    audio = make_audio((2, 1000))
+    out = np.empty((1000, 2), dtype=np.float32).T
+    with pytest.raises(ValueError):
+        Gain(-6)(audio, SAMPLE_RATE, out=out)
+
+
+def test_output_array_must_be_writeable():
+    audio = make_audio((2, 1000))
+    out = np.empty_like(audio)
+    out.flags.writeable = False
+    with pytest.raises(ValueError):
+        Gain(-6)(audio, SAMPLE_RATE, out=out)
+
+
+def test_out_and_inplace_are_mutually_exclusive():
+    audio = make_audio((2, 1000))
+    with pytest.raises(ValueError):
+        Gain(-6)(audio, SAMPLE_RATE, out=np.empty_like(audio), inplace=True)
@@ -0,0 +1,79 @@
+#! /usr/bin/env python
+#
+# Copyright 2025 Spotify AB
+#
+# Licensed under the GNU Public License, Version 3.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.gnu.org/licenses/gpl-3.0.html
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import io
+
+import numpy as np
+import pytest
+
+from pedalboard import Invert
+from pedalboard.io import AudioFile
+
+# Lengths chosen to exercise both the SIMD kernels and their scalar remainders:
+LENGTHS = [2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 33, 4099]
+
+# Arrays with fewer samples than channels are detected as planar, so would
+# never reach the interleaving code; only test shapes that are detected as
+# interleaved:
+INTERLEAVED_SHAPES = [
+    (num_samples, num_channels)
+    for num_channels in range(1, 13)
+    for num_samples in LENGTHS
+    if num_samples > num_channels
+]
+
+
+@pytest.mark.parametrize("num_samples,num_channels", INTERLEAVED_SHAPES)
+def test_interleaved_processing_round_trip(num_channels: int, num_samples: int):
+    interleaved = np.random.rand(num_samples, num_channels).astype(np.float32)
+    output = Invert()(interleaved, 44100)
+    assert output.shape == interleaved.shape
+    np.testing.assert_array_equal(output, -interleaved)
+
+
+@pytest.mark.parametrize("num_channels", [1, 2, 3, 4, 6, 8, 11])
+@pytest.mark.parametrize("num_samples", [17, 4099])
+def test_interleaved_processing_into_output_array(num_channels: int, num_samples: int):
+    interleaved = np.random.rand(num_samples, num_channels).astype(np.float32)
+    out = np.zeros_like(interleaved)
+    Invert()(interleaved, 44100, out=out)
+    np.testing.assert_array_equal(out, -interleaved)
+
+
+@pytest.mark.parametrize("num_channels", [1, 2, 3, 4, 6, 8])
+@pytest.mark.parametrize("dtype", [np.float32, np.int16])
+def test_writing_interleaved_audio(num_channels: int, dtype):
+    num_samples = 10007
+    if dtype == np.int16:
+        interleaved = np.random.randint(-32768, 32767, (num_samples, num_channels), dtype=dtype)
+    else:
+        interleaved = np.random.rand(num_samples, num_channels).astype(dtype) - 0.5
+
+    buffer = io.BytesIO()
+    buffer.name = "test.wav"
+    bit_depth = 16 if dtype == np.int16 else 32
+    with AudioFile(buffer, "w", 44100, num_channels, bit_depth=bit_depth) as f:
+        f.write(interleaved)
+
+    buffer.seek(0)
+    with AudioFile(buffer) as f:
+        planar = f.read(f.frames)
+
+    if dtype == np.int16:
+        np.testing.assert_allclose(planar.T, interleaved / 32768, atol=1e-6)
+    else:
+        np.testing.assert_array_equal(planar.T, interleaved)
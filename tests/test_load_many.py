@@ -0,0 +1,141 @@
+#! /usr/bin/env python
+#
+# Copyright 2025 Spotify AB
+#
+# Licensed under the GNU Public License, Version 3.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.gnu.org/licenses/gpl-3.0.html
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import os
+
+import numpy as np
+import pytest
+
+from pedalboard.io import AudioFile, load_many
+
+SAMPLE_RATE = 44100
+
+
+def write_clip(tmp_path, name: str, num_channels: int, num_frames: int, samplerate=SAMPLE_RATE):
+    rng = np.random.default_rng(abs(hash(name)) % (2**32))
+    audio = (rng.random((num_channels, num_frames)).astype(np.float32) - 0.5) * 0.5
+    filename = os.path.join(str(tmp_path), name)
+    with AudioFile(filename, "w", samplerate, num_channels, bit_depth=32) as f:
+        f.write(audio)
+    return filename
+
+
+def load_one(filename: str, sample_rate: float, num_frames=None) -> np.ndarray:
+    with AudioFile(filename).resampled_to(sample_rate) as f:
+        if num_frames is None:
+            chunks = []
+            while True:
+                chunk = f.read(65536)
+                chunks.append(chunk)
+                if chunk.shape[1] < 65536:
+                    break
+            return np.concatenate(chunks, axis=1)
+        return f.read(num_frames)
+
+
+@pytest.mark.parametrize("sample_rate", [SAMPLE_RATE, 22050, 48000])
+@pytest.mark.parametrize("num_threads", [0, 1, 3])
+def test_load_many_with_duration(tmp_path, sample_rate: float, num_threads: int):
+    paths = [write_clip(tmp_path, f"clip_{i}.wav", 2, 10000 + 5000 * i) for i in range(6)]
+    duration = 0.5
+    num_frames = round(duration * sample_rate)
+
+    audio, lengths, errors = load_many(
+        paths, sample_rate, num_channels=2, duration=duration, num_threads=num_threads
+    )
+
+    assert audio.dtype == np.float32
+    assert audio.shape == (len(paths), 2, num_frames)
+    assert errors == [None] * len(paths)
+    for i, path in enumerate(paths):
+        expected = load_one(path, sample_rate, num_frames)
+        assert lengths[i] == expected.shape[1]
+        np.testing.assert_array_equal(audio[i, :, : lengths[i]], expected)
+        np.testing.assert_array_equal(audio[i, :, lengths[i] :], 0)
+
+
+@pytest.mark.parametrize("sample_rate", [SAMPLE_RATE, 16000])
+def test_load_many_pads_to_longest_file(tmp_path, sample_rate: float):
+    paths = [write_clip(tmp_path, f"clip_{i}.flac", 1, 20000 - 3000 * i) for i in range(4)]
+
+    audio, lengths, errors = load_many(paths, sample_rate, num_channels=1)
+
+    assert errors == [None] * len(paths)
+    assert audio.shape == (len(paths), 1, max(lengths))
+    for i, path in enumerate(paths):
+        expected = load_one(path, sample_rate)
+        assert lengths[i] == expected.shape[1]
+        np.testing.assert_array_equal(audio[i, :, : lengths[i]], expected)
+        np.testing.assert_array_equal(audio[i, :, lengths[i] :], 0)
+
+
+def test_load_many_converts_channels(tmp_path):
+    mono = write_clip(tmp_path, "mono.wav", 1, 1000)
+    stereo = write_clip(tmp_path, "stereo.wav", 2, 1000)
+    surround = write_clip(tmp_path, "surround.wav", 6, 1000)
+
+    audio, _, errors = load_many([mono, stereo, surround], SAMPLE_RATE, num_channels=2)
+    assert errors[0] is None
+    assert errors[1] is None
+    assert "6 channels" in errors[2]
+    np.testing.assert_array_equal(audio[0, 0], load_one(mono, SAMPLE_RATE)[0])
+    np.testing.assert_array_equal(audio[0, 1], load_one(mono, SAMPLE_RATE)[0])
+    np.testing.assert_array_equal(audio[2], 0)
+
+    audio, _, errors = load_many([stereo, surround], SAMPLE_RATE, num_channels=1)
+    assert errors == [None, None]
+    np.testing.assert_allclose(audio[0, 0], load_one(stereo, SAMPLE_RATE).mean(axis=0), atol=1e-6)
+    np.testing.assert_allclose(
+        audio[1, 0], load_one(surround, SAMPLE_RATE).mean(axis=0), atol=1e-6
+    )
+
+
+def test_load_many_reports_errors_per_file(tmp_path):
+    good = write_clip(tmp_path, "good.wav", 1, 1000)
+    missing = os.path.join(str(tmp_path), "missing.wav")
+    not_audio = os.path.join(str(tmp_path), "not_audio.wav")
+    with open(not_audio, "wb") as f:
+        f.write(b"this is not audio")
+
+    audio, lengths, errors = load_many([missing, good, not_audio], SAMPLE_RATE, num_channels=1)
+    assert audio.shape == (3, 1, 1000)
+    assert list(lengths) == [0, 1000, 0]
+    assert errors[0] is not None and "does not exist" in errors[0]
+    assert errors[1] is None
+    assert errors[2] is not None
+    np.testing.assert_array_equal(audio[0], 0)
+    np.testing.assert_array_equal(audio[2], 0)
+
+
+def test_load_many_with_no_paths():
+    audio, lengths, errors = load_many([], SAMPLE_RATE, num_channels=2, duration=1)
+    assert audio.shape == (0, 2, SAMPLE_RATE)
+    assert len(lengths) == 0
+    assert errors == []
+
+
+@pytest.mark.parametrize(
+    "kwargs",
+    [
+        {"sample_rate": 0, "num_channels": 1},
+        {"sample_rate": SAMPLE_RATE, "num_channels": 0},
+        {"sample_rate": SAMPLE_RATE, "num_channels": 1, "duration": -1},
+    ],
+)
+def test_load_many_invalid_arguments(kwargs):
+    with pytest.raises(ValueError):
+        load_many([], **kwargs)
@@ -0,0 +1,156 @@
+#! /usr/bin/env python
+#
+# Copyright 2025 Spotify AB
+#
+# Licensed under the GNU Public License, Version 3.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.gnu.org/licenses/gpl-3.0.html
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import io
+import os
+
+import numpy as np
+import pytest
+
+from pedalboard.io import AudioFile
+
+AUDIO_DIR = os.path.join(os.path.dirname(__file__), "audio", "correct")
+MP3_FILES = [
+    os.path.join(AUDIO_DIR, name)
+    for name in [
+        "mono_sine_at_44100Hz.mp3",
+        "mono_sine_at_48000Hz.mp3",
+        "no_header.mp3",
+        "sample_mono_22050Hz.mp3",
+        "bad_audio_file_lyrics3.mp3",
+    ]
+]
+SEEK_OFFSETS = [0, 1, 1151, 1152, 1153, 5000, 12345, 44100, 100_000]
+
+
+def mp3_without_vbr_header(samplerate: int = 44100, num_frames: int = 44100 * 4) -> io.BytesIO:
+    buf = io.BytesIO()
+    buf.name = "output.mp3"
+    rng = np.random.default_rng(1234)
+    audio = (rng.random((2, num_frames)).astype(np.float32) - 0.5) * 0.5
+    with AudioFile(buf, "w", samplerate, 2, quality=320) as f:
+        f.write(audio)
+    # Skip the VBR header to force the length of the file to be estimated:
+    return io.BytesIO(buf.getvalue()[1044:])
+
+
+@pytest.mark.parametrize("filename", MP3_FILES)
+def test_frame_index_gives_same_audio_on_seek(filename: str):
+    with AudioFile(filename) as f:
+        expected_chunks = {}
+        for offset in SEEK_OFFSETS:
+            if offset < f.frames:
+                f.seek(offset)
+                expected_chunks[offset] = f.read(1000)
+
+    with AudioFile(filename) as f:
+        index = f.build_frame_index()
+        assert isinstance(index, bytes)
+        assert f.exact_duration_known
+        assert f.tell() == 0
+
+        # Seek in reverse order to ensure we never rely on previous scans:
+        for offset, expected in reversed(expected_chunks.items()):
+            f.seek(offset)
+            np.testing.assert_array_equal(f.read(1000), expected)
+
+
+@pytest.mark.parametrize("filename", MP3_FILES)
+def test_frame_index_length_matches_audio(filename: str):
+    with AudioFile(filename) as f:
+        f.build_frame_index()
+        assert f.exact_duration_known
+        audio = f.read(f.frames + 10_000)
+        assert audio.shape[1] == f.frames
+        assert f.exact_duration_known
+
+
+def test_frame_index_makes_estimated_length_exact():
+    buf = mp3_without_vbr_header()
+    with AudioFile(buf) as f:
+        assert not f.exact_duration_known
+        estimated_frames = f.frames
+
+    buf.seek(0)
+    with AudioFile(buf) as f:
+        f.read(1000)
+        f.build_frame_index()
+        assert f.exact_duration_known
+        assert f.tell() == 1000
+        assert abs(f.frames - estimated_frames) < 1152 * 10
+
+        # Reading continues from where it left off, up to the exact end of the file:
+        remaining = f.read(f.frames)
+        assert remaining.shape[1] == f.frames - 1000
+        assert f.tell() == f.frames
+
+
+@pytest.mark.parametrize("filename", MP3_FILES)
+def test_frame_index_round_trip(filename: str):
+    with AudioFile(filename) as f:
+        index = f.build_frame_index()
+        frames = f.frames
+        # Building an index twice should return the same index without rescanning:
+        assert f.build_frame_index() == index
+        f.seek(frames // 2)
+        expected = f.read(2000)
+
+    with AudioFile(filename) as f:
+        f.load_frame_index(index)
+        assert f.exact_duration_known
+        assert f.frames == frames
+        f.seek(frames // 2)
+        np.testing.assert_array_equal(f.read(2000), expected)
+
+
+def test_frame_index_from_file_like():
+    with AudioFile(MP3_FILES[0]) as f:
+        index = f.build_frame_index()
+        expected = f.read(f.frames)
+
+    with open(MP3_FILES[0], "rb") as raw:
+        with AudioFile(io.BytesIO(raw.read())) as f:
+            f.load_frame_index(index)
+            np.testing.assert_array_equal(f.read(f.frames), expected)
+
+
+def test_frame_index_from_different_file_is_rejected():
+    with AudioFile(MP3_FILES[0]) as f:
+        index = f.build_frame_index()
+
+    with AudioFile(MP3_FILES[1]) as f:
+        with pytest.raises(ValueError):
+            f.load_frame_index(index)
+
+
+@pytest.mark.parametrize(
+    "corrupt", [lambda b: b"", lambda b: b[:-1], lambda b: b"X" + b[1:], lambda b: b + b"\0"]
+)
+def test_corrupt_frame_index_is_rejected(corrupt):
+    with AudioFile(MP3_FILES[0]) as f:
+        index = f.build_frame_index()
+
+    with AudioFile(MP3_FILES[0]) as f:
+        with pytest.raises(ValueError):
+            f.load_frame_index(corrupt(index))
+        assert f.read(f.frames).shape[1] == f.frames
+
+
+def test_frame_index_not_supported_for_other_formats():
+    with AudioFile(os.path.join(AUDIO_DIR, "mono_sine_at_44100Hz.wav")) as f:
+        with pytest.raises(ValueError):
+            f.build_frame_index()
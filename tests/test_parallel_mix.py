@@ -0,0 +1,100 @@
+#! /usr/bin/env python
+#
+# Copyright 2025 Spotify AB
+#
+# Licensed under the GNU Public License, Version 3.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.gnu.org/licenses/gpl-3.0.html
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import numpy as np
+import pytest
+
+from pedalboard import Chain, Chorus, Delay, Gain, Mix, Pedalboard, PitchShift, Reverb
+from pedalboard_native._internal import AddLatency  # type: ignore
+
+SAMPLE_RATE = 44100
+
+
+def make_audio(num_channels: int = 2, num_samples: int = SAMPLE_RATE):
+    rng = np.random.default_rng(0)
+    return rng.random((num_channels, num_samples)).astype(np.float32) - 0.5
+
+
+def make_branches(num_branches: int):
+    return [
+        Chain([Gain(-i), Delay(delay_seconds=0.01 * (i + 1)), Reverb(room_size=0.1 * i)])
+        for i in range(num_branches)
+    ]
+
+
+def test_parallel_defaults_to_false():
+    mix = Mix([Gain(), Gain()])
+    assert not mix.parallel
+    mix.parallel = True
+    assert mix.parallel
+    assert "parallel=True" in repr(mix)
+
+
+@pytest.mark.parametrize("num_branches", [1, 2, 3, 8])
+@pytest.mark.parametrize("buffer_size", [128, 8192])
+def test_parallel_mix_matches_sequential_mix(num_branches: int, buffer_size: int):
+    audio = make_audio()
+    expected = Mix(make_branches(num_branches))(audio, SAMPLE_RATE, buffer_size=buffer_size)
+    actual = Mix(make_branches(num_branches), parallel=True)(
+        audio, SAMPLE_RATE, buffer_size=buffer_size
+    )
+    np.testing.assert_allclose(actual, expected, atol=1e-6)
+
+
+@pytest.mark.parametrize("buffer_size", [128, 1000, 8192])
+def test_parallel_mix_latency_compensation(buffer_size: int):
+    audio = make_audio()
+    mix = Mix([AddLatency(100), AddLatency(1000), Gain(0)], parallel=True)
+    output = mix(audio, SAMPLE_RATE, buffer_size=buffer_size)
+    np.testing.assert_allclose(output, audio * 3, atol=1e-5)
+
+
+def test_parallel_mix_with_non_clonable_plugins():
+    audio = make_audio(num_channels=1)
+    branches = [PitchShift(semitones=3), Chain([Chorus(), PitchShift(semitones=-3)])]
+    expected = Mix(branches)(audio, SAMPLE_RATE)
+    actual = Mix(branches, parallel=True)(audio, SAMPLE_RATE)
+    np.testing.assert_allclose(actual, expected, atol=1e-6)
+
+
+def test_nested_parallel_mixes():
+    audio = make_audio()
+    expected = Pedalboard([Mix([Mix(make_branches(3)), Mix(make_branches(2))])])(
+        audio, SAMPLE_RATE
+    )
+    actual = Pedalboard(
+        [Mix([Mix(make_branches(3), parallel=True), Mix(make_branches(2))], parallel=True)]
+    )(audio, SAMPLE_RATE)
+    np.testing.assert_allclose(actual, expected, atol=1e-6)
+
+
+def test_parallel_mix_is_profiled():
+    mix = Mix(make_branches(4), parallel=True)
+    mix(make_audio(), SAMPLE_RATE, profile=True)
+    entries = mix.last_profile.entries
+    assert entries[0].name == "Mix"
+    assert sorted(e.name for e in entries if e.depth == 1) == ["Chain"] * 4
+    for entry in entries[1:]:
+        assert entry.parent is not None
+        assert entry.samples_processed == SAMPLE_RATE
+
+
+def test_parallel_mix_in_batch():
+    mix = Mix(make_branches(3), parallel=True)
+    clips = [make_audio(num_samples=SAMPLE_RATE // 4) for _ in range(4)]
+    for clip, output in zip(clips, mix.process_batch(clips, SAMPLE_RATE, num_threads=2)):
+        np.testing.assert_allclose(output, mix(clip, SAMPLE_RATE), atol=1e-6)
@@ -0,0 +1,118 @@
+#! /usr/bin/env python
+#
+# Copyright 2025 Spotify AB
+#
+# Licensed under the GNU Public License, Version 3.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.gnu.org/licenses/gpl-3.0.html
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import io
+import os
+
+import numpy as np
+import pytest
+
+from pedalboard.io import AudioFile
+
+SAMPLE_RATE = 44100
+NUM_FRAMES = 400_000
+
+
+def write_test_file(tmp_path, extension: str, num_channels: int, bit_depth: int) -> str:
+    rng = np.random.default_rng(42)
+    audio = (rng.random((num_channels, NUM_FRAMES)).astype(np.float32) - 0.5) * 1.5
+    filename = os.path.join(str(tmp_path), f"test_{bit_depth}.{extension}")
+    with AudioFile(filename, "w", SAMPLE_RATE, num_channels, bit_depth=bit_depth) as f:
+        f.write(audio)
+    return filename
+
+
+@pytest.mark.parametrize(
+    "extension,bit_depth",
+    [("wav", 16), ("wav", 24), ("wav", 32), ("aiff", 16), ("aiff", 24), ("flac", 16), ("flac", 24)],
+)
+@pytest.mark.parametrize("num_channels", [1, 2])
+@pytest.mark.parametrize("num_threads", [2, 3, 8])
+def test_parallel_read_matches_serial_read(
+    tmp_path, extension: str, bit_depth: int, num_channels: int, num_threads: int
+):
+    filename = write_test_file(tmp_path, extension, num_channels, bit_depth)
+    with AudioFile(filename) as f:
+        expected = f.read(f.frames)
+
+    with AudioFile(filename) as f:
+        actual = f.read(f.frames, num_threads=num_threads)
+        assert f.tell() == f.frames
+        assert f.read(1).shape == (num_channels, 0)
+
+    np.testing.assert_array_equal(actual, expected)
+
+
+@pytest.mark.parametrize("extension", ["wav", "flac"])
+def test_parallel_read_from_middle_of_file(tmp_path, extension: str):
+    filename = write_test_file(tmp_path, extension, 2, 16)
+    with AudioFile(filename) as f:
+        expected = f.read(f.frames)
+
+    with AudioFile(filename) as f:
+        f.seek(12345)
+        actual = f.read(300_000, num_threads=4)
+        np.testing.assert_array_equal(actual, expected[:, 12345:312345])
+
+        # The file should be left positioned to continue reading serially:
+        assert f.tell() == 312345
+        np.testing.assert_array_equal(f.read(1000), expected[:, 312345:313345])
+
+        # Reads past the end of the file should be truncated as usual:
+        np.testing.assert_array_equal(f.read(NUM_FRAMES, num_threads=4), expected[:, 313345:])
+
+
+def test_parallel_read_with_prefetch(tmp_path):
+    filename = write_test_file(tmp_path, "flac", 2, 16)
+    with AudioFile(filename) as f:
+        expected = f.read(f.frames)
+
+    with AudioFile(filename, prefetch=2) as f:
+        np.testing.assert_array_equal(f.read(1000), expected[:, :1000])
+        np.testing.assert_array_equal(f.read(300_000, num_threads=4), expected[:, 1000:301000])
+        np.testing.assert_array_equal(f.read(f.frames), expected[:, 301000:])
+
+
+def test_parallel_read_falls_back_for_file_like_objects(tmp_path):
+    filename = write_test_file(tmp_path, "wav", 2, 16)
+    with AudioFile(filename) as f:
+        expected = f.read(f.frames)
+
+    with open(filename, "rb") as raw:
+        with AudioFile(io.BytesIO(raw.read())) as f:
+            np.testing.assert_array_equal(f.read(f.frames, num_threads=4), expected)
+
+
+def test_parallel_read_falls_back_for_mp3():
+    filename = os.path.join(
+        os.path.dirname(__file__), "audio", "correct", "mono_sine_at_44100Hz.mp3"
+    )
+    with AudioFile(filename) as f:
+        expected = f.read(f.frames)
+
+    with AudioFile(filename) as f:
+        np.testing.assert_array_equal(f.read(f.frames, num_threads=4), expected)
+
+
+@pytest.mark.parametrize("num_threads", [0, -1])
+def test_invalid_num_threads(num_threads: int):
+    filename = os.path.join(
+        os.path.dirname(__file__), "audio", "correct", "mono_sine_at_44100Hz.wav"
+    )
+    with AudioFile(filename) as f:
+        with pytest.raises(ValueError):
+            f.read(100, num_threads=num_threads)
@@ -0,0 +1,130 @@
+#! /usr/bin/env python
+#
+# Copyright 2025 Spotify AB
+#
+# Licensed under the GNU Public License, Version 3.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.gnu.org/licenses/gpl-3.0.html
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import numpy as np
+import pytest
+
+from pedalboard import (
+    Chain,
+    Chorus,
+    Compressor,
+    Delay,
+    Distortion,
+    Gain,
+    Mix,
+    Pedalboard,
+    Reverb,
+)
+from pedalboard_native._internal import AddLatency  # type: ignore
+
+SAMPLE_RATE = 44100
+
+
+def make_audio(shape=(2, SAMPLE_RATE)):
+    return np.random.default_rng(0).random(shape).astype(np.float32) - 0.5
+
+
+def make_plugins():
+    return [
+        Gain(-3),
+        Chorus(),
+        Compressor(threshold_db=-12),
+        Mix([Delay(delay_seconds=0.01), Distortion()]),
+        Chain([Gain(1), Reverb(room_size=0.3)]),
+    ]
+
+
+def test_pipelined_defaults_to_false():
+    assert not Pedalboard([Gain()]).pipelined
+    assert not Chain([Gain()]).pipelined
+
+    chain = Chain([Gain()], pipelined=True)
+    assert chain.pipelined
+    assert "pipelined=True" in repr(chain)
+    chain.pipelined = False
+    assert not chain.pipelined
+
+
+@pytest.mark.parametrize("buffer_size", [16, 128, 1000, 8192, SAMPLE_RATE * 2])
+@pytest.mark.parametrize("shape", [(SAMPLE_RATE,), (2, SAMPLE_RATE), (SAMPLE_RATE, 2)])
+def test_pipelined_output_matches_serial_output(buffer_size: int, shape):
+    audio = make_audio(shape)
+    expected = Pedalboard(make_plugins())(audio, SAMPLE_RATE, buffer_size=buffer_size)
+    actual = Pedalboard(make_plugins(), pipelined=True)(audio, SAMPLE_RATE, buffer_size=buffer_size)
+    assert actual.shape == expected.shape
+    np.testing.assert_allclose(actual, expected, atol=1e-5)
+
+
+@pytest.mark.parametrize("buffer_size", [128, 1000, 8192])
+@pytest.mark.parametrize("latencies", [[100], [0, 1000], [1000, 37, 0, 5000], [20000, 20000]])
+@pytest.mark.parametrize("reset", [True, False])
+def test_pipelined_latency_compensation(buffer_size: int, latencies, reset: bool):
+    audio = make_audio()
+    expected = Chain([AddLatency(latency) for latency in latencies])(
+        audio, SAMPLE_RATE, buffer_size=buffer_size, reset=reset
+    )
+    actual = Chain([AddLatency(latency) for latency in latencies], pipelined=True)(
+        audio, SAMPLE_RATE, buffer_size=buffer_size, reset=reset
+    )
+    assert actual.shape == expected.shape
+    np.testing.assert_allclose(actual, expected)
+    if reset:
+        np.testing.assert_allclose(actual, audio)
+
+
+def test_pipelined_streaming_matches_serial_streaming():
+    audio = make_audio((2, SAMPLE_RATE * 2))
+    serial = Pedalboard([AddLatency(1000), Gain(-3), Reverb()])
+    pipelined = Pedalboard([AddLatency(1000), Gain(-3), Reverb()], pipelined=True)
+    for chunk in np.split(audio, 4, axis=1):
+        np.testing.assert_allclose(
+            pipelined(chunk, SAMPLE_RATE, reset=False),
+            serial(chunk, SAMPLE_RATE, reset=False),
+            atol=1e-6,
+        )
+
+
+def test_pipelined_with_none_and_empty_chains():
+    audio = make_audio()
+    np.testing.assert_allclose(Chain([], pipelined=True)(audio, SAMPLE_RATE), audio)
+    np.testing.assert_allclose(
+        Chain([None, Gain(0), None], pipelined=True)(audio, SAMPLE_RATE), audio, atol=1e-6
+    )
+
+
+def test_pipelined_into_output_array():
+    audio = make_audio()
+    expected = Pedalboard(make_plugins())(audio, SAMPLE_RATE)
+    result = Pedalboard(make_plugins(), pipelined=True)(audio, SAMPLE_RATE, inplace=True)
+    assert np.shares_memory(result, audio)
+    np.testing.assert_allclose(audio, expected, atol=1e-5)
+
+
+def test_pipelined_chain_is_not_pipelined_when_nested():
+    # Nested chains receive one block at a time, so are processed as usual:
+    audio = make_audio()
+    expected = Pedalboard([Gain(-3), Chain(make_plugins())])(audio, SAMPLE_RATE)
+    actual = Pedalboard([Gain(-3), Chain(make_plugins(), pipelined=True)])(audio, SAMPLE_RATE)
+    np.testing.assert_allclose(actual, expected, atol=1e-6)
+
+
+def test_pipelined_profile_includes_each_stage():
+    board = Pedalboard(make_plugins(), pipelined=True)
+    board(make_audio(), SAMPLE_RATE, profile=True)
+    # Each stage runs on its own thread, so may appear in any order:
+    top_level = sorted(e.name for e in board.last_profile.entries if e.depth == 0)
+    assert top_level == ["Chain", "Chorus", "Compressor", "Gain", "Mix"]
@@ -0,0 +1,93 @@
+#! /usr/bin/env python
+#
+# Copyright 2025 Spotify AB
+#
+# Licensed under the GNU Public License, Version 3.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.gnu.org/licenses/gpl-3.0.html
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import numpy as np
+import pytest
+
+from pedalboard import Resample
+from pedalboard.io import StreamResampler
+
+POLYPHASE_QUALITIES = [
+    Resample.Quality.WindowedSinc256,
+    Resample.Quality.WindowedSinc128,
+    Resample.Quality.WindowedSinc64,
+    Resample.Quality.WindowedSinc32,
+    Resample.Quality.WindowedSinc16,
+    Resample.Quality.WindowedSinc8,
+]
+
+# Pairs of integer sample rates (which use a polyphase filter bank) and
+# non-integer sample rates with exactly the same ratio (which don't):
+EQUIVALENT_SAMPLE_RATES = [
+    ((44100, 48000), (73.5, 80)),
+    ((48000, 44100), (80, 73.5)),
+    ((44100, 16000), (110.25, 40)),
+    ((48000, 16000), (1.5, 0.5)),
+    ((22050, 44100), (0.5, 1)),
+    ((11025, 44100), (0.25, 1)),
+]
+
+
+@pytest.mark.parametrize(
+    "polyphase_rates,reference_rates",
+    EQUIVALENT_SAMPLE_RATES,
+    ids=[f"{a}-{b}" for (a, b), _ in EQUIVALENT_SAMPLE_RATES],
+)
+@pytest.mark.parametrize("chunk_size", [1, 1000, 100_000])
+@pytest.mark.parametrize("quality", POLYPHASE_QUALITIES, ids=[q.name for q in POLYPHASE_QUALITIES])
+def test_stream_resampler_polyphase_matches_interpolator(
+    polyphase_rates, reference_rates, chunk_size: int, quality
+):
+    signal = np.random.default_rng(1234).uniform(-1, 1, (2, 100_000)).astype(np.float32)
+
+    outputs = []
+    for source_sample_rate, target_sample_rate in (polyphase_rates, reference_rates):
+        resampler = StreamResampler(source_sample_rate, target_sample_rate, 2, quality)
+        chunks = [
+            resampler.process(signal[:, i : i + chunk_size])
+            for i in range(0, signal.shape[1], chunk_size)
+        ]
+        chunks.append(resampler.process())
+        outputs.append(np.concatenate(chunks, axis=1))
+
+    polyphase, reference = outputs
+    assert polyphase.shape == reference.shape
+    # The only difference should be the accumulation of floating-point error in
+    # the reference interpolator's sub-sample position:
+    np.testing.assert_allclose(polyphase, reference, atol=1e-5)
+
+
+@pytest.mark.parametrize(
+    "polyphase_rates,reference_rates",
+    EQUIVALENT_SAMPLE_RATES,
+    ids=[f"{a}-{b}" for (a, b), _ in EQUIVALENT_SAMPLE_RATES],
+)
+@pytest.mark.parametrize("quality", POLYPHASE_QUALITIES, ids=[q.name for q in POLYPHASE_QUALITIES])
+def test_resample_plugin_polyphase_matches_interpolator(
+    polyphase_rates, reference_rates, quality
+):
+    signal = np.random.default_rng(1234).uniform(-1, 1, (2, 100_000)).astype(np.float32)
+
+    (polyphase_sample_rate, polyphase_target), (reference_sample_rate, reference_target) = (
+        polyphase_rates,
+        reference_rates,
+    )
+    polyphase = Resample(polyphase_target, quality)(signal, polyphase_sample_rate)
+    reference = Resample(reference_target, quality)(signal, reference_sample_rate)
+
+    assert polyphase.shape == reference.shape
+    np.testing.assert_allclose(polyphase, reference, atol=1e-5)
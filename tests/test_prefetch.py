@@ -0,0 +1,139 @@
+#! /usr/bin/env python
+#
+# Copyright 2025 Spotify AB
+#
+# Licensed under the GNU Public License, Version 3.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.gnu.org/licenses/gpl-3.0.html
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import glob
+import io
+import os
+
+import numpy as np
+import pytest
+
+from pedalboard import Gain, Pedalboard
+from pedalboard.io import AudioFile, ReadableAudioFile, get_supported_read_formats
+
+TEST_AUDIO_FILES = [
+    filename
+    for filename in glob.glob(os.path.join(os.path.dirname(__file__), "audio", "correct", "*"))
+    if any(filename.endswith(extension) for extension in get_supported_read_formats())
+]
+
+
+def read_in_chunks(f, chunk_size: int) -> np.ndarray:
+    chunks = []
+    while True:
+        chunk = f.read(chunk_size)
+        chunks.append(chunk)
+        if chunk.shape[1] < chunk_size:
+            break
+    return np.concatenate(chunks, axis=1)
+
+
+@pytest.mark.parametrize("filename", TEST_AUDIO_FILES)
+@pytest.mark.parametrize("prefetch", [1, 4])
+@pytest.mark.parametrize("chunk_size", [1000, 44100])
+def test_prefetched_reads_match_synchronous_reads(filename: str, prefetch: int, chunk_size: int):
+    with AudioFile(filename) as f:
+        expected = read_in_chunks(f, chunk_size)
+        expected_frames = f.frames
+        expected_exact_duration_known = f.exact_duration_known
+
+    with AudioFile(filename, prefetch=prefetch) as f:
+        assert f.prefetch == prefetch
+        actual = read_in_chunks(f, chunk_size)
+        assert f.tell() == actual.shape[1]
+        assert f.frames == expected_frames
+        assert f.exact_duration_known == expected_exact_duration_known
+
+    np.testing.assert_array_equal(actual, expected)
+
+
+@pytest.mark.parametrize("filename", TEST_AUDIO_FILES[:4])
+def test_seek_discards_prefetched_audio(filename: str):
+    with AudioFile(filename) as f:
+        expected = f.read(f.frames)
+
+    with AudioFile(filename, "r", prefetch=2) as f:
+        np.testing.assert_array_equal(f.read(100), expected[:, :100])
+
+        f.seek(1000)
+        np.testing.assert_array_equal(f.read(100), expected[:, 1000:1100])
+
+        # Seeking to the current position should not change anything:
+        f.seek(f.tell())
+        np.testing.assert_array_equal(f.read(100), expected[:, 1100:1200])
+
+        f.seek(0)
+        np.testing.assert_array_equal(f.read(f.frames), expected)
+
+
+def test_prefetch_with_read_raw():
+    filename = [f for f in TEST_AUDIO_FILES if f.endswith(".wav")][0]
+    with AudioFile(filename) as f:
+        expected = f.read_raw(f.frames)
+
+    with AudioFile(filename, prefetch=2) as f:
+        first = f.read(100)
+        assert first.shape[1] == 100
+        np.testing.assert_array_equal(f.read_raw(100), expected[:, 100:200])
+        np.testing.assert_array_equal(f.read_raw(f.frames), expected[:, 200:])
+
+
+def test_prefetch_with_resampling():
+    filename = [f for f in TEST_AUDIO_FILES if f.endswith(".wav")][0]
+    with AudioFile(filename).resampled_to(22050) as f:
+        expected = f.read(f.frames)
+
+    with AudioFile(filename, prefetch=3).resampled_to(22050) as f:
+        np.testing.assert_array_equal(read_in_chunks(f, 1234), expected)
+
+
+def test_prefetch_while_processing():
+    filename = TEST_AUDIO_FILES[0]
+    board = Pedalboard([Gain(-6)])
+    with AudioFile(filename) as f:
+        expected = board(f.read(f.frames), f.samplerate)
+
+    outputs = []
+    with AudioFile(filename, prefetch=4) as f:
+        while f.tell() < f.frames:
+            outputs.append(board(f.read(4096), f.samplerate, reset=False))
+    np.testing.assert_allclose(np.concatenate(outputs, axis=1), expected, atol=1e-6)
+
+
+def test_close_while_prefetching():
+    f = AudioFile(TEST_AUDIO_FILES[0], prefetch=8)
+    f.read(10)
+    f.close()
+    assert f.closed
+    with pytest.raises(RuntimeError):
+        f.read(10)
+
+
+def test_prefetch_defaults_to_zero():
+    with ReadableAudioFile(TEST_AUDIO_FILES[0]) as f:
+        assert f.prefetch == 0
+
+
+def test_negative_prefetch_is_an_error():
+    with pytest.raises(ValueError):
+        AudioFile(TEST_AUDIO_FILES[0], prefetch=-1)
+
+
+def test_prefetch_is_not_supported_for_file_like_objects():
+    with open(TEST_AUDIO_FILES[0], "rb") as f:
+        with pytest.raises(TypeError):
+            AudioFile(io.BytesIO(f.read()), prefetch=2)
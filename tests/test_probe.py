@@ -0,0 +1,82 @@
+#! /usr/bin/env python
+#
+# Copyright 2025 Spotify AB
+#
+# Licensed under the GNU Public License, Version 3.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.gnu.org/licenses/gpl-3.0.html
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import os
+
+import numpy as np
+import pytest
+
+from pedalboard.io import AudioFile, probe
+
+
+def write_clip(tmp_path, name: str, samplerate: float, num_channels: int, num_frames: int) -> str:
+    audio = np.zeros((num_channels, num_frames), dtype=np.float32)
+    filename = os.path.join(str(tmp_path), name)
+    with AudioFile(filename, "w", samplerate, num_channels) as f:
+        f.write(audio)
+    return filename
+
+
+@pytest.mark.parametrize("num_threads", [0, 1, 3])
+def test_probe_matches_audio_file(tmp_path, num_threads: int):
+    paths = [
+        write_clip(tmp_path, "a.wav", 44100, 2, 12345),
+        write_clip(tmp_path, "b.flac", 48000, 1, 4800),
+        write_clip(tmp_path, "c.aiff", 22050, 6, 100),
+        write_clip(tmp_path, "d.mp3", 32000, 2, 32000),
+        write_clip(tmp_path, "e.wav", 8000, 1, 0),
+    ]
+
+    info = probe(paths, num_threads=num_threads)
+    assert info["errors"] == [None] * len(paths)
+
+    for i, path in enumerate(paths):
+        with AudioFile(path) as f:
+            assert info["samplerate"][i] == f.samplerate
+            assert info["num_channels"][i] == f.num_channels
+            assert info["frames"][i] == f.frames
+            assert info["exact_duration_known"][i] == f.exact_duration_known
+    assert info["format"][0] == "WAV file"
+    assert info["format"][1] == "FLAC file"
+
+    assert info["samplerate"].dtype == np.float64
+    assert info["num_channels"].dtype == np.int64
+    assert info["frames"].dtype == np.int64
+    assert info["exact_duration_known"].dtype == bool
+
+
+def test_probe_reports_errors(tmp_path):
+    good = write_clip(tmp_path, "good.wav", 44100, 1, 441)
+    not_audio = os.path.join(str(tmp_path), "not_audio.wav")
+    with open(not_audio, "wb") as f:
+        f.write(b"this is not audio")
+    missing = os.path.join(str(tmp_path), "missing.wav")
+
+    info = probe([not_audio, good, missing])
+    assert info["errors"][0] is not None
+    assert info["errors"][1] is None
+    assert "does not exist" in info["errors"][2]
+
+    np.testing.assert_array_equal(info["frames"], [0, 441, 0])
+    np.testing.assert_array_equal(info["samplerate"], [0, 44100, 0])
+    assert info["format"] == [None, "WAV file", None]
+
+
+def test_probe_empty_list():
+    info = probe([])
+    assert len(info["frames"]) == 0
+    assert info["errors"] == []
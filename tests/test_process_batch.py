@@ -0,0 +1,154 @@
+#! /usr/bin/env python
+#
+# Copyright 2025 Spotify AB
+#
+# Licensed under the GNU Public License, Version 3.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.gnu.org/licenses/gpl-3.0.html
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import numpy as np
+import pytest
+
+from pedalboard import (
+    Bitcrush,
+    Chorus,
+    Compressor,
+    Delay,
+    Distortion,
+    Gain,
+    HighShelfFilter,
+    LadderFilter,
+    Mix,
+    Pedalboard,
+    Phaser,
+    PitchShift,
+    Reverb,
+    process_batch,
+)
+from pedalboard_native._internal import AddLatency  # type: ignore
+
+SAMPLE_RATE = 44100
+
+
+def make_clips(num_clips: int, num_channels: int = 2, seed: int = 0):
+    rng = np.random.default_rng(seed)
+    return [
+        rng.random((num_channels, SAMPLE_RATE // 4 + (i * 1000))).astype(np.float32) - 0.5
+        for i in range(num_clips)
+    ]
+
+
+def make_board():
+    return Pedalboard(
+        [
+            Gain(-3),
+            Chorus(),
+            Compressor(threshold_db=-12),
+            LadderFilter(cutoff_hz=800),
+            Mix([Delay(delay_seconds=0.01), Phaser(), Bitcrush(bit_depth=12)]),
+            HighShelfFilter(cutoff_frequency_hz=2000, gain_db=3),
+            Distortion(),
+            Reverb(room_size=0.6),
+        ]
+    )
+
+
+@pytest.mark.parametrize("num_threads", [0, 1, 2, 7])
+def test_batch_matches_individual_processing(num_threads: int):
+    board = make_board()
+    clips = make_clips(10)
+
+    expected = [board(clip, SAMPLE_RATE) for clip in clips]
+    actual = board.process_batch(clips, SAMPLE_RATE, num_threads=num_threads)
+
+    assert isinstance(actual, list)
+    assert len(actual) == len(expected)
+    for a, e in zip(actual, expected):
+        assert a.shape == e.shape
+        np.testing.assert_allclose(a, e, atol=1e-6)
+
+
+@pytest.mark.parametrize("transpose", [False, True])
+def test_batch_of_stacked_array_returns_stacked_array(transpose: bool):
+    board = make_board()
+    rng = np.random.default_rng(1)
+    batch = rng.random((6, 2, SAMPLE_RATE // 4)).astype(np.float32) - 0.5
+    if transpose:
+        batch = np.ascontiguousarray(np.transpose(batch, (0, 2, 1)))
+
+    actual = board.process_batch(batch, SAMPLE_RATE)
+
+    assert isinstance(actual, np.ndarray)
+    assert actual.shape == batch.shape
+    for clip, output in zip(batch, actual):
+        np.testing.assert_allclose(output, board(clip, SAMPLE_RATE), atol=1e-6)
+
+
+def test_batch_with_different_lengths_and_channel_counts():
+    clips = [
+        np.random.rand(44100).astype(np.float32),
+        np.random.rand(1, 22050).astype(np.float32),
+        np.random.rand(3, 1000).astype(np.float64),
+        np.random.rand(5000, 2).astype(np.float32),
+    ]
+    board = Pedalboard([Gain(-6), Reverb()])
+
+    outputs = board.process_batch(clips, SAMPLE_RATE, num_threads=3)
+    for clip, output in zip(clips, outputs):
+        assert output.shape == clip.shape
+        assert output.dtype == np.float32
+        np.testing.assert_allclose(output, board(clip, SAMPLE_RATE), atol=1e-6)
+
+
+@pytest.mark.parametrize("plugin", [AddLatency(1000), PitchShift(semitones=2)])
+def test_batch_with_non_clonable_plugins(plugin):
+    # These plugins can't be copied, so the batch should be processed on one thread:
+    board = Pedalboard([Gain(-3), plugin])
+    clips = make_clips(4, num_channels=1)
+
+    actual = board.process_batch(clips, SAMPLE_RATE, num_threads=4)
+    for clip, output in zip(clips, actual):
+        np.testing.assert_allclose(output, board(clip, SAMPLE_RATE), atol=1e-6)
+
+
+def test_module_level_process_batch():
+    plugins = [Gain(-3), Reverb()]
+    clips = make_clips(3)
+    outputs = process_batch(clips, SAMPLE_RATE, plugins)
+    for clip, output in zip(clips, outputs):
+        np.testing.assert_allclose(output, Pedalboard(plugins)(clip, SAMPLE_RATE), atol=1e-6)
+
+
+def test_batch_does_not_share_state_between_clips():
+    # A long delay would carry audio from one clip into the next if state was shared:
+    delay = Delay(delay_seconds=0.1, mix=1.0)
+    impulse = np.zeros((1, SAMPLE_RATE // 2), dtype=np.float32)
+    impulse[0, 0] = 1.0
+    silence = np.zeros_like(impulse)
+
+    outputs = delay.process_batch([impulse, silence] * 4, SAMPLE_RATE, num_threads=2)
+    for output in outputs[1::2]:
+        assert np.amax(np.abs(output)) == 0
+
+
+def test_batch_with_empty_input():
+    assert Gain(-3).process_batch([], SAMPLE_RATE) == []
+
+
+def test_batch_rejects_non_array_items():
+    with pytest.raises(TypeError):
+        Gain(-3).process_batch(["not audio"], SAMPLE_RATE)
+
+
+def test_batch_rejects_two_dimensional_array():
+    with pytest.raises(ValueError):
+        Gain(-3).process_batch(np.zeros((2, 1000), dtype=np.float32), SAMPLE_RATE)
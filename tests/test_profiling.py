@@ -0,0 +1,142 @@
+#! /usr/bin/env python
+#
+# Copyright 2025 Spotify AB
+#
+# Licensed under the GNU Public License, Version 3.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.gnu.org/licenses/gpl-3.0.html
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import json
+
+import numpy as np
+import pytest
+
+from pedalboard import Chain, Delay, Gain, Mix, Pedalboard, Profile, Reverb
+
+SAMPLE_RATE = 44100
+
+
+def make_audio(num_samples: int = SAMPLE_RATE):
+    return np.random.default_rng(0).random((2, num_samples)).astype(np.float32) - 0.5
+
+
+def make_board():
+    return Pedalboard([Gain(-6), Mix([Chain([Delay(), Gain(3)]), Reverb()])])
+
+
+def test_last_profile_is_none_by_default():
+    board = make_board()
+    assert board.last_profile is None
+    board(make_audio(), SAMPLE_RATE)
+    assert board.last_profile is None
+
+
+def test_profile_does_not_change_output():
+    board = make_board()
+    audio = make_audio()
+    np.testing.assert_allclose(
+        board(audio, SAMPLE_RATE), board(audio, SAMPLE_RATE, profile=True), atol=1e-6
+    )
+
+
+def test_profile_entries_follow_plugin_hierarchy():
+    board = make_board()
+    board(make_audio(), SAMPLE_RATE, profile=True)
+
+    profile = board.last_profile
+    assert isinstance(profile, Profile)
+    assert profile.sample_rate == SAMPLE_RATE
+
+    entries = profile.entries
+    assert [(e.name, e.depth) for e in entries] == [
+        ("Pedalboard", 0),
+        ("Gain", 1),
+        ("Mix", 1),
+        ("Chain", 2),
+        ("Delay", 3),
+        ("Gain", 3),
+        ("Reverb", 2),
+    ]
+    assert entries[0].parent is None
+    assert entries[0].plugin is board
+    assert entries[1].plugin is board[0]
+    assert entries[4].parent.name == "Chain"
+    assert entries[4].parent.parent.name == "Mix"
+
+
+@pytest.mark.parametrize("buffer_size", [128, 1000, 8192])
+def test_profile_counts_samples_and_calls(buffer_size: int):
+    num_samples = SAMPLE_RATE
+    board = make_board()
+    board(make_audio(num_samples), SAMPLE_RATE, buffer_size=buffer_size, profile=True)
+
+    expected_calls = int(np.ceil(num_samples / buffer_size))
+    for entry in board.last_profile.entries:
+        assert entry.samples_processed == num_samples
+        assert entry.num_calls == expected_calls
+
+
+def test_profile_times_are_consistent():
+    board = make_board()
+    board(make_audio(), SAMPLE_RATE, profile=True)
+
+    profile = board.last_profile
+    for entry in profile.entries:
+        assert entry.wall_time > 0
+        assert 0 <= entry.self_time <= entry.wall_time
+        assert entry.realtime_factor > 0
+        assert entry.wall_time <= profile.wall_time
+
+    root = profile.entries[0]
+    children = [e for e in profile.entries if e.depth == 1]
+    assert root.self_time == pytest.approx(
+        root.wall_time - sum(e.wall_time for e in children), abs=1e-6
+    )
+
+
+def test_profile_is_replaced_on_each_profiled_call():
+    board = make_board()
+    board(make_audio(), SAMPLE_RATE, profile=True)
+    first_profile = board.last_profile
+
+    board(make_audio(), SAMPLE_RATE)
+    assert board.last_profile is first_profile
+
+    board(make_audio(), SAMPLE_RATE, profile=True)
+    assert board.last_profile is not first_profile
+
+
+def test_chrome_trace_export():
+    board = make_board()
+    board(make_audio(), SAMPLE_RATE, buffer_size=4096, profile=True)
+
+    trace = json.loads(board.last_profile.to_chrome_trace())
+    events = trace["traceEvents"]
+    assert len(events) == sum(e.num_calls for e in board.last_profile.entries)
+    assert {e["name"] for e in events} == {"Pedalboard", "Gain", "Mix", "Chain", "Delay", "Reverb"}
+    for event in events:
+        assert event["ph"] == "X"
+        assert event["dur"] >= 0
+
+
+def test_profile_cannot_be_constructed_directly():
+    with pytest.raises(TypeError):
+        Profile()
+
+
+def test_profile_classes_are_exported_from_pedalboard():
+    import pedalboard
+
+    board = make_board()
+    board(make_audio(), SAMPLE_RATE, profile=True)
+    assert isinstance(board.last_profile, pedalboard.Profile)
+    assert all(isinstance(entry, pedalboard.ProfileEntry) for entry in board.last_profile.entries)
@@ -0,0 +1,150 @@
+#! /usr/bin/env python
+#
+# Copyright 2025 Spotify AB
+#
+# Licensed under the GNU Public License, Version 3.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.gnu.org/licenses/gpl-3.0.html
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import os
+
+import numpy as np
+import pytest
+
+from pedalboard.io import AudioFile
+
+SAMPLE_RATE = 44100
+NUM_FRAMES = 50_000
+
+
+def write_test_file(tmp_path, extension: str, num_channels: int = 2, bit_depth: int = 16) -> str:
+    rng = np.random.default_rng(42)
+    audio = (rng.random((num_channels, NUM_FRAMES)).astype(np.float32) - 0.5) * 0.5
+    filename = os.path.join(str(tmp_path), f"test.{extension}")
+    with AudioFile(filename, "w", SAMPLE_RATE, num_channels, bit_depth=bit_depth) as f:
+        f.write(audio)
+    return filename
+
+
+@pytest.mark.parametrize("extension", ["wav", "flac", "mp3"])
+@pytest.mark.parametrize("num_channels", [1, 2])
+@pytest.mark.parametrize("chunk_size", [1000, 7777])
+def test_read_into_matches_read(tmp_path, extension: str, num_channels: int, chunk_size: int):
+    filename = write_test_file(tmp_path, extension, num_channels)
+    with AudioFile(filename) as f:
+        expected = f.read(f.frames)
+
+    with AudioFile(filename) as f:
+        buffer = np.full((num_channels, chunk_size), np.nan, dtype=np.float32)
+        chunks = []
+        while f.tell() < f.frames:
+            frames_read = f.read_into(buffer)
+            assert frames_read > 0
+            assert f.tell() == sum(c.shape[1] for c in chunks) + frames_read
+            # Frames past the end of the file should be zeroed:
+            np.testing.assert_array_equal(buffer[:, frames_read:], 0)
+            chunks.append(buffer[:, :frames_read].copy())
+        assert f.read_into(buffer) == 0
+    np.testing.assert_array_equal(np.concatenate(chunks, axis=1), expected)
+
+
+def test_read_into_offset(tmp_path):
+    filename = write_test_file(tmp_path, "wav")
+    with AudioFile(filename) as f:
+        expected = f.read(1000)
+
+    with AudioFile(filename) as f:
+        buffer = np.full((2, 1500), -1, dtype=np.float32)
+        assert f.read_into(buffer, offset=500) == 1000
+        np.testing.assert_array_equal(buffer[:, :500], -1)
+        np.testing.assert_array_equal(buffer[:, 500:], expected)
+        assert f.read_into(buffer, offset=1500) == 0
+
+
+@pytest.mark.parametrize("bit_depth,dtype", [(16, np.int16), (16, np.int32), (32, np.int32)])
+def test_read_into_raw(tmp_path, bit_depth: int, dtype):
+    # Write integer samples to ensure the file contains integer (not float) data:
+    rng = np.random.default_rng(42)
+    audio = rng.integers(-(2**15), 2**15, size=(2, NUM_FRAMES)).astype(np.int32) << 16
+    filename = os.path.join(str(tmp_path), "test.wav")
+    with AudioFile(filename, "w", SAMPLE_RATE, 2, bit_depth=bit_depth) as f:
+        f.write(audio)
+
+    with AudioFile(filename) as f:
+        assert f.file_dtype == f"int{bit_depth}"
+        expected = f.read_raw(f.frames)
+
+    with AudioFile(filename) as f:
+        buffer = np.zeros((2, f.frames + 100), dtype=dtype)
+        assert f.read_into(buffer) == f.frames
+    np.testing.assert_array_equal(buffer[:, :NUM_FRAMES], expected)
+    np.testing.assert_array_equal(buffer[:, NUM_FRAMES:], 0)
+
+
+def test_read_into_validates_arrays(tmp_path):
+    filename = write_test_file(tmp_path, "wav", num_channels=2)
+    with AudioFile(filename) as f:
+        with pytest.raises(ValueError, match="shape"):
+            f.read_into(np.zeros((1, 100), dtype=np.float32))
+        with pytest.raises(ValueError, match="shape"):
+            f.read_into(np.zeros(100, dtype=np.float32))
+        with pytest.raises(ValueError, match="C-contiguous"):
+            f.read_into(np.zeros((100, 2), dtype=np.float32).T)
+        with pytest.raises(ValueError, match="offset"):
+            f.read_into(np.zeros((2, 100), dtype=np.float32), offset=101)
+        with pytest.raises(TypeError, match="float32"):
+            f.read_into(np.zeros((2, 100), dtype=np.float64))
+        with pytest.raises(TypeError, match="16-bit"):
+            f.read_into(np.zeros((2, 100), dtype=np.int8))
+
+        read_only = np.zeros((2, 100), dtype=np.float32)
+        read_only.flags.writeable = False
+        with pytest.raises(ValueError, match="writeable"):
+            f.read_into(read_only)
+        assert f.tell() == 0
+
+
+@pytest.mark.parametrize("dtype", [np.int64, np.uint16, np.float64])
+def test_read_into_leaves_rejected_arrays_untouched(tmp_path, dtype):
+    filename = write_test_file(tmp_path, "wav")
+    with AudioFile(filename) as f:
+        # Larger than the file, so that any frames past its end would be zeroed:
+        buffer = np.full((2, f.frames + 100), 7, dtype=dtype)
+        with pytest.raises(TypeError):
+            f.read_into(buffer)
+        np.testing.assert_array_equal(buffer, 7)
+        assert f.tell() == 0
+
+
+@pytest.mark.parametrize("target_sample_rate", [16000, 48000])
+def test_resampled_read_into_matches_read(tmp_path, target_sample_rate: int):
+    filename = write_test_file(tmp_path, "wav")
+    with AudioFile(filename).resampled_to(target_sample_rate) as f:
+        expected = f.read(f.frames)
+
+    with AudioFile(filename).resampled_to(target_sample_rate) as f:
+        buffer = np.zeros((2, 4096), dtype=np.float32)
+        chunks = []
+        while True:
+            frames_read = f.read_into(buffer)
+            if not frames_read:
+                break
+            np.testing.assert_array_equal(buffer[:, frames_read:], 0)
+            chunks.append(buffer[:, :frames_read].copy())
+    np.testing.assert_allclose(np.concatenate(chunks, axis=1), expected, atol=1e-6)
+
+
+def test_resampled_read_into_requires_float32(tmp_path):
+    filename = write_test_file(tmp_path, "wav")
+    with AudioFile(filename).resampled_to(16000) as f:
+        with pytest.raises(TypeError, match="float32"):
+            f.read_into(np.zeros((2, 100), dtype=np.int16))
@@ -0,0 +1,128 @@
+#! /usr/bin/env python
+#
+# Copyright 2025 Spotify AB
+#
+# Licensed under the GNU Public License, Version 3.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.gnu.org/licenses/gpl-3.0.html
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import os
+
+import numpy as np
+import pytest
+
+from pedalboard.io import AudioFile
+
+SAMPLE_RATE = 44100
+NUM_FRAMES = 200_000
+
+
+def write_test_file(tmp_path, extension: str, num_channels: int = 2) -> str:
+    rng = np.random.default_rng(42)
+    audio = (rng.random((num_channels, NUM_FRAMES)).astype(np.float32) - 0.5) * 0.5
+    filename = os.path.join(str(tmp_path), f"test.{extension}")
+    with AudioFile(filename, "w", SAMPLE_RATE, num_channels) as f:
+        f.write(audio)
+    return filename
+
+
+def read_windows_one_by_one(f, offsets, length: int) -> np.ndarray:
+    windows = np.zeros((len(offsets), f.num_channels, length), dtype=np.float32)
+    for i, offset in enumerate(offsets):
+        f.seek(offset)
+        window = f.read(length)
+        windows[i, :, : window.shape[1]] = window
+    return windows
+
+
+OFFSETS = [150_000, 0, 1000, 1500, 1500, 80_000, NUM_FRAMES - 100, 40_000, 41_000]
+
+
+@pytest.mark.parametrize("extension", ["wav", "flac"])
+@pytest.mark.parametrize("num_channels", [1, 2])
+@pytest.mark.parametrize("length", [1, 1000, 20_000])
+def test_read_windows_matches_seek_and_read(tmp_path, extension: str, num_channels: int, length):
+    filename = write_test_file(tmp_path, extension, num_channels)
+    with AudioFile(filename) as f:
+        expected = read_windows_one_by_one(f, OFFSETS, length)
+
+    with AudioFile(filename) as f:
+        f.seek(1234)
+        windows = f.read_windows(OFFSETS, length)
+        assert windows.dtype == np.float32
+        assert windows.shape == (len(OFFSETS), num_channels, length)
+        assert f.tell() == 1234
+
+    np.testing.assert_array_equal(windows, expected)
+
+
+def test_read_windows_from_mp3(tmp_path):
+    filename = write_test_file(tmp_path, "mp3")
+    with AudioFile(filename) as f:
+        expected = read_windows_one_by_one(f, OFFSETS, 5000)
+
+    with AudioFile(filename) as f:
+        np.testing.assert_allclose(f.read_windows(OFFSETS, 5000), expected, atol=0.01)
+
+
+def test_read_windows_pads_past_end_of_file(tmp_path):
+    filename = write_test_file(tmp_path, "wav")
+    with AudioFile(filename) as f:
+        expected = f.read(f.frames)
+        windows = f.read_windows([NUM_FRAMES - 10, NUM_FRAMES], 100)
+
+    np.testing.assert_array_equal(windows[0, :, :10], expected[:, -10:])
+    np.testing.assert_array_equal(windows[0, :, 10:], 0)
+    np.testing.assert_array_equal(windows[1], 0)
+
+
+def test_read_windows_with_prefetch(tmp_path):
+    filename = write_test_file(tmp_path, "flac")
+    with AudioFile(filename) as f:
+        expected = read_windows_one_by_one(f, OFFSETS, 5000)
+
+    with AudioFile(filename, prefetch=2) as f:
+        f.read(100)
+        np.testing.assert_array_equal(f.read_windows(OFFSETS, 5000), expected)
+        assert f.tell() == 100
+
+
+@pytest.mark.parametrize("target_sample_rate", [22050, 48000])
+def test_resampled_read_windows(tmp_path, target_sample_rate: float):
+    filename = write_test_file(tmp_path, "wav")
+    length = 3000
+    with AudioFile(filename).resampled_to(target_sample_rate) as f:
+        offsets = [o * target_sample_rate // SAMPLE_RATE for o in OFFSETS]
+        expected = read_windows_one_by_one(f, offsets, length)
+
+    with AudioFile(filename).resampled_to(target_sample_rate) as f:
+        f.seek(500)
+        before = f.read(100)
+        windows = f.read_windows(offsets, length)
+        assert windows.shape == (len(offsets), 2, length)
+        assert f.tell() == 600
+        f.seek(500)
+        np.testing.assert_allclose(f.read(100), before, atol=1e-5)
+
+    np.testing.assert_allclose(windows, expected, atol=1e-4)
+
+
+def test_read_windows_with_no_offsets(tmp_path):
+    with AudioFile(write_test_file(tmp_path, "wav")) as f:
+        assert f.read_windows([], 100).shape == (0, 2, 100)
+
+
+@pytest.mark.parametrize("offsets,length", [([0], 0), ([-1], 100), ([NUM_FRAMES + 1], 100)])
+def test_read_windows_invalid_arguments(tmp_path, offsets, length: int):
+    with AudioFile(write_test_file(tmp_path, "wav")) as f:
+        with pytest.raises(ValueError):
+            f.read_windows(offsets, length)
@@ -194,3 +194,27 @@ def test_quality_can_change(
     plugin.quality = original_quality
     output3 = plugin.process(sine_wave, sample_rate, buffer_size=buffer_size)
     np.testing.assert_allclose(output1, output3)
+
+
+@pytest.mark.parametrize("sample_rate", [22050, 44100])
+@pytest.mark.parametrize("target_sample_rate", [8000, 12345.67, 48000])
+@pytest.mark.parametrize("num_channels", [2, 6])
+@pytest.mark.parametrize(
+    "quality", TOLERANCE_PER_QUALITY.keys(), ids=[q.name for q in TOLERANCE_PER_QUALITY.keys()]
+)
+def test_multichannel_resampling_matches_mono(
+    sample_rate: float,
+    target_sample_rate: float,
+    num_channels: int,
+    quality: Resample.Quality,
+):
+    # All channels are resampled together; each should be identical to the
+    # same audio resampled on its own:
+    noise = np.random.default_rng(seed=1234).uniform(-1, 1, (num_channels, sample_rate // 2))
+    noise = noise.astype(np.float32)
+    multichannel = Resample(target_sample_rate, quality=quality).process(noise, sample_rate)
+    for channel in range(num_channels):
+        mono = Resample(target_sample_rate, quality=quality).process(
+            noise[channel : channel + 1], sample_rate
+        )
+        np.testing.assert_array_equal(multichannel[channel : channel + 1], mono)
@@ -206,3 +206,100 @@ def test_returned_sample_count(
         f"{output.shape[1]:,} samples were output by resampler (in chunks:"
         f" {[o.shape[1] for o in outputs]}) when {expected_output.shape[1]:,} were expected."
     )
+
+
+@pytest.mark.parametrize("sample_rate", [8000, 44100, 48000])
+@pytest.mark.parametrize("target_sample_rate", [8000, 12345.67, 16000, 44100])
+@pytest.mark.parametrize("chunk_size", [1, 256, 8192])
+@pytest.mark.parametrize("num_channels", [1, 2])
+def test_process_into_out(
+    sample_rate: float, target_sample_rate: float, chunk_size: int, num_channels: int
+):
+    input_signal = np.random.rand(num_channels, int(sample_rate) // 4).astype(np.float32)
+    resampler = StreamResampler(sample_rate, target_sample_rate, num_channels)
+
+    expected_chunks = []
+    for i in range(0, input_signal.shape[-1], chunk_size):
+        expected_chunks.append(resampler.process(input_signal[:, i : i + chunk_size]))
+    expected_chunks.append(resampler.process(None))
+
+    resampler.reset()
+    max_output_size = int(chunk_size * target_sample_rate / sample_rate) + 4096
+    out = np.zeros((num_channels, max_output_size), dtype=np.float32)
+    for i, expected in enumerate(expected_chunks):
+        if i < len(expected_chunks) - 1:
+            chunk = input_signal[:, i * chunk_size : (i + 1) * chunk_size]
+        else:
+            chunk = None
+        result = resampler.process(chunk, out=out)
+        assert np.shares_memory(result, out)
+        np.testing.assert_array_equal(result, expected)
+
+
+def test_process_into_interleaved_out():
+    input_signal = np.random.rand(4410, 2).astype(np.float32)
+    resampler = StreamResampler(44100, 16000, 2)
+    expected = resampler.process(input_signal)
+    assert expected.shape[1] == 2
+
+    resampler.reset()
+    out = np.zeros((4410, 2), dtype=np.float32)
+    result = resampler.process(input_signal, out=out)
+    assert np.shares_memory(result, out)
+    np.testing.assert_array_equal(result, expected)
+
+
+def test_process_into_too_small_out_consumes_nothing():
+    input_signal = np.random.rand(1, 4410).astype(np.float32)
+    resampler = StreamResampler(44100, 48000, 1)
+    expected = resampler.process(input_signal)
+
+    resampler.reset()
+    with pytest.raises(ValueError):
+        resampler.process(input_signal, out=np.zeros((1, 10), dtype=np.float32))
+
+    out = np.zeros((1, 8192), dtype=np.float32)
+    np.testing.assert_array_equal(resampler.process(input_signal, out=out), expected)
+
+
+def test_process_into_out_validates_array():
+    resampler = StreamResampler(44100, 48000, 2)
+    input_signal = np.zeros((2, 100), dtype=np.float32)
+    with pytest.raises(TypeError):
+        resampler.process(input_signal, out=np.zeros((2, 1000), dtype=np.float64))
+    with pytest.raises(ValueError):
+        resampler.process(input_signal, out=np.zeros((3, 1000), dtype=np.float32))
+    with pytest.raises(ValueError):
+        resampler.process(input_signal, out=np.zeros((1000, 2), dtype=np.float32).T)
+
+
+@pytest.mark.parametrize("sample_rate", [22050, 44100])
+@pytest.mark.parametrize("target_sample_rate", [8000, 12345.67, 48000])
+@pytest.mark.parametrize("buffer_size", [100, 1_000_000])
+@pytest.mark.parametrize("num_channels", [2, 6])
+@pytest.mark.parametrize("quality", Resample.Quality.__members__.values(), ids=lambda q: q.name)
+def test_multichannel_stream_resampling_matches_mono(
+    sample_rate: float,
+    target_sample_rate: float,
+    buffer_size: int,
+    num_channels: int,
+    quality: Resample.Quality,
+):
+    # All channels are resampled together; each should be identical to the
+    # same audio resampled on its own:
+    noise = np.random.default_rng(seed=1234).uniform(-1, 1, (num_channels, sample_rate // 2))
+    noise = noise.astype(np.float32)
+
+    def resample(audio: np.ndarray) -> np.ndarray:
+        resampler = StreamResampler(sample_rate, target_sample_rate, audio.shape[0], quality)
+        outputs = [
+            resampler.process(audio[:, i : i + buffer_size])
+            for i in range(0, audio.shape[1], buffer_size)
+        ]
+        outputs.append(resampler.process(None))
+        return np.concatenate(outputs, axis=1)
+
+    multichannel = resample(noise)
+    for channel in range(num_channels):
+        mono = resample(noise[channel : channel + 1])
+        np.testing.assert_array_equal(multichannel[channel : channel + 1], mono)
@@ -0,0 +1,110 @@
+#! /usr/bin/env python
+#
+# Copyright 2025 Spotify AB
+#
+# Licensed under the GNU Public License, Version 3.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.gnu.org/licenses/gpl-3.0.html
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import io
+import os
+
+import numpy as np
+import pytest
+
+from pedalboard.io import AudioFile, WriteableAudioFile
+
+SAMPLE_RATE = 44100
+
+
+def make_chunks(num_channels: int, dtype, num_chunks: int = 12, chunk_size: int = 5000):
+    rng = np.random.default_rng(42)
+    audio = (rng.random((num_channels, num_chunks * chunk_size)) - 0.5) * 1.5
+    if np.issubdtype(dtype, np.integer):
+        audio = (np.clip(audio, -1, 1) * np.iinfo(dtype).max).astype(dtype)
+    else:
+        audio = audio.astype(dtype)
+    return [audio[:, i : i + chunk_size] for i in range(0, audio.shape[1], chunk_size)]
+
+
+def write_chunks(filename: str, chunks, num_channels: int, interleaved: bool, **kwargs):
+    with AudioFile(filename, "w", SAMPLE_RATE, num_channels, **kwargs) as f:
+        for chunk in chunks:
+            f.write(np.ascontiguousarray(chunk.T) if interleaved else chunk)
+        assert f.frames == sum(chunk.shape[1] for chunk in chunks)
+
+
+def read_all(filename: str) -> np.ndarray:
+    with AudioFile(filename) as f:
+        return f.read(f.frames)
+
+
+@pytest.mark.parametrize("extension", ["wav", "flac", "mp3", "ogg"])
+@pytest.mark.parametrize("dtype", [np.int16, np.int32, np.float32, np.float64])
+@pytest.mark.parametrize("num_channels", [1, 2])
+@pytest.mark.parametrize("interleaved", [False, True])
+@pytest.mark.parametrize("queue_size", [1, 4])
+def test_queued_writes_match_synchronous_writes(
+    tmp_path, extension: str, dtype, num_channels: int, interleaved: bool, queue_size: int
+):
+    chunks = make_chunks(num_channels, dtype)
+    expected_filename = os.path.join(str(tmp_path), f"expected.{extension}")
+    actual_filename = os.path.join(str(tmp_path), f"actual.{extension}")
+
+    write_chunks(expected_filename, chunks, num_channels, interleaved)
+    write_chunks(actual_filename, chunks, num_channels, interleaved, queue_size=queue_size)
+
+    if extension in ("wav", "flac"):
+        with open(expected_filename, "rb") as e, open(actual_filename, "rb") as a:
+            assert a.read() == e.read()
+    else:
+        np.testing.assert_array_equal(read_all(actual_filename), read_all(expected_filename))
+
+
+def test_queued_writes_can_be_flushed(tmp_path):
+    filename = os.path.join(str(tmp_path), "flushed.wav")
+    chunks = make_chunks(2, np.float32)
+    with AudioFile(filename, "w", SAMPLE_RATE, 2, queue_size=8) as f:
+        assert f.queue_size == 8
+        for chunk in chunks:
+            f.write(chunk)
+        f.flush()
+        flushed = read_all(filename)
+        assert flushed.shape[1] == f.frames
+
+    np.testing.assert_array_equal(read_all(filename), flushed)
+
+
+def test_queue_size_defaults_to_zero(tmp_path):
+    with WriteableAudioFile(os.path.join(str(tmp_path), "default.wav"), SAMPLE_RATE) as f:
+        assert f.queue_size == 0
+
+
+def test_negative_queue_size_is_an_error(tmp_path):
+    with pytest.raises(ValueError):
+        AudioFile(os.path.join(str(tmp_path), "invalid.wav"), "w", SAMPLE_RATE, queue_size=-1)
+
+
+def test_queue_size_is_not_supported_for_file_like_objects():
+    buf = io.BytesIO()
+    buf.name = "output.wav"
+    with pytest.raises(TypeError):
+        AudioFile(buf, "w", SAMPLE_RATE, queue_size=2)
+
+
+def test_writes_after_close_raise(tmp_path):
+    f = AudioFile(os.path.join(str(tmp_path), "closed.flac"), "w", SAMPLE_RATE, queue_size=2)
+    f.write(np.zeros((1, 1000), dtype=np.float32))
+    f.close()
+    assert f.closed
+    with pytest.raises(RuntimeError):
+        f.write(np.zeros((1, 1000), dtype=np.float32))